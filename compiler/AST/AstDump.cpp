@@ -976,6 +976,8 @@ void AstDump::printLoopStmtDetails(LoopStmt* loop) {
     write("hazard");
   if (loop->isOrderIndependent())
     write("order-independent");
+  if (loop->isVectorizeRequested())
+    write("vectorize");
 }
 
 void AstDump::newline() {
@@ -26,6 +26,7 @@ LoopStmt::LoopStmt(BlockStmt* initBody) : BlockStmt(initBody)
   mBreakLabel       = 0;
   mContinueLabel    = 0;
   mOrderIndependent = false;
+  mVectorizeRequested = false;
   mVectorizationHazard = false;
   mParallelAccessVectorizationHazard = false;
 }
@@ -60,6 +61,16 @@ void LoopStmt::orderIndependentSet(bool orderIndependent)
   mOrderIndependent = orderIndependent;
 }
 
+bool LoopStmt::isVectorizeRequested() const
+{
+  return mVectorizeRequested;
+}
+
+void LoopStmt::vectorizeRequestedSet(bool vectorizeRequested)
+{
+  mVectorizeRequested = vectorizeRequested;
+}
+
 bool LoopStmt::hasVectorizationHazard() const
 {
   return mVectorizationHazard;
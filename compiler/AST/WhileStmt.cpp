@@ -46,6 +46,7 @@ void WhileStmt::copyInnerShare(const WhileStmt& ref,
   mBreakLabel       = ref.mBreakLabel;
   mContinueLabel    = ref.mContinueLabel;
   mOrderIndependent = ref.mOrderIndependent;
+  mVectorizeRequested = ref.mVectorizeRequested;
 
   if (condExpr != 0)
     mCondExpr = condExpr->copy(map, true);
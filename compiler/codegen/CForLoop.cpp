@@ -27,6 +27,7 @@
 #include "driver.h"
 #include "ForLoop.h"
 #include "LayeredValueTable.h"
+#include "stringutil.h"
 
 #ifdef HAVE_LLVM
 #include "llvm/IR/Module.h"
@@ -40,7 +41,8 @@
 // Returns the loop metadata node to associate with the branch.
 // If thisLoopParallelAccess is set, accessGroup will be set to the
 // metadata node to use in llvm.access.group metadata for this loop.
-static llvm::MDNode* generateLoopMetadata(bool thisLoopParallelAccess,
+static llvm::MDNode* generateLoopMetadata(CForLoop* loop,
+                                          bool thisLoopParallelAccess,
                                           llvm::MDNode*& accessGroup)
 {
   GenInfo* info = gGenInfo;
@@ -51,12 +53,13 @@ static llvm::MDNode* generateLoopMetadata(bool thisLoopParallelAccess,
   auto tmpNode        = llvm::MDNode::getTemporary(ctx, llvm::None);
   args.push_back(tmpNode.get());
 
-  // llvm.loop.vectorize.enable metadata is only used by LoopVectorizer to:
-  // 1) Explicitly disable vectorization of particular loop
-  // 2) Print warning when vectorization is enabled (using metadata) and
-  //    vectorization didn't occur
-  // Here we do not emit that metadata; instead emitting parallel
-  // llvm.loop.parallel_accesses.
+  // llvm.loop.vectorize.enable metadata makes the LoopVectorizer
+  // vectorize the loop even if its cost model considers that unprofitable,
+  // the same as `#pragma clang loop vectorize(enable)`. It also makes LLVM
+  // warn when vectorization didn't occur. We only emit it for loops that
+  // came from vectorizeOnly() and have no vectorization hazards, along
+  // with llvm.loop.parallel_accesses. Other order-independent loops, such
+  // as forall follower bodies, are left to the cost model.
 
   // Does the current loop, or any outer loop in the loop stack,
   // require llvm.loop.parallel_accesses metadata?
@@ -92,6 +95,32 @@ static llvm::MDNode* generateLoopMetadata(bool thisLoopParallelAccess,
     args.push_back(parAccesses);
   }
 
+  if (thisLoopParallelAccess && loop->isVectorizeRequested() &&
+      !fRegionVectorizer) {
+    llvm::Constant* one = llvm::ConstantInt::get(llvm::Type::getInt1Ty(ctx),
+                                                 true);
+    llvm::Metadata *loopVectorizeEnable[] = {
+        llvm::MDString::get(ctx, "llvm.loop.vectorize.enable"),
+        llvm::ConstantAsMetadata::get(one) };
+
+    args.push_back(llvm::MDNode::get(ctx, loopVectorizeEnable));
+  }
+
+  // Record where the loop came from so that --report-vectorization can map
+  // the vectorizer's remarks back to Chapel source. LLVM ignores loop
+  // properties it doesn't know about.
+  if (fReportVectorization) {
+    ModuleSymbol* mod = loop->getModule();
+    if (developer || (mod != NULL && mod->modTag == MOD_USER)) {
+      const char* loc = astr(loop->fname(), ":", istr(loop->linenum()));
+      llvm::Metadata *loopLocation[] = {
+          llvm::MDString::get(ctx, "chpl.loop.location"),
+          llvm::MDString::get(ctx, loc) };
+
+      args.push_back(llvm::MDNode::get(ctx, loopLocation));
+    }
+  }
+
   // When using the Region Vectorizer, emit rv.loop.vectorize.enable metadata
   if(fRegionVectorizer)
   {
@@ -246,7 +275,8 @@ GenRet CForLoop::codegen()
     llvm::MDNode* loopMetadata = nullptr;
 
     if(fNoVectorize == false && isVectorizable()) {
-      loopMetadata = generateLoopMetadata(isParallelAccessVectorizable(),
+      loopMetadata = generateLoopMetadata(this,
+                                          isParallelAccessVectorizable(),
                                           accessGroup);
       LoopData data(accessGroup, isParallelAccessVectorizable());
       info->loopStack.push_back(data);
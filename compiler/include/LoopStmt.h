@@ -45,6 +45,10 @@ public:
   bool                   isOrderIndependent()                            const;
   void                   orderIndependentSet(bool b);
 
+  // for llvm.loop.vectorize.enable: set on the loops of vectorizeOnly()
+  bool                   isVectorizeRequested()                          const;
+  void                   vectorizeRequestedSet(bool b);
+
   // for RV rv.loop.vectorize.enable
   bool                   hasVectorizationHazard()                        const;
   void                   setHasVectorizationHazard(bool v);
@@ -65,6 +69,7 @@ protected:
   LabelSymbol*           mBreakLabel;
   LabelSymbol*           mContinueLabel;
   bool                   mOrderIndependent;
+  bool                   mVectorizeRequested;
   bool                   mVectorizationHazard;
   bool                   mParallelAccessVectorizationHazard;
 
@@ -40,6 +40,7 @@ extern bool fNoDeadCodeElimination;
 extern bool fNoGlobalConstOpt;
 extern bool fNoFastFollowers;
 extern bool fNoInlineIterators;
+extern bool fInlineZipperedIterators;
 extern bool fNoLoopInvariantCodeMotion;
 extern bool fNoInterproceduralAliasAnalysis;
 extern bool fNoInline;
@@ -55,6 +56,8 @@ extern bool fNoDivZeroChecks;
 extern bool fMungeUserIdents;
 extern bool fEnableTaskTracking;
 extern bool fLLVMWideOpt;
+extern bool fProfileGenerate;
+extern char fProfileUse[FILENAME_MAX+1];
 
 extern bool fAutoLocalAccess;
 extern bool fDynamicAutoLocalAccess;
@@ -63,11 +66,18 @@ extern bool fReportAutoLocalAccess;
 extern bool fAutoAggregation;
 extern bool fReportAutoAggregation;
 
+extern bool fAutoPrefetch;
+extern bool fReportAutoPrefetch;
+
+extern bool fFuseOnStmts;
+
 extern bool fNoRemoteValueForwarding;
+extern bool fRemoteFieldForwarding;
 extern bool fNoInferConstRefs;
 extern bool fNoRemoteSerialization;
 extern bool fNoRemoveCopyCalls;
 extern bool fNoScalarReplacement;
+extern bool fStackAllocateClasses;
 extern bool fNoTupleCopyOpt;
 extern bool fNoOptimizeRangeIteration;
 extern bool fNoOptimizeLoopIterators;
@@ -220,10 +230,13 @@ extern bool fReportAliases;
 extern bool fReportBlocking;
 extern bool fReportOptimizedLoopIterators;
 extern bool fReportInlinedIterators;
+extern bool fReportIteratorLowering;
 extern bool fReportVectorizedLoops;
+extern bool fReportVectorization;
 extern bool fReportOptimizedOn;
 extern bool fReportPromotion;
 extern bool fReportScalarReplace;
+extern bool fReportStackAllocation;
 extern bool fReportDeadBlocks;
 extern bool fReportDeadModules;
 
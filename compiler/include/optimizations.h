@@ -76,6 +76,10 @@ void liveVariableAnalysis(FnSymbol* fn,
 
 void remoteValueForwarding();
 
+void fuseOnStmts();
+
+void stackAllocateClasses();
+
 void inferConstRefs();
 
 void computeNoAliasSets();
@@ -57,6 +57,9 @@
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/MC/SubtargetFeature.h"
@@ -1835,6 +1838,17 @@ static void registerRVPasses(const llvm::PassManagerBuilder &Builder,
 }
 #endif
 
+// The raw profile written by a --profile-generate executable. %m makes
+// the program instances of a multi-locale run merge their counts into the
+// same file rather than overwrite each other's.
+static std::string getProfileRawFilename() {
+  const char* exe = strrchr(executableFilename, '/');
+
+  exe = (exe != NULL) ? exe + 1 : executableFilename;
+
+  return std::string(exe) + "-%m.profraw";
+}
+
 static
 void configurePMBuilder(PassManagerBuilder &PMBuilder, bool forFunctionPasses, int optLevel=-1) {
   ClangInfo* clangInfo = gGenInfo->clangInfo;
@@ -1885,6 +1899,120 @@ void configurePMBuilder(PassManagerBuilder &PMBuilder, bool forFunctionPasses, i
   // TODO: we might need to call TargetMachine's addEarlyAsPossiblePasses
 }
 
+// With --report-vectorization, prints the loop vectorizer's remarks and
+// warnings with the location of the Chapel loop that CForLoop::codegen
+// recorded in the loop metadata. Anything it doesn't report goes to the
+// previous handler.
+class VectorizationDiagnosticHandler : public DiagnosticHandler {
+ public:
+  explicit VectorizationDiagnosticHandler(
+      std::unique_ptr<DiagnosticHandler> prev)
+    : prev(std::move(prev)) { }
+
+  std::unique_ptr<DiagnosticHandler> takePrev() { return std::move(prev); }
+
+  bool handleDiagnostics(const DiagnosticInfo &DI) override {
+    if (auto *optDiag = dyn_cast<DiagnosticInfoIROptimization>(&DI)) {
+      if (isVectorizerPass(optDiag->getPassName()) && fReportVectorization) {
+        if (report(*optDiag))
+          return true;
+        // Drop remarks that were only produced because we asked for
+        // them. Everything else, such as the 'loop not vectorized'
+        // warnings, is handled as it would be without us.
+        if (!enabledWithoutUs(*optDiag))
+          return true;
+      }
+    }
+
+    return prev ? prev->handleDiagnostics(DI) : false;
+  }
+
+  bool isAnalysisRemarkEnabled(StringRef passName) const override {
+    return (fReportVectorization && isVectorizerPass(passName)) ||
+           (prev && prev->isAnalysisRemarkEnabled(passName));
+  }
+
+  bool isMissedOptRemarkEnabled(StringRef passName) const override {
+    return (fReportVectorization && isVectorizerPass(passName)) ||
+           (prev && prev->isMissedOptRemarkEnabled(passName));
+  }
+
+  bool isPassedOptRemarkEnabled(StringRef passName) const override {
+    return (fReportVectorization && isVectorizerPass(passName)) ||
+           (prev && prev->isPassedOptRemarkEnabled(passName));
+  }
+
+  bool isAnyRemarkEnabled() const override {
+    return fReportVectorization || (prev && prev->isAnyRemarkEnabled());
+  }
+
+ private:
+  std::unique_ptr<DiagnosticHandler> prev;
+
+  // When vectorization was requested through metadata, the vectorizer
+  // reports its analysis with the empty "always print" pass name
+  static bool isVectorizerPass(StringRef passName) {
+    return passName == OptimizationRemarkAnalysis::AlwaysPrint ||
+           passName == "loop-vectorize" ||
+           passName == "transform-warning";
+  }
+
+  // The remarks refer to the loop header. The loop metadata is on the
+  // branch of the latch back to the header.
+  static const char* chapelLoopLocation(const DiagnosticInfoIROptimization &DI) {
+    const BasicBlock* header = dyn_cast_or_null<BasicBlock>(DI.getCodeRegion());
+    if (header == NULL)
+      return NULL;
+
+    for (const BasicBlock* pred : predecessors(header)) {
+      const MDNode* loopID = pred->getTerminator()->getMetadata("llvm.loop");
+      if (loopID == NULL)
+        continue;
+
+      for (unsigned i = 1; i < loopID->getNumOperands(); i++) {
+        const MDNode* prop = dyn_cast<MDNode>(loopID->getOperand(i));
+        if (prop == NULL || prop->getNumOperands() != 2)
+          continue;
+
+        const MDString* name = dyn_cast<MDString>(prop->getOperand(0));
+        const MDString* loc = dyn_cast<MDString>(prop->getOperand(1));
+        if (name && loc && name->getString() == "chpl.loop.location")
+          return astr(loc->getString().str().c_str());
+      }
+    }
+
+    return NULL;
+  }
+
+  // Returns true if the diagnostic was reported. Only loops that
+  // CForLoop::codegen chose to record are.
+  static bool report(const DiagnosticInfoIROptimization &DI) {
+    const char* loc = chapelLoopLocation(DI);
+    if (loc == NULL)
+      return false;
+
+    fprintf(stderr, "%s: note: %s\n", loc, DI.getMsg().c_str());
+    return true;
+  }
+
+  bool enabledWithoutUs(const DiagnosticInfoIROptimization &DI) const {
+    StringRef passName = DI.getPassName();
+
+    if (DI.getSeverity() != DS_Remark ||
+        passName == OptimizationRemarkAnalysis::AlwaysPrint)
+      return true;
+
+    if (!prev)
+      return false;
+
+    if (isa<OptimizationRemark>(&DI))
+      return prev->isPassedOptRemarkEnabled(passName);
+    if (isa<OptimizationRemarkMissed>(&DI))
+      return prev->isMissedOptRemarkEnabled(passName);
+    return prev->isAnalysisRemarkEnabled(passName);
+  }
+};
+
 void prepareCodegenLLVM()
 {
   GenInfo *info = gGenInfo;
@@ -3597,6 +3725,16 @@ void makeBinaryLLVM(void) {
 
   configurePMBuilder(PMBuilder, /* for function passes */ false);
 
+  // Instrument for, or optimize with, an execution profile. This is only
+  // done here, so that the instrumentation is added once and before the
+  // global to wide optimization changes the control flow.
+  if (fProfileGenerate) {
+    PMBuilder.EnablePGOInstrGen = true;
+    PMBuilder.PGOInstrGen = getProfileRawFilename();
+  } else if (fProfileUse[0] != '\0') {
+    PMBuilder.PGOInstrUse = fProfileUse;
+  }
+
   // Note, these global extensions currently only apply
   // to the module-level optimization (not the "basic" function
   // optimization we do immediately after generating LLVM IR).
@@ -3630,7 +3768,16 @@ void makeBinaryLLVM(void) {
     PMBuilder.populateModulePassManager(mpm);
 
     // Run the optimizations now!
-    mpm.run(*info->module);
+    {
+      LLVMContext &ctx = info->module->getContext();
+      VectorizationDiagnosticHandler* handler =
+        new VectorizationDiagnosticHandler(ctx.getDiagnosticHandler());
+      ctx.setDiagnosticHandler(std::unique_ptr<DiagnosticHandler>(handler));
+
+      mpm.run(*info->module);
+
+      ctx.setDiagnosticHandler(handler->takePrev());
+    }
 
     if( saveCDir[0] != '\0' ) {
       // Save the generated LLVM after first chunk of optimization
@@ -3969,6 +4116,15 @@ void makeBinaryLLVM(void) {
     options += " -g";
   }
 
+  // Link in LLVM's profile runtime for --profile-generate
+  if (fProfileGenerate) {
+    if (clangCXX != useLinkCXX)
+      USR_WARN("--profile-generate needs LLVM's profile runtime, which "
+               "may not be linked in when the linker is overridden");
+
+    options += " -fprofile-generate";
+  }
+
   // We used to supply link args here *and* later on
   // in the link line. I think the later position is sufficient.
   /*
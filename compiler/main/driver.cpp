@@ -134,8 +134,10 @@ bool fFastFlag = false;
 bool fNoCopyPropagation = false;
 bool fNoDeadCodeElimination = false;
 bool fNoScalarReplacement = false;
+bool fStackAllocateClasses = false;
 bool fNoTupleCopyOpt = false;
 bool fNoRemoteValueForwarding = false;
+bool fRemoteFieldForwarding = false;
 bool fNoInferConstRefs = false;
 bool fNoRemoteSerialization = false;
 bool fNoRemoveCopyCalls = false;
@@ -147,6 +149,7 @@ bool fForceVectorize = false;
 bool fNoGlobalConstOpt = false;
 bool fNoFastFollowers = false;
 bool fNoInlineIterators = false;
+bool fInlineZipperedIterators = false;
 bool fNoLiveAnalysis = false;
 bool fNoBoundsChecks = false;
 bool fNoDivZeroChecks = false;
@@ -170,12 +173,21 @@ bool fReportAutoLocalAccess= false;
 bool fAutoAggregation = false;
 bool fReportAutoAggregation= false;
 
+bool fAutoPrefetch = false;
+bool fReportAutoPrefetch = false;
+
+bool fFuseOnStmts = false;
+
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
 
+// flags for profile-guided optimization
+bool fProfileGenerate = false;
+char fProfileUse[FILENAME_MAX+1] = "";
+
 bool fWarnConstLoops = true;
 bool fWarnUnstable = false;
 
@@ -240,11 +252,14 @@ bool fReportAliases = false;
 bool fReportBlocking = false;
 bool fReportOptimizedLoopIterators = false;
 bool fReportInlinedIterators = false;
+bool fReportIteratorLowering = false;
 bool fReportVectorizedLoops = false;
+bool fReportVectorization = false;
 bool fReportOptimizedOn = false;
 bool fReportOptimizeForallUnordered = false;
 bool fReportPromotion = false;
 bool fReportScalarReplace = false;
+bool fReportStackAllocation = false;
 bool fReportDeadBlocks = false;
 bool fReportDeadModules = false;
 bool fPermitUnhandledModuleErrors = false;
@@ -808,6 +823,7 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoInterproceduralAliasAnalysis = true;
   fNoInline = true;                   // --no-inline
   fNoInlineIterators = true;          // --no-inline-iterators
+  fInlineZipperedIterators = false;   // --no-inline-zippered-iterators
   fNoLiveAnalysis = true;             // --no-live-analysis
   fNoOptimizeRangeIteration = true;   // --no-optimize-range-iteration
   fNoOptimizeLoopIterators = true;    // --no-optimize-loop-iterators
@@ -815,8 +831,10 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoInferConstRefs = true;           // --no-infer-const-refs
   fNoRemoteValueForwarding = true;    // --no-remote-value-forwarding
   fNoRemoteSerialization = true;      // --no-remote-serialization
+  fRemoteFieldForwarding = false;     // --no-remote-field-forwarding
   fNoRemoveCopyCalls = true;          // --no-remove-copy-calls
   fNoScalarReplacement = true;        // --no-scalar-replacement
+  fStackAllocateClasses = false;      // --no-stack-allocate-classes
   fNoTupleCopyOpt = true;             // --no-tuple-copy-opt
   fNoPrivatization = true;            // --no-privatization
   fNoOptimizeOnClauses = true;        // --no-optimize-on-clauses
@@ -957,6 +975,7 @@ static ArgumentDescription arg_desc[] = {
  {"inline", ' ', NULL, "Enable [disable] function inlining", "n", &fNoInline, NULL, NULL},
  {"inline-iterators", ' ', NULL, "Enable [disable] iterator inlining", "n", &fNoInlineIterators, "CHPL_DISABLE_INLINE_ITERATORS", NULL},
  {"inline-iterators-yield-limit", ' ', "<limit>", "Limit number of yields permitted in inlined iterators", "I", &inline_iter_yield_limit, "CHPL_INLINE_ITER_YIELD_LIMIT", NULL},
+ {"inline-zippered-iterators", ' ', NULL, "Enable [disable] inlining the first iterator of zippered loops", "N", &fInlineZipperedIterators, "CHPL_INLINE_ZIPPERED_ITERATORS", NULL},
  {"live-analysis", ' ', NULL, "Enable [disable] live variable analysis", "n", &fNoLiveAnalysis, "CHPL_DISABLE_LIVE_ANALYSIS", NULL},
  {"loop-invariant-code-motion", ' ', NULL, "Enable [disable] loop invariant code motion", "n", &fNoLoopInvariantCodeMotion, NULL, NULL},
  {"optimize-forall-unordered-ops", ' ', NULL, "Enable [disable] optimization of foralls to unordered operations", "n", &fNoOptimizeForallUnordered, "CHPL_DISABLE_OPTIMIZE_FORALL_UNORDERED_OPS", NULL},
@@ -967,9 +986,11 @@ static ArgumentDescription arg_desc[] = {
  {"privatization", ' ', NULL, "Enable [disable] privatization of distributed arrays and domains", "n", &fNoPrivatization, "CHPL_DISABLE_PRIVATIZATION", NULL},
  {"remote-value-forwarding", ' ', NULL, "Enable [disable] remote value forwarding", "n", &fNoRemoteValueForwarding, "CHPL_DISABLE_REMOTE_VALUE_FORWARDING", NULL},
  {"remote-serialization", ' ', NULL, "Enable [disable] serialization for remote consts", "n", &fNoRemoteSerialization, "CHPL_DISABLE_REMOTE_SERIALIZATION", NULL},
+ {"remote-field-forwarding", ' ', NULL, "Enable [disable] forwarding of immutable fields read in on statements", "N", &fRemoteFieldForwarding, "CHPL_REMOTE_FIELD_FORWARDING", NULL},
  {"remove-copy-calls", ' ', NULL, "Enable [disable] remove copy calls", "n", &fNoRemoveCopyCalls, "CHPL_DISABLE_REMOVE_COPY_CALLS", NULL},
  {"scalar-replacement", ' ', NULL, "Enable [disable] scalar replacement", "n", &fNoScalarReplacement, "CHPL_DISABLE_SCALAR_REPLACEMENT", NULL},
  {"scalar-replace-limit", ' ', "<limit>", "Limit on the size of tuples being replaced during scalar replacement", "I", &scalar_replace_limit, "CHPL_SCALAR_REPLACE_TUPLE_LIMIT", NULL},
+ {"stack-allocate-classes", ' ', NULL, "Enable [disable] stack allocation of class instances that do not escape", "N", &fStackAllocateClasses, "CHPL_STACK_ALLOCATE_CLASSES", NULL},
  {"tuple-copy-opt", ' ', NULL, "Enable [disable] tuple (memcpy) optimization", "n", &fNoTupleCopyOpt, "CHPL_DISABLE_TUPLE_COPY_OPT", NULL},
  {"tuple-copy-limit", ' ', "<limit>", "Limit on the size of tuples considered for optimization", "I", &tuple_copy_limit, "CHPL_TUPLE_COPY_LIMIT", NULL},
  {"infer-local-fields", ' ', NULL, "Enable [disable] analysis to infer local fields in classes and records", "n", &fNoInferLocalFields, "CHPL_DISABLE_INFER_LOCAL_FIELDS", NULL},
@@ -979,6 +1000,8 @@ static ArgumentDescription arg_desc[] = {
  {"dynamic-auto-local-access", ' ', NULL, "Enable [disable] using local access automatically (dynamic only)", "N", &fDynamicAutoLocalAccess, "CHPL_DISABLE_DYNAMIC_AUTO_LOCAL_ACCESS", NULL},
 
  {"auto-aggregation", ' ', NULL, "Enable [disable] automatically aggregating remote accesses in foralls", "N", &fAutoAggregation, "CHPL_AUTO_AGGREGATION", NULL},
+ {"auto-prefetch", ' ', NULL, "Enable [disable] automatically prefetching indirect accesses in foralls", "N", &fAutoPrefetch, "CHPL_AUTO_PREFETCH", NULL},
+ {"fuse-on-stmts", ' ', NULL, "Enable [disable] fusing and hoisting on statements to reduce remote forks", "N", &fFuseOnStmts, "CHPL_FUSE_ON_STMTS", NULL},
 
  {"", ' ', NULL, "Run-time Semantic Check Options", NULL, NULL, NULL, NULL},
  {"checks", ' ', NULL, "Enable [disable] all following run-time checks", "n", &fNoChecks, "CHPL_NO_CHECKS", setChecks},
@@ -1014,6 +1037,9 @@ static ArgumentDescription arg_desc[] = {
  {"llvm", ' ', NULL, "[Don't] use the LLVM code generator", "N", &fYesLlvmCodegen, "CHPL_LLVM_CODEGEN", setLlvmCodegen},
  {"llvm-wide-opt", ' ', NULL, "Enable [disable] LLVM wide pointer optimizations", "N", &fLLVMWideOpt, "CHPL_LLVM_WIDE_OPTS", NULL},
  {"mllvm", ' ', "<flags>", "LLVM flags (can be specified multiple times)", "S", NULL, "CHPL_MLLVM", setLLVMFlags},
+ {"report-vectorization", ' ', NULL, "Show LLVM loop vectorizer remarks", "N", &fReportVectorization, "CHPL_REPORT_VECTORIZATION", NULL},
+ {"profile-generate", ' ', NULL, "Instrument the program to record an execution profile", "F", &fProfileGenerate, "CHPL_PROFILE_GENERATE", NULL},
+ {"profile-use", ' ', "<file>", "Optimize using a profile recorded by a --profile-generate build", "P", fProfileUse, "CHPL_PROFILE_USE", NULL},
 
  {"", ' ', NULL, "Compilation Trace Options", NULL, NULL, NULL, NULL},
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
@@ -1098,13 +1124,16 @@ static ArgumentDescription arg_desc[] = {
  {"report-dead-modules", ' ', NULL, "Print dead module removal stats", "F", &fReportDeadModules, NULL, NULL},
  {"report-optimized-loop-iterators", ' ', NULL, "Print stats on optimized single loop iterators", "F", &fReportOptimizedLoopIterators, NULL, NULL},
  {"report-inlined-iterators", ' ', NULL, "Print stats on inlined iterators", "F", &fReportInlinedIterators, NULL, NULL},
+ {"report-iterator-lowering", ' ', NULL, "Print loops in user code that use iterator classes", "F", &fReportIteratorLowering, NULL, NULL},
  {"report-vectorized-loops", ' ', NULL, "Show which loops have vectorization hints", "F", &fReportVectorizedLoops, NULL, NULL},
  {"report-optimized-on", ' ', NULL, "Print information about on clauses that have been optimized for potential fast remote fork operation", "F", &fReportOptimizedOn, NULL, NULL},
  {"report-auto-local-access", ' ', NULL, "Enable compiler logs for auto local access optimization", "N", &fReportAutoLocalAccess, "CHPL_REPORT_AUTO_LOCAL_ACCESS", NULL},
  {"report-auto-aggregation", ' ', NULL, "Enable compiler logs for automatic aggregation", "N", &fReportAutoAggregation, "CHPL_REPORT_AUTO_AGGREGATION", NULL},
+ {"report-auto-prefetch", ' ', NULL, "Enable compiler logs for automatic prefetching", "N", &fReportAutoPrefetch, "CHPL_REPORT_AUTO_PREFETCH", NULL},
  {"report-optimized-forall-unordered-ops", ' ', NULL, "Show which statements in foralls have been converted to unordered operations", "F", &fReportOptimizeForallUnordered, NULL, NULL},
  {"report-promotion", ' ', NULL, "Print information about scalar promotion", "F", &fReportPromotion, NULL, NULL},
  {"report-scalar-replace", ' ', NULL, "Print scalar replacement stats", "F", &fReportScalarReplace, NULL, NULL},
+ {"report-stack-allocation", ' ', NULL, "Print class instances allocated on the stack in user code", "F", &fReportStackAllocation, NULL, NULL},
 
  {"", ' ', NULL, "Developer Flags -- Miscellaneous", NULL, NULL, NULL, NULL},
  {"allow-noinit-array-not-pod", ' ', NULL, "Allow noinit for arrays of records", "N", &fAllowNoinitArrayNotPod, "CHPL_BREAK_ON_CODEGEN", NULL},
@@ -1492,6 +1521,27 @@ static void checkLLVMCodeGen() {
 #endif
 }
 
+static void checkProfileGuidedOptimization() {
+  if (fProfileGenerate == false && fProfileUse[0] == '\0')
+    return;
+
+  if (fLlvmCodegen == false)
+    USR_FATAL("--profile-generate and --profile-use require the LLVM backend");
+
+  if (fProfileGenerate && fProfileUse[0] != '\0')
+    USR_FATAL("--profile-generate and --profile-use cannot be used together");
+
+  if (fProfileUse[0] != '\0') {
+    FILE* profile = fopen(fProfileUse, "r");
+
+    if (profile == NULL)
+      USR_FATAL("Could not open profile '%s' given to --profile-use",
+                fProfileUse);
+
+    fclose(profile);
+  }
+}
+
 static void checkTargetCpu() {
   if (specializeCCode && (strcmp(CHPL_TARGET_CPU, "unknown") == 0)) {
     USR_WARN("--specialize was set, but CHPL_TARGET_CPU is 'unknown'. If "
@@ -1601,6 +1651,8 @@ static void postprocess_args() {
 
   checkLLVMCodeGen();
 
+  checkProfileGuidedOptimization();
+
   checkTargetCpu();
 
   checkIncrementalAndOptimized();
@@ -38,6 +38,10 @@ namespace frontend {
 
   const uast::Builder::Result& parseFile(Context* context, UniqueString path);
 
+  // Runs parseFile for each of the paths. Files that need to be
+  // parsed are parsed in parallel.
+  void parseFiles(Context* context, const std::vector<UniqueString>& paths);
+
   using LocationsMap = std::unordered_map<ID, Location>;
   const LocationsMap& fileLocations(Context* context, UniqueString path);
 
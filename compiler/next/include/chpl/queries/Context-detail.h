@@ -22,12 +22,16 @@
 
 #include "chpl/queries/ErrorMessage.h"
 #include "chpl/queries/UniqueString.h"
+#include "chpl/util/arena.h"
 #include "chpl/util/memory.h"
 #include "chpl/util/hash.h"
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -40,17 +44,75 @@ class ID;
 
 namespace detail {
 
-struct UniqueStrEqual final {
-  bool operator()(const char* lhs, const char* rhs) const {
-    // pass the 2 metadata bytes
-    return strcmp(lhs, rhs) == 0;
-  }
-};
+/*
+  This table stores the unique'd strings for a Context.
+
+  It is divided into shards, each protected by its own mutex, so that
+  strings can be created from several threads with little contention.
+  The number of shards is a power of 2 that grows with the hardware
+  concurrency, up to MAX_SHARDS, so a single-threaded Context does not
+  pay for an arena block per shard.
+  Each shard is an open-addressing hash table that stores the hash of
+  each string next to the pointer to it. That way, growing the table
+  does not rehash the strings, and probing only compares strings
+  whose hashes match.
+
+  The string data is allocated from an Arena for each shard. It is
+  stored after 2 bytes of metadata: the GC mark and then 0x02.
+  Strings that fit in a UniqueString handle never get here
+  (see InlinedString).
+ */
+class UniqueStringsTable final {
+ public:
+  static const size_t MAX_SHARDS = 64;
+
+ private:
+  struct Entry {
+    size_t hash;
+    char* buf; // nullptr for an empty slot
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::vector<Entry> entries; // size is 0 or a power of 2
+    size_t count = 0;
+    Arena arena;
+  };
 
-struct UniqueStrHash final {
-  size_t operator()(const char* s) const {
-    return chpl::hash(s);
+  std::unique_ptr<Shard[]> shards_;
+  size_t numShards_ = 0;
+  int shardBits_ = 0; // log2(numShards_)
+
+  size_t shardIndex(size_t hash) const {
+    // use the high bits to pick the shard since
+    // the low bits are used to pick the entry within it
+    if (shardBits_ == 0) return 0;
+    return hash >> (8*sizeof(size_t) - shardBits_);
   }
+  static void insertEntry(std::vector<Entry>& entries, Entry e);
+  static void grow(Shard& shard);
+
+ public:
+  UniqueStringsTable();
+  ~UniqueStringsTable();
+
+  UniqueStringsTable(const UniqueStringsTable&) = delete;
+  UniqueStringsTable& operator=(const UniqueStringsTable&) = delete;
+
+  static size_t hashString(const char* s, size_t len);
+
+  // Returns the unique'd version of the 'len' bytes at 's'
+  // (which should be followed by a null terminator).
+  // New strings are given the GC mark 'gcMark', and existing ones are
+  // marked with it if 'mark' is set.
+  const char* getOrCreate(const char* s, size_t len, char gcMark, bool mark);
+
+  // Returns the number of strings stored. Not thread-safe.
+  size_t size() const;
+
+  // Frees the strings that are not marked with 'gcMark'.
+  // Returns the number of strings freed. Not thread-safe.
+  size_t collect(char gcMark, bool trace);
 };
 
 }
@@ -96,6 +158,21 @@ bool queryArgsEquals(const std::tuple<Ts...>& lhs, const std::tuple<Ts...>& rhs)
   return queryArgsEqualsImpl(lhs, rhs, std::index_sequence_for<Ts...>{});
 }
 
+template<typename... ArgTs>
+struct QueryArgTupleHash final {
+  size_t operator()(const std::tuple<ArgTs...>& tupleOfArgs) const {
+    return chpl::hash(tupleOfArgs);
+  }
+};
+
+template<typename... ArgTs>
+struct QueryArgTupleEqual final {
+  bool operator()(const std::tuple<ArgTs...>& lhs,
+                  const std::tuple<ArgTs...>& rhs) const {
+    return queryArgsEquals(lhs, rhs);
+  }
+};
+
 template<typename ResultType, typename... ArgTs>
 struct QueryMapArgTupleHash final {
   size_t operator()(const QueryMapResult<ResultType, ArgTs...>& r) const {
@@ -232,6 +309,10 @@ class QueryMap final : public QueryMapBase {
   using MapType = std::unordered_set<TheResultType,
                                      QueryMapArgTupleHash<ResultType, ArgTs...>,
                                      QueryMapArgTupleEqual<ResultType, ArgTs...>>;
+  using PrecomputedMapType = std::unordered_map<std::tuple<ArgTs...>,
+                                                ResultType,
+                                                QueryArgTupleHash<ArgTs...>,
+                                                QueryArgTupleEqual<ArgTs...>>;
   using QueryFunctionType = const ResultType& (*)(Context* context, ArgTs...);
 
   // the main map (which is actually a set since the result needs to
@@ -240,12 +321,15 @@ class QueryMap final : public QueryMapBase {
   // old results stores replaced results long enough for dependent
   // queries to compare with them.
   std::vector<ResultType> oldResults;
+  // results computed ahead of time (e.g. in parallel) that are
+  // waiting to be used when the query runs.
+  PrecomputedMapType precomputed;
   // the function to recompute the query.
   QueryFunctionType queryFunction;
 
   QueryMap(const char* queryName, bool isInputQuery, QueryFunctionType queryFunction)
      : QueryMapBase(queryName, isInputQuery),
-       map(), oldResults(),
+       map(), oldResults(), precomputed(),
        queryFunction(queryFunction) {
   }
   ~QueryMap() = default;
@@ -267,6 +351,7 @@ class QueryMap final : public QueryMapBase {
     }
 
     oldResults.clear();
+    precomputed.clear();
   }
 };
 
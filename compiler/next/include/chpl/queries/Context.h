@@ -169,10 +169,10 @@ into the AST element pointers.
  */
 class Context {
  private:
-  // map that supports uniqueCString / UniqueString
-  // TODO this could be an unordered_set
-  using UniqueStringsTableType = std::unordered_map<const char*, char*, chpl::detail::UniqueStrHash, chpl::detail::UniqueStrEqual>;
-  UniqueStringsTableType uniqueStringsTable;
+  // table that supports uniqueCString / UniqueString.
+  // It can be used from multiple threads (e.g. by the parser
+  // when files are parsed in parallel).
+  chpl::detail::UniqueStringsTable uniqueStringsTable;
 
   // Map from a query function pointer to appropriate QueryMap object.
   // Maps to an 'owned' heap-allocated thing to manage having subclasses
@@ -199,7 +199,7 @@ class Context {
   querydetail::RevisionNumber lastPrepareToGCRevisionNumber = 0;
   querydetail::RevisionNumber gcCounter = 1;
 
-  const char* getOrCreateUniqueString(const char* s);
+  const char* getOrCreateUniqueString(const char* s, size_t len);
 
   // saves the dependency in the parent query, which is assumed
   // to be at queryStack.back().
@@ -255,11 +255,21 @@ class Context {
   void recomputeIfNeeded(const querydetail::QueryMapResultBase* resultEntry);
   void updateForReuse(const querydetail::QueryMapResultBase* resultEntry);
 
+  bool queryCanUseSavedResult(
+            const querydetail::QueryMapResultBase* resultEntry);
+
   bool queryCanUseSavedResultAndPushIfNot(
             const void* queryFunction,
             const querydetail::QueryMapResultBase* resultEntry);
 
-  // Future Work: make the context thread-safe
+  // Future Work: make the query framework itself thread-safe.
+  // Currently, only the UniqueString table can be used from multiple
+  // threads. Work that should run in parallel is done outside of the
+  // query and then handed to it with querySetPrecomputedResult.
+
+  // Future Work: save query results to disk, starting with the uAST
+  // for each file keyed by a hash of its fileText, so that a later
+  // compiler process can reload the files that have not changed.
 
   // Future Work: allow moving some AST to a different context
   //              (or, at least, that can handle the unique strings)
@@ -306,6 +316,13 @@ class Context {
    */
   const char* uniqueCString(const char* s);
 
+  /**
+    Get or create a unique string for a C string with length 'len'.
+    's[len]' should be the null terminator. This is the same as
+    uniqueCString(s) but it avoids computing the length again.
+   */
+  const char* uniqueCString(const char* s, size_t len);
+
   /**
    When the context is configured to run with garbage collection
    enabled, unique strings that are reused need to be marked.
@@ -346,6 +363,41 @@ class Context {
    */
   void setFilePathForModuleID(ID moduleID, UniqueString path);
 
+  /**
+    Returns true if running the query with these arguments would reuse
+    a saved result rather than evaluating the query. This can cause
+    dependencies of the saved result to be recomputed, but it does not
+    run the query itself.
+
+    This is useful to decide which queries need to be computed before
+    arranging to compute them in parallel.
+   */
+  template<typename ResultType,
+           typename... ArgTs>
+  bool queryCanReuseResult(
+       const ResultType& (*queryFunction)(Context* context, ArgTs...),
+       const std::tuple<ArgTs...>& tupleOfArgs,
+       const char* traceQueryName);
+
+  /**
+    Provide a result for a query that was computed ahead of time,
+    for example on another thread. The next time the query is run
+    with these arguments in the current revision, it can retrieve
+    that result with QUERY_TAKE_PRECOMPUTED instead of computing it.
+    The query still runs as usual, so dependencies are recorded
+    as they would be otherwise.
+
+    Precomputed results that are not used are discarded
+    by collectGarbage.
+   */
+  template<typename ResultType,
+           typename... ArgTs>
+  void querySetPrecomputedResult(
+       const ResultType& (*queryFunction)(Context* context, ArgTs...),
+       const std::tuple<ArgTs...>& tupleOfArgs,
+       ResultType result,
+       const char* traceQueryName);
+
   // the following functions are called by the macros defined in QueryImpl.h
   // and should not be called directly
 
@@ -381,6 +433,13 @@ class Context {
   const ResultType&
   queryGetSaved(const querydetail::QueryMapResult<ResultType, ArgTs...>* r);
 
+  template<typename ResultType,
+           typename... ArgTs>
+  bool queryTakePrecomputed(
+      querydetail::QueryMap<ResultType, ArgTs...>* queryMap,
+      const std::tuple<ArgTs...>& tupleOfArgs,
+      ResultType& result);
+
   void queryNoteError(ErrorMessage error);
 
   template<typename ResultType,
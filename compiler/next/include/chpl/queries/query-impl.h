@@ -266,6 +266,87 @@ Context::queryEnd(
   return ret->result;
 }
 
+template<typename ResultType,
+         typename... ArgTs>
+bool
+Context::queryCanReuseResult(
+    const ResultType& (*queryFunction)(Context* context, ArgTs...),
+    const std::tuple<ArgTs...>& tupleOfArgs,
+    const char* traceQueryName) {
+
+  const void* queryFuncV = (const void*) queryFunction;
+
+  auto mapSearch = this->queryDB.find(queryFuncV);
+  if (mapSearch == this->queryDB.end()) {
+    // the query has never been run
+    return false;
+  }
+
+  auto queryMap = (QueryMap<ResultType, ArgTs...>*) mapSearch->second.get();
+
+  // Look for a saved result without adding a new one
+  QueryMapResult<ResultType, ArgTs...> key(queryMap, tupleOfArgs);
+  auto search = queryMap->map.find(key);
+  if (search == queryMap->map.end()) {
+    return false;
+  }
+
+  const QueryMapResult<ResultType, ArgTs...>* r = &(*search);
+  if (r->lastChecked == -1) {
+    // the query is currently running
+    return false;
+  }
+
+  bool useSaved = queryCanUseSavedResult(r);
+
+  if (enableDebugTracing) {
+    printf("QUERY CAN REUSE %s (", traceQueryName);
+    queryArgsPrint(tupleOfArgs);
+    printf(") %s %p\n", useSaved?"YES":"NO", r);
+  }
+
+  return useSaved;
+}
+
+template<typename ResultType,
+         typename... ArgTs>
+void
+Context::querySetPrecomputedResult(
+    const ResultType& (*queryFunction)(Context* context, ArgTs...),
+    const std::tuple<ArgTs...>& tupleOfArgs,
+    ResultType result,
+    const char* traceQueryName) {
+
+  QueryMap<ResultType, ArgTs...>* queryMap =
+    getMap(queryFunction, tupleOfArgs, traceQueryName, false);
+
+  // replace any result that was already provided
+  queryMap->precomputed.erase(tupleOfArgs);
+  queryMap->precomputed.emplace(tupleOfArgs, std::move(result));
+
+  if (enableDebugTracing) {
+    printf("QUERY PRECOMPUTED %s (", traceQueryName);
+    queryArgsPrint(tupleOfArgs);
+    printf(")\n");
+  }
+}
+
+template<typename ResultType,
+         typename... ArgTs>
+bool
+Context::queryTakePrecomputed(QueryMap<ResultType, ArgTs...>* queryMap,
+                              const std::tuple<ArgTs...>& tupleOfArgs,
+                              ResultType& result) {
+  auto search = queryMap->precomputed.find(tupleOfArgs);
+  if (search == queryMap->precomputed.end()) {
+    return false;
+  }
+
+  result = std::move(search->second);
+  queryMap->precomputed.erase(search);
+  return true;
+}
+
 template<typename ResultType,
          typename... ArgTs>
 const QueryMapResult<ResultType, ArgTs...>*
@@ -396,6 +477,11 @@ Context::querySetterUpdateResult(
 #define QUERY_ERROR(error) \
   BEGIN_QUERY_CONTEXT->queryNoteError(error)
 
+#define QUERY_TAKE_PRECOMPUTED(result) \
+  (BEGIN_QUERY_CONTEXT->queryTakePrecomputed(BEGIN_QUERY_MAP, \
+                                             BEGIN_QUERY_ARGS, \
+                                             result))
+
 #define QUERY_DEPENDS_INPUT() \
   BEGIN_QUERY_CONTEXT->queryNoteInputDependency()
 
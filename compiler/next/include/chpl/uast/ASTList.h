@@ -23,7 +23,9 @@
 #include "chpl/uast/ASTTypes.h"
 #include "chpl/util/memory.h"
 
+#include <cstddef>
 #include <iterator>
+#include <utility>
 #include <vector>
 
 namespace chpl {
@@ -47,6 +49,63 @@ static inline ASTList makeASTList(owned<ASTNode> ast) {
   return lst;
 }
 
+/**
+  ASTChildren is the list of child AST nodes stored in an ASTNode.
+  It is a fixed-size array allocated from the same Arena as the node
+  that owns it, so a node and its child list are near each other in
+  memory and go away with the rest of the AST for a file.
+ */
+class ASTChildren final {
+ public:
+  using iterator = owned<ASTNode>*;
+  using const_iterator = const owned<ASTNode>*;
+
+ private:
+  owned<ASTNode>* elts_;
+  size_t size_;
+
+ public:
+  ASTChildren() : elts_(nullptr), size_(0) { }
+  /**
+    Move the nodes in 'lst' into an array allocated from the Arena
+    that 'owner' was allocated from.
+   */
+  ASTChildren(const void* owner, ASTList lst);
+  ~ASTChildren();
+
+  ASTChildren(ASTChildren&& other) noexcept
+    : elts_(other.elts_), size_(other.size_) {
+    other.elts_ = nullptr;
+    other.size_ = 0;
+  }
+  ASTChildren& operator=(ASTChildren&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ASTChildren(const ASTChildren&) = delete;
+  ASTChildren& operator=(const ASTChildren&) = delete;
+
+  size_t size() const { return size_; }
+
+  iterator begin() { return elts_; }
+  iterator end() { return elts_ + size_; }
+  const_iterator begin() const { return elts_; }
+  const_iterator end() const { return elts_ + size_; }
+
+  owned<ASTNode>& operator[](size_t i) { return elts_[i]; }
+  const owned<ASTNode>& operator[](size_t i) const { return elts_[i]; }
+
+  void swap(ASTChildren& other) {
+    std::swap(elts_, other.elts_);
+    std::swap(size_, other.size_);
+  }
+
+  /**
+    Move the nodes out into an ASTList, leaving this list empty.
+   */
+  ASTList take();
+};
+
 /**
  Update an AST list with some replacement AST.
 
@@ -64,16 +123,22 @@ static inline ASTList makeASTList(owned<ASTNode> ast) {
  The function returns 'true' if anything changed in 'keep'.
  */
 bool updateASTList(ASTList& keep, ASTList& addin);
+/**
+ Update an ASTChildren list as with updateASTList(ASTList&, ASTList&).
+ */
+bool updateASTList(ASTChildren& keep, ASTChildren& addin);
 
 /**
  Mark UniqueStrings in an AST list.
  */
 void markASTList(Context* context, const ASTList& keep);
+void markASTList(Context* context, const ASTChildren& keep);
 
 /**
  Returns true if this list only contains Expressions.
  */
 bool isExpressionASTList(const ASTList& list);
+bool isExpressionASTList(const ASTChildren& list);
 
 /**
  Defines an iterator over the AST list elements.
@@ -85,18 +150,18 @@ class ASTListIterator {
  public:
   using iterator_category = std::random_access_iterator_tag;
   using value_type = const CastToType*;
-  using difference_type = ASTList::const_iterator::difference_type;
+  using difference_type = std::ptrdiff_t;
   using pointer = const CastToType**;
   using reference = const CastToType*&;
 
  private:
-  ASTList::const_iterator it;
+  ASTChildren::const_iterator it;
 
  public:
   // needs to be default-constructible, copy-constructible,
   // copy-assignable and destructible
   ASTListIterator() = default;
-  explicit ASTListIterator(ASTList::const_iterator it) : it(it) { }
+  explicit ASTListIterator(ASTChildren::const_iterator it) : it(it) { }
   ~ASTListIterator() = default;
 
   ASTListIterator<CastToType>& operator=(const ASTListIterator<CastToType>& it) = default;
@@ -187,8 +252,8 @@ struct ASTListIteratorPair {
   ASTListIterator<CastToType> begin_;
   ASTListIterator<CastToType> end_;
 
-  ASTListIteratorPair(ASTList::const_iterator begin,
-                      ASTList::const_iterator end)
+  ASTListIteratorPair(ASTChildren::const_iterator begin,
+                      ASTChildren::const_iterator end)
     : begin_(begin), end_(end) {
   }
   ~ASTListIteratorPair() = default;
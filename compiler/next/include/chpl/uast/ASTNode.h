@@ -58,7 +58,7 @@ class ASTNode {
   ID id_;
 
  protected:
-  ASTList children_;
+  ASTChildren children_;
 
   /**
     This function needs to be defined by subclasses.
@@ -81,7 +81,7 @@ class ASTNode {
     : tag_(tag), id_(), children_() {
   }
   ASTNode(ASTTag tag, ASTList children)
-    : tag_(tag), id_(), children_(std::move(children)) {
+    : tag_(tag), id_(), children_(this, std::move(children)) {
   }
 
   // called by the Builder
@@ -90,6 +90,15 @@ class ASTNode {
  public:
   virtual ~ASTNode() = 0; // this is an abstract base class
 
+  /// \cond DO_NOT_DOCUMENT
+  // AST nodes are allocated from the arena of the Builder creating them
+  // with e.g. 'new (builder) Identifier(name)'. The arena keeps the nodes
+  // for a file close together in memory and avoids a malloc call per node.
+  static void* operator new(size_t size, Builder* builder);
+  static void operator delete(void* ptr, Builder* builder);
+  static void operator delete(void* ptr);
+  /// \endcond
+
   /**
     Returns the tag indicating which ASTNode subclass this is.
    */
@@ -23,6 +23,7 @@
 #include "chpl/uast/ASTNode.h"
 #include "chpl/queries/ErrorMessage.h"
 #include "chpl/queries/UniqueString.h"
+#include "chpl/util/arena.h"
 
 #include <vector>
 #include <unordered_map>
@@ -47,6 +48,10 @@ class Builder final {
   using declaredHereT = std::unordered_map<UniqueString,int>;
 
   Context* context_;
+  // the AST nodes created by this Builder, and their child lists, are
+  // allocated here. The memory is freed together once none of the nodes
+  // are in use, which may be long after the Builder is gone.
+  Arena arena_;
   UniqueString filepath_;
   UniqueString inferredModuleName_;
   ASTList topLevelExpressions_;
@@ -58,6 +63,7 @@ class Builder final {
           UniqueString filepath,
           UniqueString inferredModuleName)
   : context_(context),
+    arena_(Arena::TOGETHER),
     filepath_(filepath),
     inferredModuleName_(inferredModuleName),
     topLevelExpressions_(), errors_(), locations_map_(), locations_() {
@@ -73,6 +79,12 @@ class Builder final {
 
   Context* context() const { return context_; }
 
+  /**
+    Allocate memory for an AST node. This is called by
+    ASTNode::operator new.
+   */
+  void* allocate(size_t size) { return arena_.allocate(size); }
+
   /**
     Save a toplevel expression in to the builder.
     This is called by the parser.
@@ -105,7 +117,8 @@ class Builder final {
     Result();
     Result(Result&&) = default; // move-constructable
     Result(const Result&) = delete; // not copy-constructable
-    Result& operator=(const Result&) = delete; // not assignable
+    Result& operator=(Result&&) = default; // move-assignable
+    Result& operator=(const Result&) = delete; // not copy-assignable
 
     static bool update(Result& keep, Result& addin);
     static void mark(Context* context, const Result& keep);
@@ -132,14 +145,14 @@ class Builder final {
   // Use this in the parser to get a mutable view of a node's children so
   // that the node can be modified in place. Later we can also add a method
   // such as 'swapChildren' if we need it.
-  ASTList& mutableRefToChildren(ASTNode* ast) {
+  ASTChildren& mutableRefToChildren(ASTNode* ast) {
     return ast->children_;
   }
 
   // Use this to take the children of an AST node. The AST node is marked
   // as owned because it is consumed.
   ASTList takeChildren(owned<ASTNode> ast) {
-    auto ret = std::move(ast->children_);
+    auto ret = ast->children_.take();
     assert(ast->children_.size() == 0);
     return ret;
   }
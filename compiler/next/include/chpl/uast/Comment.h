@@ -74,20 +74,20 @@ class ASTListNoCommentsIterator {
  public:
   using iterator_category = std::forward_iterator_tag;
   using value_type = const CastToType*;
-  using difference_type = ASTList::const_iterator::difference_type;
+  using difference_type = std::ptrdiff_t;
   using pointer = const CastToType**;
   using reference = const CastToType*&;
 
  private:
-  ASTList::const_iterator it;
-  ASTList::const_iterator end;
+  ASTChildren::const_iterator it;
+  ASTChildren::const_iterator end;
 
  public:
   // needs to be default-constructible, copy-constructible,
   // copy-assignable and destructible
   ASTListNoCommentsIterator() = default;
-  explicit ASTListNoCommentsIterator(ASTList::const_iterator start,
-                                     ASTList::const_iterator end)
+  explicit ASTListNoCommentsIterator(ASTChildren::const_iterator start,
+                                     ASTChildren::const_iterator end)
     : it(start), end(end) {
 
     while (this->it != this->end && this->it->get()->isComment()) {
@@ -151,8 +151,8 @@ struct ASTListNoCommentsIteratorPair {
   ASTListNoCommentsIterator<CastToType> begin_;
   ASTListNoCommentsIterator<CastToType> end_;
 
-  ASTListNoCommentsIteratorPair(ASTList::const_iterator begin,
-                                ASTList::const_iterator end)
+  ASTListNoCommentsIteratorPair(ASTChildren::const_iterator begin,
+                                ASTChildren::const_iterator end)
     : begin_(begin, end), end_(end, end) {
   }
   ~ASTListNoCommentsIteratorPair() = default;
@@ -51,7 +51,7 @@ class Enum final : public TypeDecl {
 
     assert(isEnumElementAndCommentList(children_));
   }
-  static bool isEnumElementAndCommentList(const ASTList& list);
+  static bool isEnumElementAndCommentList(const ASTChildren& list);
   bool contentsMatchInner(const ASTNode* other) const override;
   void markUniqueStringsInner(Context* context) const override;
 
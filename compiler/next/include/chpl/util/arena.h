@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHPL_UTIL_ARENA_H
+#define CHPL_UTIL_ARENA_H
+
+#include <cstddef>
+
+namespace chpl {
+
+
+/**
+  An Arena is a bump allocator. It allocates memory in large blocks
+  in order to reduce the number of calls to malloc and to place
+  objects that are allocated together near each other in memory.
+
+  Blocks are aligned to their size, so the block holding an allocation
+  is found from its address and no per-allocation header is needed.
+
+  An Arena counts the allocations that have not yet been freed, either
+  for each block or for the Arena as a whole (see Arena::Reclaim). The
+  memory is returned to the system once those allocations are freed
+  and the Arena is no longer allocating from it. That means that memory
+  allocated from an Arena can outlive the Arena itself.
+
+  An Arena, and the memory allocated from it, is not thread-safe.
+  Memory allocated by an Arena on one thread can be freed on another
+  only once the first thread is no longer using that Arena.
+ */
+class Arena final {
+ public:
+  /** The size and alignment of the blocks that an Arena allocates. */
+  static const size_t BLOCK_SIZE = 64*1024;
+
+  /** When an Arena returns its memory to the system. */
+  enum Reclaim {
+    /** Free each block once the allocations within it are freed. */
+    PER_BLOCK,
+    /** Free all of the blocks together once every allocation is freed. */
+    TOGETHER,
+  };
+
+ private:
+  struct Block;
+  struct Group;
+  Reclaim reclaim_;
+  // the blocks being allocated from; the Arena holds a reference to it
+  Group* group_;
+
+  static Group* newGroup(bool together);
+  static Block* newBlock(Group* group, size_t capacity);
+  static void* allocateIn(Group* group, size_t size);
+  // drop a reference to 'group', freeing it when there are none left
+  static void release(Group* group);
+
+ public:
+  explicit Arena(Reclaim reclaim = PER_BLOCK)
+    : reclaim_(reclaim), group_(nullptr) { }
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /**
+    Allocate 'size' bytes. The returned memory is suitably aligned
+    for any type, just as with malloc.
+   */
+  void* allocate(size_t size);
+
+  /**
+    Allocate 'size' bytes from the same Arena as 'other', which must
+    have been returned by Arena::allocate on an Arena using
+    Reclaim::TOGETHER. The Arena itself need not still exist.
+   */
+  static void* allocateWith(const void* other, size_t size);
+
+  /**
+    Free memory returned by Arena::allocate or Arena::allocateWith.
+   */
+  static void deallocate(void* ptr);
+};
+
+
+} // end namespace chpl
+
+#endif
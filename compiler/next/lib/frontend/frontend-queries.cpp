@@ -29,9 +29,11 @@
 
 #include "../util/filesystem.h"
 
+#include <atomic>
 #include <cstdio>
 #include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -124,10 +126,14 @@ const uast::Builder::Result& parseFile(Context* context, UniqueString path) {
   uast::Builder::Result result;
   result.filePath = path;
 
-  auto parser = Parser::build(context);
-  const char* pathc = path.c_str();
-  const char* textc = text.c_str();
-  uast::Builder::Result tmpResult = parser->parseString(pathc, textc);
+  // Use the result of parsing the file in parseFiles if there is one
+  uast::Builder::Result tmpResult;
+  if (!QUERY_TAKE_PRECOMPUTED(tmpResult)) {
+    auto parser = Parser::build(context);
+    const char* pathc = path.c_str();
+    const char* textc = text.c_str();
+    tmpResult = parser->parseString(pathc, textc);
+  }
   result.topLevelExpressions.swap(tmpResult.topLevelExpressions);
   result.locations.swap(tmpResult.locations);
   for (ErrorMessage& e : tmpResult.errors) {
@@ -139,6 +145,63 @@ const uast::Builder::Result& parseFile(Context* context, UniqueString path) {
   return QUERY_END(result);
 }
 
+void parseFiles(Context* context, const std::vector<UniqueString>& paths) {
+  // Gather the files that parseFile can't reuse a result for.
+  // This reads the files (with the fileText query) in a serial manner.
+  std::vector<UniqueString> toParse;
+  std::vector<const std::string*> texts;
+  for (UniqueString path : paths) {
+    auto tupleOfArgs = std::make_tuple(path);
+    if (!context->queryCanReuseResult(parseFile, tupleOfArgs, "parseFile")) {
+      toParse.push_back(path);
+      texts.push_back(&fileText(context, path));
+    }
+  }
+
+  size_t nFiles = toParse.size();
+  std::vector<uast::Builder::Result> results(nFiles);
+
+  // Run the parser on the files in parallel. The parser only
+  // interacts with the Context in order to create UniqueStrings.
+  std::atomic<size_t> next(0);
+  auto parseWorker = [&]() {
+    auto parser = Parser::build(context);
+    while (true) {
+      size_t i = next.fetch_add(1);
+      if (i >= nFiles) break;
+      results[i] = parser->parseString(toParse[i].c_str(), texts[i]->c_str());
+    }
+  };
+
+  size_t nThreads = std::thread::hardware_concurrency();
+  if (nThreads > nFiles) nThreads = nFiles;
+
+  if (nThreads <= 1) {
+    parseWorker();
+  } else {
+    // this thread counts as one of the workers
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; i++) {
+      threads.emplace_back(parseWorker);
+    }
+    parseWorker();
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  // Hand the results to the parseFile query and run it.
+  for (size_t i = 0; i < nFiles; i++) {
+    context->querySetPrecomputedResult(parseFile,
+                                       std::make_tuple(toParse[i]),
+                                       std::move(results[i]),
+                                       "parseFile");
+  }
+  for (UniqueString path : paths) {
+    parseFile(context, path);
+  }
+}
+
 const LocationsMap& fileLocations(Context* context, UniqueString path) {
   QUERY_BEGIN(fileLocations, context, path);
 
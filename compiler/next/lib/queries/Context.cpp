@@ -25,8 +25,8 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cassert>
-
-#include "../util/my_aligned_alloc.h" // assumes size_t defined
+#include <cstring>
+#include <thread>
 
 namespace chpl {
 
@@ -60,60 +60,174 @@ void Context::defaultReportError(const ErrorMessage& err) {
 }
 
 Context::~Context() {
+}
+
+namespace detail {
+
+
+UniqueStringsTable::UniqueStringsTable() {
+  // Enough shards for each hardware thread to usually find its own
+  size_t nThreads = std::thread::hardware_concurrency();
+  numShards_ = 1;
+  while (numShards_ < nThreads && numShards_ < MAX_SHARDS) {
+    numShards_ *= 2;
+    shardBits_++;
+  }
+  shards_.reset(new Shard[numShards_]);
+}
+
+UniqueStringsTable::~UniqueStringsTable() {
   // free all of the unique'd strings
-  for (auto& item: uniqueStringsTable)
-    free(item.second);
-}
-
-#define ALIGN_DN(i, size)  ((i) & ~((size) - 1))
-#define ALIGN_UP(i, size)  ALIGN_DN((i) + (size) - 1, size)
-
-static char* allocateEvenAligned(size_t amt) {
-  char* buf = (char*) malloc(amt);
-  // Normally, malloc returns something that is aligned to 16 bytes,
-  // but it's technically possible that a platform library
-  // could not do so. So, here we check.
-  // We only need even alignment here.
-  if ((((uintptr_t)buf) & 1) != 0) {
-    free(buf);
-    // try again with an aligned allocation
-    size_t alignment = sizeof(void *);
-    size_t align_up_len = ALIGN_UP(amt, sizeof(void*));
-    buf = (char*) my_aligned_alloc(alignment, align_up_len);
+  for (size_t s = 0; s < numShards_; s++) {
+    const Shard& shard = shards_[s];
+    for (const Entry& e : shard.entries) {
+      if (e.buf != nullptr)
+        Arena::deallocate(e.buf);
+    }
   }
-  assert(buf);
-  assert((((uintptr_t)buf) & 1) == 0);
-  return buf;
-}
-
-const char* Context::getOrCreateUniqueString(const char* str) {
-  auto search = this->uniqueStringsTable.find(str);
-  if (search != this->uniqueStringsTable.end()) {
-    char* buf = search->second;
-    const char* key = buf+2; // pass the 2 bytes of metadata
-    // update the GC mark
-    this->markUniqueCString(key);
-    return key;
+}
+
+size_t UniqueStringsTable::hashString(const char* s, size_t len) {
+  // FNV-1a, as with chpl::hash(const char*), but using the length
+  uint64_t seed = FNV_offset_basis;
+  for (size_t i = 0; i < len; i++)
+    seed = (seed ^ static_cast<unsigned char>(s[i])) * FNV_prime;
+  return (size_t) seed;
+}
+
+void UniqueStringsTable::insertEntry(std::vector<Entry>& entries, Entry e) {
+  size_t mask = entries.size() - 1;
+  size_t i = e.hash & mask;
+  while (entries[i].buf != nullptr) {
+    i = (i + 1) & mask;
   }
-  char gcMark = this->gcCounter & 0xff;
-  size_t strLen = strlen(str);
-  size_t allocLen = strLen+3; // 2 bytes of metadata, str data, '\0'
-  char* buf = allocateEvenAligned(allocLen);
+  entries[i] = e;
+}
+
+void UniqueStringsTable::grow(Shard& shard) {
+  size_t newSize = shard.entries.size() * 2;
+  if (newSize == 0) newSize = 256;
+
+  std::vector<Entry> newEntries(newSize, Entry{0, nullptr});
+  // the hashes are stored so there is no need to rehash the strings
+  for (const Entry& e : shard.entries) {
+    if (e.buf != nullptr)
+      insertEntry(newEntries, e);
+  }
+  shard.entries.swap(newEntries);
+}
+
+const char* UniqueStringsTable::getOrCreate(const char* s, size_t len,
+                                            char gcMark, bool mark) {
+  size_t hash = hashString(s, len);
+  Shard& shard = shards_[shardIndex(hash)];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // keep the load factor at or below 1/2
+  if (2*(shard.count+1) > shard.entries.size()) {
+    grow(shard);
+  }
+
+  size_t mask = shard.entries.size() - 1;
+  size_t i = hash & mask;
+  while (true) {
+    Entry& e = shard.entries[i];
+    if (e.buf == nullptr) {
+      break; // not found
+    }
+    if (e.hash == hash) {
+      const char* key = e.buf+2; // pass the 2 bytes of metadata
+      if (memcmp(key, s, len+1) == 0) {
+        // update the GC mark
+        if (mark)
+          e.buf[0] = gcMark;
+        return key;
+      }
+    }
+    i = (i + 1) & mask;
+  }
+
+  size_t allocLen = len+3; // 2 bytes of metadata, str data, '\0'
+  // The Arena returns memory aligned as with malloc,
+  // so key will have even alignment.
+  char* buf = (char*) shard.arena.allocate(allocLen);
   // set the GC mark
   buf[0] = gcMark;
   // set the unused metadata (need to still have even alignment)
   buf[1] = 0x02;
   // copy the string data, including the null terminator
-  memcpy(buf+2, str, strLen+1);
+  memcpy(buf+2, s, len+1);
   const char* key = buf+2; // pass the 2 bytes of metadata
+  assert((((uintptr_t)key) & 1) == 0);
+
   // Add it to the table
-  this->uniqueStringsTable.insert(search, {key, buf});
+  shard.entries[i] = Entry{hash, buf};
+  shard.count++;
+
   return key;
 }
 
+size_t UniqueStringsTable::size() const {
+  size_t ret = 0;
+  for (size_t s = 0; s < numShards_; s++) {
+    ret += shards_[s].count;
+  }
+  return ret;
+}
+
+size_t UniqueStringsTable::collect(char gcMark, bool trace) {
+  size_t nFreed = 0;
+
+  for (size_t s = 0; s < numShards_; s++) {
+    Shard& shard = shards_[s];
+    // Rebuild the entries since an open-addressing table
+    // can't simply remove elements.
+    std::vector<Entry> newEntries(shard.entries.size(), Entry{0, nullptr});
+    size_t newCount = 0;
+    for (const Entry& e : shard.entries) {
+      if (e.buf == nullptr) {
+        // empty slot
+      } else if (e.buf[0] == gcMark) {
+        insertEntry(newEntries, e);
+        newCount++;
+        if (trace) {
+          printf("COPYING OVER UNIQUESTRING %s\n", e.buf+2);
+        }
+      } else {
+        if (trace) {
+          printf("WILL FREE UNIQUESTRING %s\n", e.buf+2);
+        }
+        Arena::deallocate(e.buf);
+        nFreed++;
+      }
+    }
+    shard.entries.swap(newEntries);
+    shard.count = newCount;
+  }
+
+  return nFreed;
+}
+
+
+} // end namespace detail
+
+const char* Context::getOrCreateUniqueString(const char* str, size_t len) {
+  char gcMark = this->gcCounter & 0xff;
+  bool mark = this->currentRevisionNumber ==
+              this->lastPrepareToGCRevisionNumber;
+  return this->uniqueStringsTable.getOrCreate(str, len, gcMark, mark);
+}
+
 const char* Context::uniqueCString(const char* s) {
   if (s == nullptr) s = "";
-  return this->getOrCreateUniqueString(s);
+  return this->getOrCreateUniqueString(s, strlen(s));
+}
+
+const char* Context::uniqueCString(const char* s, size_t len) {
+  if (s == nullptr) return this->uniqueCString(s);
+  assert(s[len] == '\0');
+  return this->getOrCreateUniqueString(s, len);
 }
 
 void Context::markUniqueCString(const char* s) {
@@ -210,38 +324,11 @@ void Context::collectGarbage() {
   if (this->lastPrepareToGCRevisionNumber == this->currentRevisionNumber) {
     // remove UniqueStrings that have not been marked
 
-    size_t nUniqueStringsBefore = uniqueStringsTable.size();
-
-    // Performance: Would it be better to modify the table in-place
-    // rather than creating a new table as is done here?
     char gcMark = this->gcCounter & 0xff;
-    UniqueStringsTableType newTable;
-    std::vector<char*> toFree;
-    // warning: this loop proceeds in a nondeterministic order
-    for (auto& e: uniqueStringsTable) {
-      const char* key = e.first;
-      char* buf = e.second;
-      if (buf[0] == gcMark) {
-        newTable.insert(std::make_pair(key, buf));
-        if (enableDebugTracing) {
-          printf("COPYING OVER UNIQUESTRING %s\n", key);
-        }
-      } else {
-        toFree.push_back(buf);
-        if (enableDebugTracing) {
-          printf("WILL FREE UNIQUESTRING %s\n", key);
-        }
-      }
-    }
-    for (char* buf: toFree) {
-      free(buf);
-    }
-    uniqueStringsTable.swap(newTable);
+    size_t nFreed = uniqueStringsTable.collect(gcMark, enableDebugTracing);
 
     if (enableDebugTracing) {
-      size_t nUniqueStringsAfter = uniqueStringsTable.size();
-      printf("COLLECTED %i UniqueStrings\n",
-             (int)(nUniqueStringsBefore-nUniqueStringsAfter));
+      printf("COLLECTED %i UniqueStrings\n", (int) nFreed);
     }
   }
 }
@@ -341,9 +428,7 @@ void Context::updateForReuse(const QueryMapResultBase* resultEntry) {
   }
 }
 
-bool Context::queryCanUseSavedResultAndPushIfNot(
-                   const void* queryFunction,
-                   const QueryMapResultBase* resultEntry) {
+bool Context::queryCanUseSavedResult(const QueryMapResultBase* resultEntry) {
 
   bool useSaved = false;
 
@@ -373,6 +458,15 @@ bool Context::queryCanUseSavedResultAndPushIfNot(
     }
   }
 
+  return useSaved;
+}
+
+bool Context::queryCanUseSavedResultAndPushIfNot(
+                   const void* queryFunction,
+                   const QueryMapResultBase* resultEntry) {
+
+  bool useSaved = queryCanUseSavedResult(resultEntry);
+
   if (useSaved == false) {
     // Since the result cannot be reused, the query will be evaluated.
     // So, push something to queryDeps
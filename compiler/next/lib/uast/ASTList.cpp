@@ -20,12 +20,67 @@
 #include "chpl/uast/ASTTypes.h"
 
 #include "chpl/uast/ASTNode.h"
+#include "chpl/util/arena.h"
+
+#include <cassert>
+#include <new>
 
 namespace chpl {
 namespace uast {
 
 
-bool updateASTList(ASTList& keep, ASTList& addin) {
+ASTChildren::ASTChildren(const void* owner, ASTList lst)
+  : elts_(nullptr), size_(lst.size()) {
+  if (size_ > 0) {
+    void* mem = Arena::allocateWith(owner, size_*sizeof(owned<ASTNode>));
+    elts_ = (owned<ASTNode>*) mem;
+    for (size_t i = 0; i < size_; i++) {
+      new (&elts_[i]) owned<ASTNode>(std::move(lst[i]));
+    }
+  }
+}
+
+ASTChildren::~ASTChildren() {
+  for (size_t i = 0; i < size_; i++) {
+    elts_[i].~owned<ASTNode>();
+  }
+  Arena::deallocate(elts_);
+}
+
+ASTList ASTChildren::take() {
+  ASTList ret;
+  ret.reserve(size_);
+  for (size_t i = 0; i < size_; i++) {
+    ret.push_back(std::move(elts_[i]));
+  }
+  ASTChildren empty;
+  swap(empty);
+  return ret;
+}
+
+// Store the results of updateASTListImpl into the lists.
+static void replaceLists(ASTList& keep, ASTList& addin,
+                         ASTList& newList, ASTList& junkList) {
+  keep.swap(newList);
+  addin.swap(junkList);
+}
+
+static void replaceLists(ASTChildren& keep, ASTChildren& addin,
+                         ASTList& newList, ASTList& junkList) {
+  // newList has as many elements as addin, and junkList as many as
+  // keep, so swapping the arrays leaves room to store them in place.
+  keep.swap(addin);
+  assert(keep.size() == newList.size() && addin.size() == junkList.size());
+  for (size_t i = 0; i < newList.size(); i++) {
+    keep[i] = std::move(newList[i]);
+  }
+  for (size_t i = 0; i < junkList.size(); i++) {
+    addin[i] = std::move(junkList[i]);
+  }
+}
+
+template<typename ListT>
+static bool updateASTListImpl(ListT& keep, ListT& addin) {
   /*
    It's kindof like swapping 'keep' and 'addin' but it tries
    to keep old AST nodes when they are the same. This allows
@@ -170,20 +225,38 @@ bool updateASTList(ASTList& keep, ASTList& addin) {
   }
 
   assert(newList.size() == addin.size());
+  assert(junkList.size() == keep.size());
   // Swap the lists into place.
-  keep.swap(newList);
-  addin.swap(junkList);
+  replaceLists(keep, addin, newList, junkList);
 
   return anyChanged;
 }
 
-void markASTList(Context* context, const ASTList& keep) {
+bool updateASTList(ASTList& keep, ASTList& addin) {
+  return updateASTListImpl(keep, addin);
+}
+
+bool updateASTList(ASTChildren& keep, ASTChildren& addin) {
+  return updateASTListImpl(keep, addin);
+}
+
+template<typename ListT>
+static void markASTListImpl(Context* context, const ListT& keep) {
   for (const auto& elt: keep) {
     ASTNode::markAST(context, elt.get());
   }
 }
 
-bool isExpressionASTList(const ASTList& list) {
+void markASTList(Context* context, const ASTList& keep) {
+  markASTListImpl(context, keep);
+}
+
+void markASTList(Context* context, const ASTChildren& keep) {
+  markASTListImpl(context, keep);
+}
+
+template<typename ListT>
+static bool isExpressionASTListImpl(const ListT& list) {
   for (const auto& elt: list) {
     if (!elt->isExpression())
       return false;
@@ -191,6 +264,14 @@ bool isExpressionASTList(const ASTList& list) {
   return true;
 }
 
+bool isExpressionASTList(const ASTList& list) {
+  return isExpressionASTListImpl(list);
+}
+
+bool isExpressionASTList(const ASTChildren& list) {
+  return isExpressionASTListImpl(list);
+}
+
 
 } // end namespace uast
 } // end namespace chpl
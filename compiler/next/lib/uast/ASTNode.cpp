@@ -19,9 +19,11 @@
 
 #include "chpl/uast/ASTNode.h"
 
+#include "chpl/uast/Builder.h"
 #include "chpl/uast/NamedDecl.h"
 #include "chpl/uast/Expression.h"
 #include "chpl/uast/Identifier.h"
+#include "chpl/util/arena.h"
 
 namespace chpl {
 namespace uast {
@@ -30,6 +32,19 @@ namespace uast {
 ASTNode::~ASTNode() {
 }
 
+void* ASTNode::operator new(size_t size, Builder* builder) {
+  return builder->allocate(size);
+}
+
+void ASTNode::operator delete(void* ptr, Builder* builder) {
+  // called if a constructor throws
+  Arena::deallocate(ptr);
+}
+
+void ASTNode::operator delete(void* ptr) {
+  Arena::deallocate(ptr);
+}
+
 bool ASTNode::shallowMatch(const ASTNode* other) const {
   const ASTNode* lhs = this;
   const ASTNode* rhs = other;
@@ -58,9 +58,10 @@ owned<Begin> Begin::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Begin* ret = new Begin(std::move(lst), withClauseChildNum, blockStyle,
-                         bodyChildNum,
-                         numBodyStmts);
+  Begin* ret = new (builder) Begin(std::move(lst), withClauseChildNum,
+                                   blockStyle,
+                                   bodyChildNum,
+                                   numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -29,7 +29,8 @@ owned<Block> Block::build(Builder* builder, Location loc, ASTList stmts) {
   const int bodyChildNum = 0;
   const int numBodyStmts = stmts.size();
 
-  Block* ret = new Block(std::move(stmts), bodyChildNum, numBodyStmts);
+  Block* ret = new (builder) Block(std::move(stmts), bodyChildNum,
+                                   numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -62,13 +62,13 @@ owned<BracketLoop> BracketLoop::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  BracketLoop* ret = new BracketLoop(std::move(lst), indexChildNum,
-                                     iterandChildNum,
-                                     withClauseChildNum,
-                                     blockStyle,
-                                     loopBodyChildNum,
-                                     numLoopBodyStmts,
-                                     isExpressionLevel);
+  BracketLoop* ret = new (builder) BracketLoop(std::move(lst), indexChildNum,
+                                               iterandChildNum,
+                                               withClauseChildNum,
+                                               blockStyle,
+                                               loopBodyChildNum,
+                                               numLoopBodyStmts,
+                                               isExpressionLevel);
 
   builder->noteLocation(ret, loc);
   return toOwned(ret);
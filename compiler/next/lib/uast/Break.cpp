@@ -48,7 +48,7 @@ owned<Break> Break::build(Builder* builder, Location loc,
     lst.push_back(std::move(target));
   }
 
-  Break* ret = new Break(std::move(lst), targetChildNum);
+  Break* ret = new (builder) Break(std::move(lst), targetChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
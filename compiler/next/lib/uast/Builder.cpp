@@ -72,11 +72,9 @@ Builder::Result Builder::result() {
   UniqueString inferredName = this->createImplicitModuleIfNeeded();
   this->assignIDs(inferredName);
 
-  // Performance: We could consider copying all of these AST
-  // nodes to a newly allocated buffer big enough to hold them
-  // all contiguously. The reason to do so would be to ensure
-  // that a postorder traversal of the AST has good data locality
-  // (i.e. good cache behavior).
+  // Note that the AST nodes were allocated from arena_ in the order
+  // that the parser created them, which is close to a postorder
+  // traversal. That gives such traversals good data locality.
 
   Builder::Result ret;
   ret.filePath = filepath_;
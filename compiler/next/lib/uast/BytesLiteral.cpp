@@ -28,7 +28,7 @@ namespace uast {
 owned<BytesLiteral> BytesLiteral::build(Builder* builder, Location loc,
                                         std::string value,
                                         StringLikeLiteral::QuoteStyle quotes) {
-  BytesLiteral* ret = new BytesLiteral(std::move(value), quotes);
+  BytesLiteral* ret = new (builder) BytesLiteral(std::move(value), quotes);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -29,7 +29,7 @@ owned<CStringLiteral>
 CStringLiteral::build(Builder* builder, Location loc,
                       std::string value,
                       StringLikeLiteral::QuoteStyle quotes) {
-  CStringLiteral* ret = new CStringLiteral(std::move(value), quotes);
+  CStringLiteral* ret = new (builder) CStringLiteral(std::move(value), quotes);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -63,9 +63,9 @@ owned<Cobegin> Cobegin::build(Builder* builder,
     lst.push_back(std::move(taskBody));
   }
 
-  Cobegin* ret = new Cobegin(std::move(lst), withClauseChildNum,
-                             bodyChildNum,
-                             numTaskBodies);
+  Cobegin* ret = new (builder) Cobegin(std::move(lst), withClauseChildNum,
+                                       bodyChildNum,
+                                       numTaskBodies);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
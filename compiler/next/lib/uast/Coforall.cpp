@@ -61,12 +61,12 @@ owned<Coforall> Coforall::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  Coforall* ret = new Coforall(std::move(lst), indexChildNum,
-                               iterandChildNum,
-                               withClauseChildNum,
-                               blockStyle,
-                               loopBodyChildNum,
-                               numLoopBodyStmts);
+  Coforall* ret = new (builder) Coforall(std::move(lst), indexChildNum,
+                                         iterandChildNum,
+                                         withClauseChildNum,
+                                         blockStyle,
+                                         loopBodyChildNum,
+                                         numLoopBodyStmts);
 
   builder->noteLocation(ret, loc);
   return toOwned(ret);
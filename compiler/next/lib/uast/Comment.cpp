@@ -37,7 +37,7 @@ void Comment::markUniqueStringsInner(Context* context) const {
 
 
 owned<Comment> Comment::build(Builder* builder, Location loc, std::string c) {
-  Comment* ret = new Comment(std::move(c));
+  Comment* ret = new (builder) Comment(std::move(c));
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
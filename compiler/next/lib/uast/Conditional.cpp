@@ -83,13 +83,13 @@ owned<Conditional> Conditional::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  Conditional* ret = new Conditional(std::move(lst), thenBlockStyle,
-                                     thenBodyChildNum,
-                                     numThenBodyStmts,
-                                     elseBlockStyle,
-                                     elseBodyChildNum,
-                                     numElseBodyStmts,
-                                     isExpressionLevel);
+  Conditional* ret = new (builder) Conditional(std::move(lst), thenBlockStyle,
+                                               thenBodyChildNum,
+                                               numThenBodyStmts,
+                                               elseBlockStyle,
+                                               elseBodyChildNum,
+                                               numElseBodyStmts,
+                                               isExpressionLevel);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -114,13 +114,13 @@ owned<Conditional> Conditional::build(Builder* builder, Location loc,
   const int elseBodyChildNum = -1;
   const int numElseBodyStmts = 0; 
 
-  Conditional* ret = new Conditional(std::move(lst), thenBlockStyle,
-                                     thenBodyChildNum,
-                                     numThenBodyStmts,
-                                     elseBlockStyle,
-                                     elseBodyChildNum,
-                                     numElseBodyStmts,
-                                     /*isExpressionLevel*/ false);
+  Conditional* ret = new (builder) Conditional(std::move(lst), thenBlockStyle,
+                                               thenBodyChildNum,
+                                               numThenBodyStmts,
+                                               elseBlockStyle,
+                                               elseBodyChildNum,
+                                               numElseBodyStmts,
+                                               /*isExpressionLevel*/ false);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -48,7 +48,7 @@ owned<Continue> Continue::build(Builder* builder, Location loc,
     lst.push_back(std::move(target));
   }
 
-  Continue* ret = new Continue(std::move(lst), targetChildNum);
+  Continue* ret = new (builder) Continue(std::move(lst), targetChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
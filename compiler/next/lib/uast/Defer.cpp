@@ -31,8 +31,8 @@ owned<Defer> Defer::build(Builder* builder, Location loc,
   const int bodyChildNum = 0;
   const int numBodyStmts = stmts.size();
 
-  Defer* ret = new Defer(std::move(stmts), blockStyle, bodyChildNum,
-                         numBodyStmts);
+  Defer* ret = new (builder) Defer(std::move(stmts), blockStyle, bodyChildNum,
+                                   numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
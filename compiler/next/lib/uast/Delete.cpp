@@ -26,7 +26,7 @@ namespace uast {
 
 
 owned<Delete> Delete::build(Builder* builder, Location loc, ASTList exprs) {
-  Delete* ret = new Delete(std::move(exprs));
+  Delete* ret = new (builder) Delete(std::move(exprs));
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -56,10 +56,10 @@ owned<DoWhile> DoWhile::build(Builder* builder, Location loc,
   int conditionChildNum = lst.size();
   lst.push_back(std::move(condition));
 
-  DoWhile* ret = new DoWhile(std::move(lst), blockStyle,
-                             loopBodyChildNum,
-                             numLoopBodyStmts,
-                             conditionChildNum);
+  DoWhile* ret = new (builder) DoWhile(std::move(lst), blockStyle,
+                                       loopBodyChildNum,
+                                       numLoopBodyStmts,
+                                       conditionChildNum);
 
   builder->noteLocation(ret, loc);
   return toOwned(ret);
@@ -51,7 +51,7 @@ owned<Dot> Dot::build(Builder* builder,
 
   list.push_back(std::move(receiver));
 
-  Dot* ret = new Dot(std::move(list), fieldName);
+  Dot* ret = new (builder) Dot(std::move(list), fieldName);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
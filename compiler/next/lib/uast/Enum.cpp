@@ -25,7 +25,7 @@ namespace chpl {
 namespace uast {
 
 
-bool Enum::isEnumElementAndCommentList(const ASTList& list) {
+bool Enum::isEnumElementAndCommentList(const ASTChildren& list) {
   for (const auto& elt: list) {
     if (elt->isEnumElement() || elt->isComment()) {
       // OK
@@ -47,7 +47,7 @@ void Enum::markUniqueStringsInner(Context* context) const {
 owned<Enum> Enum::build(Builder* builder, Location loc,
                         UniqueString name, Decl::Visibility vis,
                         ASTList stmts) {
-  Enum* ret = new Enum(std::move(stmts), vis, name);
+  Enum* ret = new (builder) Enum(std::move(stmts), vis, name);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
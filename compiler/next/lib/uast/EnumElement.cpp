@@ -41,7 +41,7 @@ owned<EnumElement> EnumElement::build(Builder* builder, Location loc,
   if (initExpression.get() != nullptr) {
     lst.push_back(std::move(initExpression));
   }
-  EnumElement* ret = new EnumElement(std::move(lst), name);
+  EnumElement* ret = new (builder) EnumElement(std::move(lst), name);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -36,7 +36,7 @@ void ErroneousExpression::markUniqueStringsInner(Context* context) const {
 
 owned<ErroneousExpression> ErroneousExpression::build(Builder* builder,
                                                       Location loc) {
-  ErroneousExpression* ret = new ErroneousExpression();
+  ErroneousExpression* ret = new (builder) ErroneousExpression();
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
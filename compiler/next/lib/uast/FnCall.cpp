@@ -66,8 +66,8 @@ owned<FnCall> FnCall::build(Builder* builder,
   }
   actuals.clear();
 
-  FnCall* ret = new FnCall(std::move(lst), std::move(actualNames),
-                           callUsedSquareBrackets);
+  FnCall* ret = new (builder) FnCall(std::move(lst), std::move(actualNames),
+                                     callUsedSquareBrackets);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -70,13 +70,13 @@ owned<For> For::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  For* ret = new For(std::move(lst), indexChildNum,
-                     iterandChildNum,
-                     blockStyle,
-                     loopBodyChildNum,
-                     numLoopBodyStmts,
-                     isExpressionLevel,
-                     isParam);
+  For* ret = new (builder) For(std::move(lst), indexChildNum,
+                               iterandChildNum,
+                               blockStyle,
+                               loopBodyChildNum,
+                               numLoopBodyStmts,
+                               isExpressionLevel,
+                               isParam);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
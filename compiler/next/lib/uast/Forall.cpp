@@ -61,13 +61,13 @@ owned<Forall> Forall::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  Forall* ret = new Forall(std::move(lst), indexChildNum,
-                           iterandChildNum,
-                           withClauseChildNum,
-                           blockStyle,
-                           loopBodyChildNum,
-                           numLoopBodyStmts,
-                           isExpressionLevel);
+  Forall* ret = new (builder) Forall(std::move(lst), indexChildNum,
+                                     iterandChildNum,
+                                     withClauseChildNum,
+                                     blockStyle,
+                                     loopBodyChildNum,
+                                     numLoopBodyStmts,
+                                     isExpressionLevel);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
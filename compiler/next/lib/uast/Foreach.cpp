@@ -62,7 +62,7 @@ owned<Foreach> Foreach::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Foreach* ret = new Foreach(std::move(lst), indexChildNum,
+  Foreach* ret = new (builder) Foreach(std::move(lst), indexChildNum,
                            iterandChildNum,
                            withClauseChildNum,
                            blockStyle,
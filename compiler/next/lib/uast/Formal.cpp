@@ -54,8 +54,9 @@ Formal::build(Builder* builder, Location loc,
     lst.push_back(std::move(initExpression));
   }
 
-  Formal* ret = new Formal(std::move(lst), name, intent,
-                           typeExpressionChildNum, initExpressionChildNum);
+  Formal* ret = new (builder) Formal(std::move(lst), name, intent,
+                                     typeExpressionChildNum,
+                                     initExpressionChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
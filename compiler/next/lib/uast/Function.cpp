@@ -122,19 +122,19 @@ owned<Function> Function::build(Builder* builder, Location loc,
     }
   }
 
-  Function* ret = new Function(std::move(lst), name, vis,
-                               linkage, inline_, override_,
-                               kind, returnIntent, throws,
-                               linkageNameExprChildNum,
-                               formalsChildNum,
-                               thisFormalChildNum,
-                               numFormals,
-                               returnTypeChildNum,
-                               whereChildNum,
-                               lifetimeChildNum,
-                               numLifetimeParts,
-                               bodyChildNum,
-                               numBodyStmts);
+  Function* ret = new (builder) Function(std::move(lst), name, vis,
+                                         linkage, inline_, override_,
+                                         kind, returnIntent, throws,
+                                         linkageNameExprChildNum,
+                                         formalsChildNum,
+                                         thisFormalChildNum,
+                                         numFormals,
+                                         returnTypeChildNum,
+                                         whereChildNum,
+                                         lifetimeChildNum,
+                                         numLifetimeParts,
+                                         bodyChildNum,
+                                         numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -38,7 +38,7 @@ void Identifier::markUniqueStringsInner(Context* context) const {
 
 owned<Identifier> Identifier::build(Builder* builder,
                                     Location loc, UniqueString name) {
-  Identifier* ret = new Identifier(name);
+  Identifier* ret = new (builder) Identifier(name);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -27,7 +27,7 @@ namespace uast {
 
 owned<ImagLiteral> ImagLiteral::build(Builder* builder, Location loc,
                                       double value, UniqueString text) {
-  ImagLiteral* ret = new ImagLiteral(value, text);
+  ImagLiteral* ret = new (builder) ImagLiteral(value, text);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -27,7 +27,7 @@ namespace uast {
 
 owned<IntLiteral> IntLiteral::build(Builder* builder, Location loc,
                                     int64_t value, UniqueString text) {
-  IntLiteral* ret = new IntLiteral(value, text);
+  IntLiteral* ret = new (builder) IntLiteral(value, text);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -51,7 +51,7 @@ owned<Label> Label::build(Builder* builder, Location loc, UniqueString name,
 
   lst.push_back(std::move(loop));
 
-  Label* ret = new Label(std::move(lst), name);
+  Label* ret = new (builder) Label(std::move(lst), name);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -53,9 +53,9 @@ owned<Local> Local::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Local* ret = new Local(std::move(lst), condChildNum, blockStyle,
-                         bodyChildNum,
-                         numBodyStmts);
+  Local* ret = new (builder) Local(std::move(lst), condChildNum, blockStyle,
+                                   bodyChildNum,
+                                   numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -82,9 +82,9 @@ owned<Local> Local::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Local* ret = new Local(std::move(lst), condChildNum, blockStyle,
-                         bodyChildNum,
-                         numBodyStmts);
+  Local* ret = new (builder) Local(std::move(lst), condChildNum, blockStyle,
+                                   bodyChildNum,
+                                   numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -40,7 +40,7 @@ Module::build(Builder* builder, Location loc,
               UniqueString name, Decl::Visibility vis,
               Module::Kind kind, ASTList stmts) {
 
-  Module* ret = new Module(std::move(stmts), vis, name, kind);
+  Module* ret = new (builder) Module(std::move(stmts), vis, name, kind);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -48,7 +48,7 @@ owned<MultiDecl> MultiDecl::build(Builder* builder,
                                   Location loc,
                                   Decl::Visibility vis,
                                   ASTList varDecls) {
-  MultiDecl* ret = new MultiDecl(std::move(varDecls), vis);
+  MultiDecl* ret = new (builder) MultiDecl(std::move(varDecls), vis);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
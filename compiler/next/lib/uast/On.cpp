@@ -42,7 +42,8 @@ owned<On> On::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  On* ret = new On(std::move(lst), blockStyle, bodyChildNum, numBodyStmts);
+  On* ret = new (builder) On(std::move(lst), blockStyle, bodyChildNum,
+                             numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
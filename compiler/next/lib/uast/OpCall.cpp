@@ -53,7 +53,7 @@ owned<OpCall> OpCall::build(Builder* builder,
   list.push_back(std::move(lhs));
   list.push_back(std::move(rhs));
 
-  OpCall* ret = new OpCall(std::move(list), op);
+  OpCall* ret = new (builder) OpCall(std::move(list), op);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -65,7 +65,7 @@ owned<OpCall> OpCall::build(Builder* builder,
 
   list.push_back(std::move(expr));
 
-  OpCall* ret = new OpCall(std::move(list), op);
+  OpCall* ret = new (builder) OpCall(std::move(list), op);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -27,7 +27,7 @@ namespace uast {
 
 owned<RealLiteral> RealLiteral::build(Builder* builder, Location loc,
                                       double value, UniqueString text) {
-  RealLiteral* ret = new RealLiteral(value, text);
+  RealLiteral* ret = new (builder) RealLiteral(value, text);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -48,7 +48,7 @@ owned<Return> Return::build(Builder* builder, Location loc,
     lst.push_back(std::move(value));
   }
 
-  Return* ret = new Return(std::move(lst), valueChildNum);
+  Return* ret = new (builder) Return(std::move(lst), valueChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -53,9 +53,9 @@ owned<Serial> Serial::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Serial* ret = new Serial(std::move(lst), condChildNum, blockStyle,
-                           bodyChildNum,
-                           numBodyStmts);
+  Serial* ret = new (builder) Serial(std::move(lst), condChildNum, blockStyle,
+                                     bodyChildNum,
+                                     numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -82,9 +82,9 @@ owned<Serial> Serial::build(Builder* builder,
     lst.push_back(std::move(stmt));
   }
 
-  Serial* ret = new Serial(std::move(lst), condChildNum, blockStyle,
-                           bodyChildNum,
-                           numBodyStmts);
+  Serial* ret = new (builder) Serial(std::move(lst), condChildNum, blockStyle,
+                                     bodyChildNum,
+                                     numBodyStmts);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
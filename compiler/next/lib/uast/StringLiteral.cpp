@@ -30,7 +30,7 @@ namespace uast {
 owned<StringLiteral> StringLiteral::build(Builder* builder, Location loc,
                                           std::string value,
                                           StringLiteral::QuoteStyle quotes) {
-  StringLiteral* ret = new StringLiteral(std::move(value), quotes);
+  StringLiteral* ret = new (builder) StringLiteral(std::move(value), quotes);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
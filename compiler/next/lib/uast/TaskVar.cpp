@@ -57,9 +57,9 @@ owned<TaskVar> TaskVar::build(Builder* builder, Location loc,
     lst.push_back(std::move(initExpression));
   }
 
-  TaskVar* ret = new TaskVar(std::move(lst), name, intent,
-                             typeExpressionChildNum,
-                             initExpressionChildNum);
+  TaskVar* ret = new (builder) TaskVar(std::move(lst), name, intent,
+                                       typeExpressionChildNum,
+                                       initExpressionChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -86,11 +86,11 @@ owned<TupleDecl> TupleDecl::build(Builder* builder, Location loc,
     list.push_back(std::move(initExpression));
   }
 
-  TupleDecl* ret = new TupleDecl(std::move(list), vis,
-                                 kind,
-                                 numElements,
-                                 typeExpressionChildNum,
-                                 initExpressionChildNum);
+  TupleDecl* ret = new (builder) TupleDecl(std::move(list), vis,
+                                           kind,
+                                           numElements,
+                                           typeExpressionChildNum,
+                                           initExpressionChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -27,7 +27,7 @@ namespace uast {
 
 owned<UintLiteral> UintLiteral::build(Builder* builder, Location loc,
                                       uint64_t value, UniqueString text) {
-  UintLiteral* ret = new UintLiteral(value, text);
+  UintLiteral* ret = new (builder) UintLiteral(value, text);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -54,8 +54,9 @@ Variable::build(Builder* builder, Location loc,
     lst.push_back(std::move(initExpression));
   }
 
-  Variable* ret = new Variable(std::move(lst), vis, name, kind,
-                               typeExpressionChildNum, initExpressionChildNum);
+  Variable* ret = new (builder) Variable(std::move(lst), vis, name, kind,
+                                         typeExpressionChildNum,
+                                         initExpressionChildNum);
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
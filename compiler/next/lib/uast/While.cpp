@@ -57,10 +57,10 @@ owned<While> While::build(Builder* builder, Location loc,
     lst.push_back(std::move(stmt));
   }
 
-  While* ret = new While(std::move(lst), conditionChildNum,
-                         blockStyle,
-                         loopBodyChildNum,
-                         numLoopBodyStmts);
+  While* ret = new (builder) While(std::move(lst), conditionChildNum,
+                                   blockStyle,
+                                   loopBodyChildNum,
+                                   numLoopBodyStmts);
 
   builder->noteLocation(ret, loc);
   return toOwned(ret);
@@ -28,7 +28,7 @@ namespace uast {
 owned<WithClause> WithClause::build(Builder* builder,
                                     Location loc,
                                     ASTList exprs) {
-  WithClause* ret = new WithClause(std::move(exprs));
+  WithClause* ret = new (builder) WithClause(std::move(exprs));
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
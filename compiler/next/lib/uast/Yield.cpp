@@ -33,7 +33,7 @@ owned<Yield> Yield::build(Builder* builder, Location loc,
 
   lst.push_back(std::move(value));
 
-  Yield* ret = new Yield(std::move(lst));
+  Yield* ret = new (builder) Yield(std::move(lst));
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -26,7 +26,7 @@ namespace uast {
 
 
 owned<Zip> Zip::build(Builder* builder, Location loc, ASTList actuals) {
-  Zip* ret = new Zip(std::move(actuals));
+  Zip* ret = new (builder) Zip(std::move(actuals));
   builder->noteLocation(ret, loc);
   return toOwned(ret);
 }
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2021 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chpl/util/arena.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace chpl {
+
+
+static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+#define ALIGN_DN(i, size)  ((i) & ~((size) - 1))
+#define ALIGN_UP(i, size)  ALIGN_DN((i) + (size) - 1, size)
+
+// The blocks whose allocations are counted, and freed, together.
+// With Reclaim::PER_BLOCK that is a single block.
+struct Arena::Group {
+  // the number of allocations in these blocks that are not yet freed,
+  // plus one while an Arena is still allocating from them
+  size_t nLive;
+  // true if allocateWith may add to this group
+  bool together;
+  // all of the blocks in this group, linked through Block::next
+  Block* blocks;
+  // the block that small allocations are carved from
+  Block* current;
+};
+
+// The header at the start of each block. Since blocks are aligned to
+// BLOCK_SIZE and every allocation starts within the first BLOCK_SIZE
+// bytes of its block, masking an allocation's address finds the header.
+struct Arena::Block {
+  Group* group;
+  Block* next;
+  // the number of bytes of data that are in use
+  size_t used;
+  // the number of bytes of data available after the header
+  size_t capacity;
+};
+
+static const size_t BLOCK_DATA_OFFSET = ALIGN_UP(sizeof(void*)*2 +
+                                                 sizeof(size_t)*2,
+                                                 ALIGNMENT);
+static const size_t SMALL_BLOCK_CAPACITY = Arena::BLOCK_SIZE -
+                                           BLOCK_DATA_OFFSET;
+
+static char* blockData(void* block) {
+  return ((char*) block) + BLOCK_DATA_OFFSET;
+}
+
+static void* blockStart(const void* ptr) {
+  return (void*) (((uintptr_t) ptr) & ~(uintptr_t) (Arena::BLOCK_SIZE-1));
+}
+
+Arena::Group* Arena::newGroup(bool together) {
+  Group* group = (Group*) malloc(sizeof(Group));
+  if (group == nullptr) {
+    throw std::bad_alloc();
+  }
+  group->nLive = 1; // for the reference from the Arena
+  group->together = together;
+  group->blocks = nullptr;
+  group->current = nullptr;
+  return group;
+}
+
+Arena::Block* Arena::newBlock(Group* group, size_t capacity) {
+  void* mem = nullptr;
+  if (posix_memalign(&mem, BLOCK_SIZE, BLOCK_DATA_OFFSET + capacity) != 0) {
+    throw std::bad_alloc();
+  }
+  Block* block = (Block*) mem;
+  block->group = group;
+  block->next = group->blocks;
+  block->used = 0;
+  block->capacity = capacity;
+  group->blocks = block;
+  return block;
+}
+
+void Arena::release(Group* group) {
+  assert(group->nLive > 0);
+  group->nLive--;
+  if (group->nLive == 0) {
+    Block* next = nullptr;
+    for (Block* block = group->blocks; block != nullptr; block = next) {
+      next = block->next;
+      free(block);
+    }
+    free(group);
+  }
+}
+
+Arena::~Arena() {
+  if (group_ != nullptr) {
+    release(group_);
+  }
+}
+
+void* Arena::allocateIn(Group* group, size_t size) {
+  // round up, and give zero-sized allocations distinct addresses
+  // within their block
+  size_t needed = size == 0 ? ALIGNMENT : ALIGN_UP(size, ALIGNMENT);
+  char* ret = nullptr;
+
+  if (needed > BLOCK_SIZE/4) {
+    // Large allocations get a block of their own so that they
+    // don't waste the remainder of the current block.
+    Block* block = newBlock(group, needed);
+    block->used = needed;
+    ret = blockData(block);
+  } else {
+    Block* block = group->current;
+    if (block == nullptr || block->used + needed > block->capacity) {
+      block = newBlock(group, SMALL_BLOCK_CAPACITY);
+      group->current = block;
+    }
+    ret = blockData(block) + block->used;
+    block->used += needed;
+  }
+
+  group->nLive++;
+  assert((((uintptr_t) ret) & (ALIGNMENT-1)) == 0);
+  return ret;
+}
+
+void* Arena::allocate(size_t size) {
+  if (reclaim_ == TOGETHER) {
+    if (group_ == nullptr) {
+      group_ = newGroup(true);
+    }
+    return allocateIn(group_, size);
+  }
+
+  // With PER_BLOCK, each block is a group of its own.
+  if (size > BLOCK_SIZE/4) {
+    Group* group = newGroup(false);
+    void* ret = allocateIn(group, size);
+    release(group); // leaving the reference from the allocation
+    return ret;
+  }
+
+  size_t needed = size == 0 ? ALIGNMENT : ALIGN_UP(size, ALIGNMENT);
+  if (group_ == nullptr || group_->current == nullptr ||
+      group_->current->used + needed > group_->current->capacity) {
+    if (group_ != nullptr) {
+      release(group_);
+    }
+    group_ = newGroup(false);
+  }
+  return allocateIn(group_, size);
+}
+
+void* Arena::allocateWith(const void* other, size_t size) {
+  Block* block = (Block*) blockStart(other);
+  assert(block->group->together);
+  return allocateIn(block->group, size);
+}
+
+void Arena::deallocate(void* ptr) {
+  if (ptr == nullptr) return;
+
+  Block* block = (Block*) blockStart(ptr);
+  release(block->group);
+}
+
+
+} // end namespace chpl
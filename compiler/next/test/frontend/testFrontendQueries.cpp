@@ -542,6 +542,66 @@ static void test6() {
   checkPathAllChildren(ctx, mod, modulePath);
 }
 
+static void test7() {
+  printf("test7\n");
+  Context context;
+  Context* ctx = &context;
+
+  // parse several files with parseFiles, which parses them in parallel
+  std::vector<UniqueString> paths;
+  std::vector<std::string> contents;
+  for (int i = 0; i < 8; i++) {
+    std::string name = "Mod" + std::to_string(i);
+    auto path = UniqueString::build(ctx, name + ".chpl");
+    std::string text = "var " + name + "Var;\n"
+                       "var " + name + "OtherVar;\n"
+                       "proc " + name + "Proc() { " + name + "Var; }\n";
+    paths.push_back(path);
+    contents.push_back(text);
+  }
+
+  ctx->advanceToNextRevision(true);
+  for (size_t i = 0; i < paths.size(); i++) {
+    setFileText(ctx, paths[i], contents[i]);
+  }
+  parseFiles(ctx, paths);
+
+  std::vector<const Module*> modules;
+  for (size_t i = 0; i < paths.size(); i++) {
+    const Module* mod = parseOneModule(ctx, paths[i]);
+    assert(mod->numStmts() == 3);
+    assert(mod->stmt(0)->toVariable());
+    assert(mod->stmt(2)->toFunction());
+    checkPathAllChildren(ctx, mod, paths[i]);
+    modules.push_back(mod);
+  }
+  ctx->collectGarbage();
+
+  printf("test7 changing one file\n");
+  contents[3] = "var Mod3Var;\n"
+                "var Mod3OtherVar;\n"
+                "var Mod3ThirdVar;\n";
+  ctx->advanceToNextRevision(true);
+  for (size_t i = 0; i < paths.size(); i++) {
+    setFileText(ctx, paths[i], contents[i]);
+  }
+  parseFiles(ctx, paths);
+
+  for (size_t i = 0; i < paths.size(); i++) {
+    const Module* mod = parseOneModule(ctx, paths[i]);
+    assert(mod->numStmts() == 3);
+    if (i == 3) {
+      // the contents changed
+      assert(mod != modules[i]);
+      assert(mod->stmt(2)->toVariable());
+    } else {
+      // the unchanged files should be reused
+      assert(mod == modules[i]);
+    }
+  }
+  ctx->collectGarbage();
+}
+
 int main() {
   test0();
   test1();
@@ -550,6 +610,7 @@ int main() {
   test4();
   test5();
   test6();
+  test7();
 
   return 0;
 }
@@ -31,6 +31,8 @@
 #include <string>
 #include <iostream>
 #include <cassert>
+#include <thread>
+#include <vector>
 
 using namespace chpl;
 
@@ -188,6 +190,63 @@ static void test1() {
 }
 
 
+// check that strings created from several threads are unique'd
+static void test2() {
+  Context context;
+  Context* ctx = &context;
+
+  const int nThreads = 4;
+  const int nStrings = 5000;
+  std::vector<std::vector<const char*>> got(nThreads);
+
+  auto worker = [&](int tid) {
+    for (int i = 0; i < nStrings; i++) {
+      // use a different order in each thread
+      int n = (tid % 2 == 0) ? i : nStrings-1-i;
+      std::string str = "a long enough string number " + std::to_string(n);
+      got[tid].push_back(UniqueString::build(ctx, str).c_str());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < nThreads; tid++) {
+    threads.emplace_back(worker, tid);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int tid = 0; tid < nThreads; tid++) {
+    for (int i = 0; i < nStrings; i++) {
+      int n = (tid % 2 == 0) ? i : nStrings-1-i;
+      std::string str = "a long enough string number " + std::to_string(n);
+      assert(got[tid][i] == ctx->uniqueCString(str.c_str()));
+      assert(str == got[tid][i]);
+    }
+  }
+}
+
+// check that unused strings are collected and used ones are kept
+static void test3() {
+  Context context;
+  Context* ctx = &context;
+
+  ctx->advanceToNextRevision(true);
+  UniqueString keep = UniqueString::build(ctx, "this string is kept around");
+  UniqueString drop = UniqueString::build(ctx, "this string is collected");
+  ctx->collectGarbage();
+  std::string dropStr = drop.c_str();
+
+  ctx->advanceToNextRevision(true);
+  keep.mark(ctx);
+  ctx->collectGarbage();
+
+  UniqueString keep2 = UniqueString::build(ctx, "this string is kept around");
+  assert(keep == keep2);
+  UniqueString drop2 = UniqueString::build(ctx, dropStr);
+  assert(drop2.c_str() == dropStr);
+}
+
 int main(int argc, char** argv) {
   const char* inputFile = "moby.txt";
   std::string timingArg = "--timing";
@@ -201,6 +260,8 @@ int main(int argc, char** argv) {
 
   test0();
   test1();
+  test2();
+  test3();
 
   Context context;
   Context* ctx = &context;
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2021 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chpl/util/arena.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// always check assertions in this test
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+using namespace chpl;
+
+static void checkAligned(void* ptr) {
+  assert((((uintptr_t) ptr) % alignof(std::max_align_t)) == 0);
+}
+
+// allocations should be aligned, distinct, and usable
+static void test1() {
+  Arena arena;
+  std::vector<char*> ptrs;
+  for (int i = 0; i < 10000; i++) {
+    size_t size = 1 + (i % 100);
+    char* p = (char*) arena.allocate(size);
+    checkAligned(p);
+    memset(p, i & 0xff, size);
+    ptrs.push_back(p);
+  }
+  for (int i = 0; i < 10000; i++) {
+    size_t size = 1 + (i % 100);
+    for (size_t j = 0; j < size; j++) {
+      assert(ptrs[i][j] == (char) (i & 0xff));
+    }
+  }
+  for (char* p : ptrs) {
+    Arena::deallocate(p);
+  }
+}
+
+// allocations can outlive the Arena and large allocations work
+static void test2() {
+  std::vector<void*> ptrs;
+  {
+    Arena arena;
+    ptrs.push_back(arena.allocate(16));
+    ptrs.push_back(arena.allocate(Arena::BLOCK_SIZE));
+    ptrs.push_back(arena.allocate(16));
+  }
+  for (void* p : ptrs) {
+    checkAligned(p);
+    memset(p, 0, 16);
+  }
+  memset(ptrs[1], 0, Arena::BLOCK_SIZE);
+  for (void* p : ptrs) {
+    Arena::deallocate(p);
+  }
+  Arena::deallocate(nullptr);
+}
+
+// with Reclaim::TOGETHER, allocateWith adds to the same Arena, even
+// after the Arena is gone, and the memory lives until all of it is freed
+static void test3() {
+  std::vector<char*> ptrs;
+  {
+    Arena arena(Arena::TOGETHER);
+    ptrs.push_back((char*) arena.allocate(24));
+    ptrs.push_back((char*) arena.allocate(Arena::BLOCK_SIZE));
+  }
+  for (int i = 0; i < 10000; i++) {
+    size_t size = (i % 3 == 0) ? 0 : 1 + (i % 200);
+    char* p = (char*) Arena::allocateWith(ptrs[i % ptrs.size()], size);
+    checkAligned(p);
+    memset(p, i & 0xff, size);
+    ptrs.push_back(p);
+  }
+  memset(ptrs[1], 0, Arena::BLOCK_SIZE);
+  for (char* p : ptrs) {
+    memset(p, 0, 1);
+  }
+  // free in an order unrelated to the order of allocation
+  for (size_t i = 0; i < ptrs.size(); i += 2) {
+    Arena::deallocate(ptrs[i]);
+  }
+  for (size_t i = 1; i < ptrs.size(); i += 2) {
+    Arena::deallocate(ptrs[i]);
+  }
+}
+
+int main(int argc, char** argv) {
+  test1();
+  test2();
+  test3();
+
+  return 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <map>
 
 #include "astutil.h"
 #include "build.h"
@@ -44,8 +45,12 @@
 // - automatic local access: Use `localAccess` instead of `this` for array
 //                           accesses that can be proven to be local
 //
-// - automatic aggregation: Use aggregation instead of regular assignments for
-//                          applicable last statements within `forall` bodies
+// - automatic aggregation: Use aggregation instead of regular assignments or
+//                          read-modify-write updates for applicable last
+//                          statements within `forall` bodies
+//
+// - automatic prefetching: Prefetch the element that a later iteration will
+//                          access for indirect accesses like `A[idx[i]]`
 
 static int curLogDepth = 0;
 static bool LOG_ALA(int depth, const char *msg, BaseAST *node);
@@ -54,6 +59,9 @@ static void LOGLN_ALA(BaseAST *node);
 static bool LOG_AA(int depth, const char *msg, BaseAST *node);
 static void LOGLN_AA(BaseAST *node);
 
+static bool LOG_AP(int depth, const char *msg, BaseAST *node);
+static void LOGLN_AP(BaseAST *node);
+
 // Support for reporting calls that are not optimized for different reasons
 enum CallRejectReason {
   CRR_ACCEPT,
@@ -136,11 +144,24 @@ static CallExpr *findMaybeAggAssignInBlock(BlockStmt *block);
 static void removeAggregatorFromMaybeAggAssign(CallExpr *call, int argIndex);
 static void removeAggregatorFromFunction(Symbol *aggregator, FnSymbol *parent);
 static void removeAggregationFromRecursiveForallHelp(BlockStmt *block);
+static const char *getRMWOpName(CallExpr *call, CallExpr **accessCall,
+                                Expr **valExpr);
+static bool rmwSuitableForAggregation(CallExpr *call, ForallStmt *forall,
+                                      CallExpr **accessCall, Expr **valExpr,
+                                      const char **opName);
+static void insertRMWAggCandidate(CallExpr *call, CallExpr *accessCall,
+                                  Expr *valExpr, const char *opName,
+                                  ForallStmt *forall,
+                                  std::map<std::pair<Symbol *, const char *>,
+                                           ShadowVarSymbol *> &aggregators);
 static void autoAggregation(ForallStmt *forall);
+static CallExpr *getIndirectAccessIdxCall(CallExpr *call, Symbol *loopIdxSym);
+static void autoPrefetch(ForallStmt *forall);
 
 void doPreNormalizeArrayOptimizations() {
   const bool anyAnalysisNeeded = fAutoLocalAccess ||
                                  fAutoAggregation ||
+                                 fAutoPrefetch ||
                                  !fNoFastFollowers;
   if (anyAnalysisNeeded) {
     forv_Vec(ForallStmt, forall, gForallStmts) {
@@ -148,6 +169,12 @@ void doPreNormalizeArrayOptimizations() {
         symbolicFastFollowerAnalysis(forall);
       }
 
+      // this has to look at the loop body before auto local access rewrites
+      // the index accesses in it
+      if (fAutoPrefetch) {
+        autoPrefetch(forall);
+      }
+
       if (fAutoLocalAccess) {
         autoLocalAccess(forall);
       }
@@ -569,6 +596,15 @@ static void LOGLN_AA(BaseAST *node) {
   LOGLN_help(node, fAutoAggregation && fReportAutoAggregation);
 }
 
+static bool LOG_AP(int depth, const char *msg, BaseAST *node) {
+  return LOG_help(depth, msg, node, NOT_CLONE,
+                  fAutoPrefetch && fReportAutoPrefetch);
+}
+
+static void LOGLN_AP(BaseAST *node) {
+  LOGLN_help(node, fAutoPrefetch && fReportAutoPrefetch);
+}
+
 static bool LOG_ALA(int depth, const char *msg, BaseAST *node,
                     bool forallDetails) {
   ForallAutoLocalAccessCloneType cloneType = NOT_CLONE;
@@ -1645,10 +1681,25 @@ static void autoAggregation(ForallStmt *forall) {
   if (loopHasValidInductionVariables(forall)) {
     std::vector<Expr *> lastStmts = getLastStmtsForForallUnorderedOps(forall);
 
+    // one read-modify-write aggregator per (array, operation) in this forall
+    std::map<std::pair<Symbol *, const char *>, ShadowVarSymbol *> rmwAggs;
+
     for_vector(Expr, lastStmt, lastStmts) {
       if (CallExpr *lastCall = toCallExpr(lastStmt)) {
         bool reportedLoc = false;
-        if (lastCall->isNamedAstr(astrSassign)) {
+        CallExpr *accessCall = NULL;
+        Expr *valExpr = NULL;
+        const char *opName = NULL;
+
+        if (rmwSuitableForAggregation(lastCall, forall, &accessCall, &valExpr,
+                                      &opName)) {
+          LOG_AA(1, "Found a read-modify-write aggregation candidate",
+                 lastCall);
+
+          insertRMWAggCandidate(lastCall, accessCall, valExpr, opName, forall,
+                                rmwAggs);
+        }
+        else if (lastCall->isNamedAstr(astrSassign)) {
           // no need to do anything if it is array access
           if (assignmentSuitableForAggregation(lastCall, forall)) {
             reportedLoc = LOG_AA(1, "Found an aggregation candidate", lastCall);
@@ -1677,6 +1728,240 @@ static void autoAggregation(ForallStmt *forall) {
   LOGLN_AA(forall);
 }
 
+// If `call` is `A[e] op= v` or `A[e].add(v)` (or one of the other atomic
+// read-modify-write methods), return the name of the operation and set
+// `accessCall` to `A[e]` and `valExpr` to `v`. NULL otherwise.
+//
+// This only matches names, before resolution. The module code aggregates
+// only arrays of numeric or atomic numeric elements, and evaluates the
+// update as written otherwise. Aggregating atomic updates relaxes their
+// ordering: they are only guaranteed to be done at the end of the forall.
+static const char *getRMWOpName(CallExpr *call, CallExpr **accessCall,
+                                Expr **valExpr) {
+  static const char *compoundOps[] = { "+=", "-=", "*=", "&=", "|=", "^=" };
+  static const char *atomicOps[] = { "add", "sub", "or", "and", "xor" };
+
+  if (call->numActuals() == 2) {
+    for (size_t i = 0; i < sizeof(compoundOps)/sizeof(compoundOps[0]); i++) {
+      if (call->isNamed(compoundOps[i])) {
+        if (CallExpr *lhsCall = toCallExpr(call->get(1))) {
+          *accessCall = lhsCall;
+          *valExpr = call->get(2);
+          return astr(compoundOps[i]);
+        }
+      }
+    }
+  }
+  // we don't want to deal with the `order` argument
+  else if (call->numActuals() == 1) {
+    if (CallExpr *dotCall = toCallExpr(call->baseExpr)) {
+      if (dotCall->isNamedAstr(astrSdot)) {
+        CallExpr *recvCall = toCallExpr(dotCall->get(1));
+        SymExpr *methodSE = toSymExpr(dotCall->get(2));
+        if (recvCall != NULL && methodSE != NULL) {
+          if (VarSymbol *methodSym = toVarSymbol(methodSE->symbol())) {
+            if (Immediate *imm = methodSym->immediate) {
+              for (size_t i = 0; i < sizeof(atomicOps)/sizeof(atomicOps[0]);
+                   i++) {
+                if (strcmp(imm->string_value(), atomicOps[i]) == 0) {
+                  *accessCall = recvCall;
+                  *valExpr = call->get(1);
+                  return astr(atomicOps[i]);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// The aggregator generator needs to see the iterand to make sure that the
+// forall isn't over a recursive parallel iterator: those can't have
+// task-private variables. Only accept iterands that are cheap to evaluate again.
+static Expr *getIterandForRMWAggregation(ForallStmt *forall) {
+  AList &iterExprs = forall->iteratedExpressions();
+  if (iterExprs.length != 1) return NULL;
+
+  Expr *iterExpr = iterExprs.head;
+  if (isSymExpr(iterExpr)) return iterExpr;
+
+  // forall i in A.domain
+  if (CallExpr *iterCall = toCallExpr(iterExpr)) {
+    if (iterCall->isNamedAstr(astrSdot) && isSymExpr(iterCall->get(1))) {
+      if (SymExpr *fieldSE = toSymExpr(iterCall->get(2))) {
+        if (VarSymbol *fieldSym = toVarSymbol(fieldSE->symbol())) {
+          if (Immediate *imm = fieldSym->immediate) {
+            if (strcmp(imm->string_value(), "domain") == 0) {
+              return iterExpr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// `A[e] op= v` where `A[e]` is not known to be local. Whether the element type
+// supports aggregation is decided by the module code
+static bool rmwSuitableForAggregation(CallExpr *call, ForallStmt *forall,
+                                      CallExpr **accessCall, Expr **valExpr,
+                                      const char **opName) {
+  *opName = getRMWOpName(call, accessCall, valExpr);
+  if (*opName == NULL) return false;
+
+  if ((*accessCall)->numActuals() != 1) return false;
+
+  // local accesses don't benefit from aggregation
+  if (canBeLocalAccess(*accessCall)) return false;
+
+  if (getCallBaseSymIfSuitable(*accessCall, forall, /* checkArgs */ false,
+                               NULL, NULL) == NULL) {
+    return false;
+  }
+
+  if (getIterandForRMWAggregation(forall) == NULL) {
+    LOG_AA(1, "Can't aggregate read-modify-write: unsupported iterand", call);
+    return false;
+  }
+
+  return true;
+}
+
+// Replace `call` with
+//
+//   chpl__autoRMW(chpl_rmw_auto_agg, A, e, v, op);
+//
+// where `chpl_rmw_auto_agg` is a task-private aggregator. The module code
+// applies the update directly if the generator returned `none`.
+static void insertRMWAggCandidate(CallExpr *call, CallExpr *accessCall,
+                                  Expr *valExpr, const char *opName,
+                                  ForallStmt *forall,
+                                  std::map<std::pair<Symbol *, const char *>,
+                                           ShadowVarSymbol *> &aggregators) {
+  Symbol *arrSym = toSymExpr(accessCall->baseExpr)->symbol();
+
+  ShadowVarSymbol *&aggregator = aggregators[std::make_pair(arrSym, opName)];
+  if (aggregator == NULL) {
+    SET_LINENO(forall);
+
+    CallExpr *genCall = new CallExpr("chpl_rmwAggregatorFor",
+                                     new SymExpr(arrSym),
+                                     getIterandForRMWAggregation(forall)->copy(),
+                                     new_StringSymbol(opName));
+
+    UnresolvedSymExpr *aggTmp = new UnresolvedSymExpr("chpl_rmw_auto_agg");
+    aggregator = ShadowVarSymbol::buildForPrefix(SVP_VAR, aggTmp,
+                                                 NULL, //type
+                                                 genCall);
+    aggregator->addFlag(FLAG_COMPILER_ADDED_AGGREGATOR);
+    forall->shadowVariables().insertAtTail(aggregator->defPoint);
+
+    LOG_AA(2, "Potential read-modify-write aggregation", call);
+  }
+
+  SET_LINENO(call);
+  CallExpr *rmwCall = new CallExpr("chpl__autoRMW",
+                                   new SymExpr(aggregator),
+                                   new SymExpr(arrSym),
+                                   accessCall->get(1)->remove(),
+                                   valExpr->remove(),
+                                   new_StringSymbol(opName));
+  call->replace(rmwCall);
+}
+
+//
+// Normalize support for --auto-prefetch
+//
+
+// If `call` looks like `A[idx[i]]` where `i` is `loopIdxSym`, return the
+// inner `idx[i]` call. NULL otherwise
+static CallExpr *getIndirectAccessIdxCall(CallExpr *call, Symbol *loopIdxSym) {
+  if (call->numActuals() != 1) return NULL;
+
+  CallExpr *idxCall = toCallExpr(call->get(1));
+  if (idxCall == NULL || idxCall->numActuals() != 1) return NULL;
+
+  SymExpr *idxArgSE = toSymExpr(idxCall->get(1));
+  if (idxArgSE == NULL || idxArgSE->symbol() != loopIdxSym) return NULL;
+
+  return idxCall;
+}
+
+// For every distinct `A[idx[i]]` in the body of a forall over `i`, add
+//
+//   chpl__autoPrefetch(A, idx, i);
+//
+// to the top of the body. Whether `A` and `idx` are arrays is only known
+// after resolution; the module code turns the call into a no-op if they
+// aren't.
+static void autoPrefetch(ForallStmt *forall) {
+  if (forall->getModule()->modTag != MOD_USER) return;
+
+  if (!forall->optInfo.infoGathered) {
+    gatherForallInfo(forall);
+  }
+
+  LOG_AP(0, "Start analyzing forall for automatic prefetching", forall);
+
+  // we need exactly one index variable to compute a lookahead iteration
+  if (forall->optInfo.multiDIndices.size() == 1 &&
+      forall->optInfo.multiDIndices[0].size() == 1) {
+    Symbol *loopIdxSym = forall->optInfo.multiDIndices[0][0];
+
+    std::vector<CallExpr *> callExprs;
+    collectCallExprs(forall->loopBody(), callExprs);
+
+    std::set<std::pair<Symbol *, Symbol *> > seen;
+    std::vector<CallExpr *> prefetchCalls;
+
+    for_vector(CallExpr, call, callExprs) {
+      CallExpr *idxCall = getIndirectAccessIdxCall(call, loopIdxSym);
+      if (idxCall == NULL) continue;
+
+      int argIdx = -1;
+      Symbol *idxBaseSym = getCallBaseSymIfSuitable(idxCall, forall,
+                                                    /* checkArgs */ true,
+                                                    &argIdx, NULL);
+      Symbol *accBaseSym = getCallBaseSymIfSuitable(call, forall,
+                                                    /* checkArgs */ false,
+                                                    NULL, NULL);
+      if (idxBaseSym == NULL || accBaseSym == NULL) {
+        LOG_AP(1, "Not prefetching: access bases are not suitable", call);
+        continue;
+      }
+
+      if (seen.insert(std::make_pair(accBaseSym, idxBaseSym)).second) {
+        LOG_AP(1, "Found an indirect access to prefetch", call);
+
+        SET_LINENO(call);
+        prefetchCalls.push_back(new CallExpr("chpl__autoPrefetch",
+                                             new SymExpr(accBaseSym),
+                                             new SymExpr(idxBaseSym),
+                                             new SymExpr(loopIdxSym)));
+      }
+    }
+
+    // keep the prefetches in source order
+    for (std::vector<CallExpr *>::reverse_iterator it = prefetchCalls.rbegin();
+         it != prefetchCalls.rend(); ++it) {
+      forall->loopBody()->insertAtHead(*it);
+    }
+  }
+  else {
+    LOG_AP(1, "Can't optimize this forall: needs a single index variable",
+           forall);
+  }
+
+  LOG_AP(0, "End analyzing forall for automatic prefetching", forall);
+  LOGLN_AP(forall);
+}
+
 AggregationCandidateInfo::AggregationCandidateInfo(CallExpr *candidate,
                                                    ForallStmt *forall):
   candidate(candidate),
@@ -0,0 +1,601 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Reduce the number of remote forks performed by user code by restructuring
+// on statements before normalization:
+//
+//  - adjacent on statements with the same target are fused into one,
+//
+//  - an on statement that is the whole body of a serial loop over a range
+//    is hoisted out of the loop when its target is loop-invariant, and
+//
+//  - an on statement that ends a begin statement is made non-blocking, so
+//    that the begin task does not sit waiting for the remote side.
+//
+// All three rely on the shape that buildOnStmt() produces once cleanup has
+// flattened its scopeless wrapper:
+//
+//   def tmp;
+//   move(tmp, deref(<locale of target>));
+//   { body }                               // blockInfo: PRIM_BLOCK_ON
+//
+// The pass is enabled with --fuse-on-stmts and only looks at user code.
+//
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "ForLoop.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "symbol.h"
+
+#include <vector>
+
+struct OnStmtParts {
+  DefExpr*   tmpDef;
+  CallExpr*  tmpMove;
+  BlockStmt* onBlock;
+};
+
+static bool getOnStmtParts(Expr* stmt, OnStmtParts& parts);
+static Expr* getOnTarget(const OnStmtParts& parts);
+static Expr* nextStmt(Expr* stmt);
+static Expr* lastStmt(BlockStmt* block);
+static bool isDirectRangeLoop(ForLoop* loop, bool requireSimpleBounds);
+static bool isInvariantSymbol(Symbol* sym);
+static bool isInvariantTarget(Expr* expr);
+static bool sameTarget(Expr* a, Expr* b);
+static bool fuseWithNextOnStmt(const OnStmtParts& parts);
+static bool isIndexSetupStmt(ForLoop* loop, Expr* stmt);
+static bool findOnStmtThatIsLoopBody(ForLoop* loop, OnStmtParts& parts);
+static bool hoistOnStmtOutOfLoop(ForLoop* loop);
+static bool isGlobalSymbol(Symbol* sym);
+static bool isSafeForNonBlockingOn(BlockStmt* onBlock);
+static bool makeTrailingOnStmtNonBlocking(BlockStmt* beginBlock);
+static void fuseOnStmts(FnSymbol* fn);
+
+
+void fuseOnStmts() {
+  if (fFuseOnStmts == false || requireOutlinedOn() == false)
+    return;
+
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (fn->inTree() && fn->getModule()->modTag == MOD_USER)
+      fuseOnStmts(fn);
+  }
+}
+
+static void fuseOnStmts(FnSymbol* fn) {
+  std::vector<BaseAST*>   asts;
+  std::vector<BlockStmt*> blocks;
+
+  collect_asts(fn->body, asts);
+
+  for_vector(BaseAST, ast, asts) {
+    if (BlockStmt* block = toBlockStmt(ast))
+      blocks.push_back(block);
+  }
+
+  // Fuse first, so that a loop body made of several on statements with the
+  // same target can then be hoisted as a single one.
+  for_vector(BlockStmt, block, blocks) {
+    OnStmtParts parts;
+
+    if (block->parentSymbol == fn && getOnStmtParts(block, parts)) {
+      while (fuseWithNextOnStmt(parts)) {
+        if (fReportOptimizedOn)
+          printf("Fused on statement (%s:%d) with the following one\n",
+                 block->fname(), block->linenum());
+      }
+    }
+  }
+
+  // Visit inner loops first so that a loop nest can be hoisted one level
+  // at a time.
+  for (size_t i = blocks.size(); i > 0; i--) {
+    ForLoop* loop = toForLoop(blocks[i-1]);
+
+    if (loop != NULL && loop->parentSymbol == fn &&
+        hoistOnStmtOutOfLoop(loop) && fReportOptimizedOn)
+      printf("Hoisted on statement out of loop (%s:%d)\n",
+             loop->fname(), loop->linenum());
+  }
+
+  for_vector(BlockStmt, block, blocks) {
+    if (block->parentSymbol == fn && block->isBlockType(PRIM_BLOCK_BEGIN) &&
+        makeTrailingOnStmtNonBlocking(block) && fReportOptimizedOn)
+      printf("Made on statement at the end of begin (%s:%d) non-blocking\n",
+             block->fname(), block->linenum());
+  }
+}
+
+
+/************************************* | **************************************
+*                                                                             *
+* Recognizing on statements                                                   *
+*                                                                             *
+************************************** | *************************************/
+
+// 'stmt' is either the on block itself or the DefExpr of its temporary.
+static bool getOnStmtParts(Expr* stmt, OnStmtParts& parts) {
+  BlockStmt* onBlock = toBlockStmt(stmt);
+
+  if (DefExpr* def = toDefExpr(stmt))
+    if (def->next != NULL)
+      onBlock = toBlockStmt(def->next->next);
+
+  if (onBlock == NULL || onBlock->isBlockType(PRIM_BLOCK_ON) == false)
+    return false;
+
+  // PRIM_BLOCK_ON(isLocal, tmp); local ons are left alone
+  CallExpr* info    = onBlock->blockInfoGet();
+  SymExpr*  localSe = toSymExpr(info->get(1));
+  SymExpr*  tmpSe   = toSymExpr(info->get(2));
+
+  if (localSe == NULL || localSe->symbol() != gFalse || tmpSe == NULL)
+    return false;
+
+  CallExpr* move = toCallExpr(onBlock->prev);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+    return false;
+
+  SymExpr* lhs = toSymExpr(move->get(1));
+  DefExpr* def = toDefExpr(move->prev);
+
+  if (lhs == NULL || lhs->symbol() != tmpSe->symbol() ||
+      def == NULL || def->sym != tmpSe->symbol())
+    return false;
+
+  if (isDefExpr(stmt) && stmt != def)
+    return false;
+
+  parts.tmpDef  = def;
+  parts.tmpMove = move;
+  parts.onBlock = onBlock;
+
+  return true;
+}
+
+// Returns the expression the user wrote after 'on', stripping the
+// primitives that buildOnStmt() wraps it in.
+static Expr* getOnTarget(const OnStmtParts& parts) {
+  CallExpr* deref = toCallExpr(parts.tmpMove->get(2));
+
+  if (deref == NULL || deref->isPrimitive(PRIM_DEREF) == false)
+    return NULL;
+
+  CallExpr* localeId = toCallExpr(deref->get(1));
+
+  if (localeId != NULL && localeId->isPrimitive(PRIM_WIDE_GET_LOCALE))
+    return localeId->get(1);
+
+  return localeId;
+}
+
+static Expr* nextStmt(Expr* stmt) {
+  Expr* next = stmt->next;
+
+  while (next != NULL && isEndOfStatementMarker(next))
+    next = next->next;
+
+  return next;
+}
+
+static Expr* lastStmt(BlockStmt* block) {
+  Expr* last = block->body.tail;
+
+  while (last != NULL && isEndOfStatementMarker(last))
+    last = last->prev;
+
+  return last;
+}
+
+// Is this a serial loop over an anonymous range that was replaced with a
+// direct range iterator?  Such loops yield their indices by value and do
+// not depend on the locale they run on.
+static bool isDirectRangeLoop(ForLoop* loop, bool requireSimpleBounds) {
+  if (loop->isLoweredForallLoop() || loop->isForExpr() ||
+      loop->isCoforallLoop() || loop->zipperedGet())
+    return false;
+
+  Symbol* iterator = loop->iteratorGet()->symbol();
+
+  for (Expr* stmt = loop->prev; stmt != NULL; stmt = stmt->prev) {
+    CallExpr* move = toCallExpr(stmt);
+
+    if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+      continue;
+
+    SymExpr* lhs = toSymExpr(move->get(1));
+
+    if (lhs == NULL || lhs->symbol() != iterator)
+      continue;
+
+    CallExpr* getIter = toCallExpr(move->get(2));
+
+    if (getIter == NULL || getIter->isNamed("_getIterator") == false ||
+        getIter->numActuals() != 1)
+      return false;
+
+    CallExpr* iter = toCallExpr(getIter->get(1));
+
+    if (iter == NULL ||
+        (iter->isNamed("chpl_direct_range_iter")         == false &&
+         iter->isNamed("chpl_direct_counted_range_iter") == false))
+      return false;
+
+    if (requireSimpleBounds) {
+      for_actuals(actual, iter) {
+        if (isSymExpr(actual) == false)
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+
+/************************************* | **************************************
+*                                                                             *
+* Fusing adjacent on statements                                               *
+*                                                                             *
+************************************** | *************************************/
+
+// Can the value of 'sym' be relied on not to change while an on statement
+// runs?  This is conservative: mutable variables are rejected even if the
+// body does not touch them, since they could be modified through an alias.
+static bool isInvariantSymbol(Symbol* sym) {
+  VarSymbol* var = toVarSymbol(sym);
+
+  if (var == NULL)
+    return false;
+
+  if (var->immediate != NULL || var->isParameter())
+    return true;
+
+  if (var->hasFlag(FLAG_CONST)) {
+    // A const ref may refer to something that changes, unless it comes
+    // from the library (e.g. 'Locales').
+    if (var->hasFlag(FLAG_REF_VAR))
+      return var->getModule()->modTag != MOD_USER;
+
+    return true;
+  }
+
+  if (var->hasFlag(FLAG_INDEX_VAR))
+    if (ForLoop* loop = toForLoop(var->defPoint->parentExpr))
+      return isDirectRangeLoop(loop, false);
+
+  return false;
+}
+
+// Targets are limited to expressions that evaluate to the same locale each
+// time and have no side effects: invariant symbols, 'x.locale', indexing
+// into an invariant array (e.g. 'Locales[i]') and locale numbers.
+static bool isInvariantTarget(Expr* expr) {
+  if (SymExpr* se = toSymExpr(expr))
+    return isInvariantSymbol(se->symbol());
+
+  CallExpr* call = toCallExpr(expr);
+
+  if (call == NULL)
+    return false;
+
+  if (call->isPrimitive(PRIM_ON_LOCALE_NUM) == false) {
+    if (call->isNamed(".")) {
+      SymExpr* member = toSymExpr(call->get(2));
+      VarSymbol* name = member ? toVarSymbol(member->symbol()) : NULL;
+
+      if (name == NULL || name->immediate == NULL ||
+          strcmp(name->immediate->v_string, "locale") != 0)
+        return false;
+
+      return isInvariantTarget(call->get(1));
+
+    } else if (SymExpr* base = toSymExpr(call->baseExpr)) {
+      if (isInvariantSymbol(base->symbol()) == false)
+        return false;
+
+    } else {
+      return false;
+    }
+  }
+
+  for_actuals(actual, call) {
+    if (isInvariantTarget(actual) == false)
+      return false;
+  }
+
+  return true;
+}
+
+static bool sameTarget(Expr* a, Expr* b) {
+  if (SymExpr* seA = toSymExpr(a)) {
+    SymExpr* seB = toSymExpr(b);
+
+    return seB != NULL && seA->symbol() == seB->symbol();
+
+  } else if (UnresolvedSymExpr* useA = toUnresolvedSymExpr(a)) {
+    UnresolvedSymExpr* useB = toUnresolvedSymExpr(b);
+
+    return useB != NULL && strcmp(useA->unresolved, useB->unresolved) == 0;
+
+  } else if (CallExpr* callA = toCallExpr(a)) {
+    CallExpr* callB = toCallExpr(b);
+
+    if (callB == NULL ||
+        callA->primitive != callB->primitive ||
+        callA->numActuals() != callB->numActuals())
+      return false;
+
+    if ((callA->baseExpr == NULL) != (callB->baseExpr == NULL))
+      return false;
+
+    if (callA->baseExpr && !sameTarget(callA->baseExpr, callB->baseExpr))
+      return false;
+
+    for (int i = 1; i <= callA->numActuals(); i++) {
+      if (sameTarget(callA->get(i), callB->get(i)) == false)
+        return false;
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+//
+//   on x { a(); }          on x {
+//   on x { b(); }    =>      { a(); }
+//                            { b(); }
+//                          }
+//
+static bool fuseWithNextOnStmt(const OnStmtParts& parts) {
+  Expr*       next   = nextStmt(parts.onBlock);
+  OnStmtParts nextParts;
+
+  if (next == NULL || getOnStmtParts(next, nextParts) == false)
+    return false;
+
+  Expr* target     = getOnTarget(parts);
+  Expr* nextTarget = getOnTarget(nextParts);
+
+  if (target     == NULL || isInvariantTarget(target) == false ||
+      nextTarget == NULL || sameTarget(target, nextTarget) == false)
+    return false;
+
+  for_alist(stmt, nextParts.onBlock->body) {
+    parts.onBlock->insertAtTail(stmt->remove());
+  }
+
+  nextParts.tmpDef->remove();
+  nextParts.tmpMove->remove();
+  nextParts.onBlock->remove();
+
+  return true;
+}
+
+
+/************************************* | **************************************
+*                                                                             *
+* Hoisting on statements out of loops                                         *
+*                                                                             *
+************************************** | *************************************/
+
+// The statements that destructureIndices() puts at the head of a loop body,
+// plus the continue label at its tail.
+static bool isIndexSetupStmt(ForLoop* loop, Expr* stmt) {
+  if (DefExpr* def = toDefExpr(stmt))
+    return def->sym->hasFlag(FLAG_INDEX_VAR) ||
+           def->sym == loop->continueLabelGet();
+
+  if (CallExpr* call = toCallExpr(stmt)) {
+    if (call->isPrimitive(PRIM_MOVE))
+      if (SymExpr* lhs = toSymExpr(call->get(1)))
+        return lhs->symbol()->hasFlag(FLAG_INDEX_VAR);
+
+    return call->isNamed("_check_tuple_var_decl");
+  }
+
+  return false;
+}
+
+static bool findOnStmtThatIsLoopBody(ForLoop* loop, OnStmtParts& parts) {
+  BlockStmt* userBlock = NULL;
+
+  // 'for ... { on x ... }' leaves the on statement in a nested block,
+  // 'for ... do on x ...' leaves it directly in the loop body.
+  for_alist(stmt, loop->body) {
+    if (isEndOfStatementMarker(stmt) || isIndexSetupStmt(loop, stmt))
+      continue;
+
+    BlockStmt* block = toBlockStmt(stmt);
+
+    if (userBlock == NULL && block != NULL && block->isRealBlockStmt() &&
+        block->isLoopStmt() == false && block->blockTag == BLOCK_NORMAL) {
+      userBlock = block;
+    } else {
+      userBlock = loop;
+      break;
+    }
+  }
+
+  if (userBlock == NULL)
+    return false;
+
+  int numStmts = 0;
+
+  for_alist(stmt, userBlock->body) {
+    if (isEndOfStatementMarker(stmt))
+      continue;
+
+    if (userBlock == loop && isIndexSetupStmt(loop, stmt))
+      continue;
+
+    if (numStmts == 0 && getOnStmtParts(stmt, parts) == false)
+      return false;
+
+    numStmts++;
+  }
+
+  return numStmts == 3;
+}
+
+//
+//   for i in 1..n {          on x {
+//     on x {                   for i in 1..n {
+//       a(i);          =>        { a(i); }
+//     }                        }
+//   }                        }
+//
+// This trades one remote fork per iteration for a single one.  If the loop
+// does not execute at all, a fork that did not happen before is performed,
+// which is why the target must be a plain variable that cannot fail to
+// evaluate.
+static bool hoistOnStmtOutOfLoop(ForLoop* loop) {
+  OnStmtParts parts;
+
+  if (isDirectRangeLoop(loop, true) == false ||
+      findOnStmtThatIsLoopBody(loop, parts) == false)
+    return false;
+
+  // The block that doBuildForLoop() wraps the loop and its iterator in
+  BlockStmt* loopBlock = toBlockStmt(loop->parentExpr);
+  SymExpr*   target    = toSymExpr(getOnTarget(parts));
+
+  if (loopBlock == NULL || loopBlock->isRealBlockStmt() == false ||
+      loopBlock->list == NULL || target == NULL ||
+      isInvariantSymbol(target->symbol()) == false ||
+      loopBlock->contains(target->symbol()->defPoint))
+    return false;
+
+  for_alist(stmt, parts.onBlock->body) {
+    parts.onBlock->insertBefore(stmt->remove());
+  }
+
+  parts.tmpDef->remove();
+  parts.tmpMove->remove();
+  parts.onBlock->remove();
+
+  loopBlock->insertBefore(parts.tmpDef);
+  loopBlock->insertBefore(parts.tmpMove);
+  loopBlock->insertBefore(parts.onBlock);
+
+  parts.onBlock->insertAtTail(loopBlock->remove());
+
+  return true;
+}
+
+
+/************************************* | **************************************
+*                                                                             *
+* Making on statements at the end of a begin non-blocking                     *
+*                                                                             *
+************************************** | *************************************/
+
+// Module-level declarations are still in the module's init function at
+// this point, see moveGlobalDeclarationsToModuleScope().
+static bool isGlobalSymbol(Symbol* sym) {
+  if (isModuleSymbol(sym->defPoint->parentSymbol))
+    return true;
+
+  FnSymbol* fn = toFnSymbol(sym->defPoint->parentSymbol);
+
+  return fn != NULL                            &&
+         fn == fn->getModule()->initFn         &&
+         sym->defPoint->parentExpr == fn->body &&
+         sym->hasFlag(FLAG_TEMP) == false;
+}
+
+// The on statement will outlive the begin task, so it may only refer to
+// its own symbols and to globals.  The target in its blockInfo is
+// evaluated before the on statement is launched, so it is not checked.
+static bool isSafeForNonBlockingOn(BlockStmt* onBlock) {
+  std::vector<SymExpr*> symExprs;
+
+  for_alist(stmt, onBlock->body) {
+    collectSymExprs(stmt, symExprs);
+  }
+
+  for_vector(SymExpr, se, symExprs) {
+    Symbol* sym = se->symbol();
+
+    if (isFnSymbol(sym) || isTypeSymbol(sym) || isLabelSymbol(sym))
+      continue;
+
+    if (VarSymbol* var = toVarSymbol(sym))
+      if (var->immediate != NULL || var->isParameter())
+        continue;
+
+    if (isGlobalSymbol(sym) || onBlock->contains(sym->defPoint))
+      continue;
+
+    return false;
+  }
+
+  return true;
+}
+
+//
+//   begin {                  begin {
+//     a();                     a();
+//     on x { b(); }    =>      begin on x { b(); }
+//   }                        }
+//
+// Both forms are waited for by the same enclosing sync, but the begin task
+// is released as soon as it has launched the on statement.  This extends
+// what buildBeginStmt() does for 'begin on x' to begins with other
+// statements before the on.
+static bool makeTrailingOnStmtNonBlocking(BlockStmt* beginBlock) {
+  if (beginBlock->byrefVars != NULL)
+    return false;
+
+  // The user's block followed by the call to _downEndCount()
+  BlockStmt* userBlock = toBlockStmt(beginBlock->body.head);
+  CallExpr*  downCall  = toCallExpr(lastStmt(beginBlock));
+
+  if (userBlock == NULL || userBlock->isRealBlockStmt() == false ||
+      downCall == NULL || downCall->isNamed("_downEndCount") == false ||
+      nextStmt(userBlock) != downCall)
+    return false;
+
+  OnStmtParts parts;
+  Expr*       last = lastStmt(userBlock);
+
+  if (last == NULL || getOnStmtParts(last, parts) == false ||
+      isSafeForNonBlockingOn(parts.onBlock) == false)
+    return false;
+
+  SET_LINENO(parts.onBlock);
+
+  parts.tmpDef->insertBefore(new CallExpr("_upDynamicEndCount", gFalse));
+  parts.onBlock->insertAtTail(new CallExpr("_downDynamicEndCount", gNil));
+  parts.onBlock->blockInfoGet()->primitive = primitives[PRIM_BLOCK_BEGIN_ON];
+
+  return true;
+}
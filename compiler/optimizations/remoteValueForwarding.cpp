@@ -21,6 +21,7 @@
 #include "optimizations.h"
 
 #include "astutil.h"
+#include "DecoratedClassType.h"
 #include "driver.h"
 #include "expr.h"
 #include "resolution.h"
@@ -28,6 +29,9 @@
 #include "stmt.h"
 #include "stringutil.h"
 
+#include <map>
+#include <set>
+
 //#define DEBUG_SYNC_ACCESS_FUNCTION_SET
 
 static void updateLoopBodyClasses(Map<Symbol*, Vec<SymExpr*>*>& defMap,
@@ -43,6 +47,8 @@ static bool isSafeToDeref(Map<Symbol*, Vec<SymExpr*>*>& defMap,
                           Symbol*                       field,
                           Symbol*                       ref);
 
+static void forwardImmutableFields();
+
 class DotInfo {
   public:
     bool finalized;
@@ -81,6 +87,9 @@ void remoteValueForwarding() {
     updateLoopBodyClasses(defMap, useMap);
     updateTaskFunctions(defMap, useMap);
 
+    if (fRemoteFieldForwarding)
+      forwardImmutableFields();
+
     freeDefUseMaps(defMap, useMap);
 
     for (DotInfoIter it = dotLocaleMap.begin(); it != dotLocaleMap.end(); ++it) {
@@ -708,6 +717,345 @@ static void defaultForwarding(Map<Symbol*, Vec<SymExpr*>*>& useMap,
   }
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Forward immutable fields of class arguments to on-statement functions.      *
+*                                                                             *
+* An on body that reads fields of an object on another locale does a GET for  *
+* each of them.  If a field cannot change once the object is initialized, it  *
+* can be read at the call site instead and shipped with the other arguments:  *
+*                                                                             *
+*   call on_fn(tmp, obj);                 obj_dom = obj.dom;                  *
+*                                         call on_fn(tmp, obj, obj_dom);      *
+*   function on_fn(loc, obj) {      =>                                        *
+*     x = obj.dom;                        function on_fn(loc, obj, obj_dom) { *
+*   }                                       x = obj_dom;                      *
+*                                         }                                   *
+*                                                                             *
+* This runs before inlining, so most reads are still calls to the field's     *
+* accessor rather than PRIM_GET_MEMBER_VALUE.                                 *
+*                                                                             *
+************************************** | *************************************/
+
+// The reads of one field of an on-statement argument
+struct FieldReads {
+  std::vector<Expr*>     loads;     // replaced by the forwarded value
+  std::vector<CallExpr*> refMoves;  // accessor refs, removed afterwards
+};
+
+static Symbol* accessedField(FnSymbol* accessor);
+
+static bool accessorRead(CallExpr* call, SymExpr* se, FieldReads& reads);
+
+static bool isReadOnlyAccessor(FnSymbol* accessor);
+
+static bool isImmutableField(Symbol* field);
+
+static void collectSymbolOrigins(Symbol*            sym,
+                                 bool               throughCalls,
+                                 std::set<Symbol*>& origins);
+
+static bool isOnTargetObject(FnSymbol* fn, ArgSymbol* arg);
+
+static void forwardField(FnSymbol*   fn,
+                         ArgSymbol*  arg,
+                         Symbol*     field,
+                         FieldReads& reads);
+
+static void forwardImmutableFields() {
+  std::map<Symbol*, bool> immutableFields;
+
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (fn->hasFlag(FLAG_ON) == false || fn->inTree() == false)
+      continue;
+
+    for_formals(arg, fn) {
+      // A nilable object might not be read by the on body at all.
+      if (arg->isRef() || isNonNilableClassType(arg->type) == false ||
+          arg->hasFlag(FLAG_NO_RVF))
+        continue;
+
+      // Direct reads of fields of 'arg', grouped by field
+      std::map<Symbol*, FieldReads> reads;
+
+      for_SymbolSymExprs(se, arg) {
+        CallExpr* call = toCallExpr(se->parentExpr);
+
+        if (call == NULL)
+          continue;
+
+        if (call->isPrimitive(PRIM_GET_MEMBER_VALUE) && call->get(1) == se) {
+          reads[toSymExpr(call->get(2))->symbol()].loads.push_back(call);
+
+        } else if (Symbol* field = accessedField(call->resolvedFunction())) {
+          if (actual_to_formal(se) == call->resolvedFunction()->_this)
+            accessorRead(call, se, reads[field]);
+        }
+      }
+
+      if (reads.empty() || isOnTargetObject(fn, arg))
+        continue;
+
+      for (std::map<Symbol*, FieldReads>::iterator
+             it = reads.begin(); it != reads.end(); ++it) {
+        if (it->second.loads.empty())
+          continue;
+
+        Symbol* field = it->first;
+
+        if (immutableFields.count(field) == 0)
+          immutableFields[field] = isImmutableField(field);
+
+        if (immutableFields[field])
+          forwardField(fn, arg, field, it->second);
+      }
+    }
+  }
+}
+
+//
+// Returns the field that 'accessor' gives access to, or NULL if it is not
+// a field accessor.
+//
+static Symbol* accessedField(FnSymbol* accessor) {
+  if (accessor == NULL || accessor->hasFlag(FLAG_FIELD_ACCESSOR) == false)
+    return NULL;
+
+  std::vector<CallExpr*> calls;
+
+  collectCallExprs(accessor->body, calls);
+
+  for_vector(CallExpr, call, calls) {
+    if (call->isPrimitive(PRIM_GET_MEMBER) ||
+        call->isPrimitive(PRIM_GET_MEMBER_VALUE)) {
+      SymExpr* base = toSymExpr(call->get(1));
+
+      if (base != NULL && base->symbol() == accessor->_this)
+        return toSymExpr(call->get(2))->symbol();
+    }
+  }
+
+  return NULL;
+}
+
+//
+// A call to a field accessor on the object in 'se' reads the field if its
+// result is only ever loaded from.  If so, adds the loads to 'reads'.
+//
+static bool accessorRead(CallExpr* call, SymExpr* se, FieldReads& reads) {
+  CallExpr* move = toCallExpr(call->parentExpr);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+    return false;
+
+  Symbol* lhs = toSymExpr(move->get(1))->symbol();
+
+  if (lhs->isRef() == false) {
+    reads.loads.push_back(call);
+    return true;
+  }
+
+  if (isVarSymbol(lhs) == false || lhs->getSingleDef() == NULL)
+    return false;
+
+  std::vector<Expr*> loads;
+
+  for_SymbolSymExprs(use, lhs) {
+    CallExpr* parent = toCallExpr(use->parentExpr);
+
+    if (use == move->get(1))
+      continue;
+
+    if (parent == NULL)
+      return false;
+
+    if (parent->isPrimitive(PRIM_DEREF)) {
+      loads.push_back(parent);
+
+    } else if (isMoveOrAssign(parent) && use == parent->get(2) &&
+               toSymExpr(parent->get(1))->symbol()->isRef() == false) {
+      loads.push_back(use);
+
+    } else if (parent->resolvedFunction() != NULL &&
+               actual_to_formal(use)->isRef() == false) {
+      loads.push_back(use);
+
+    } else {
+      return false;
+    }
+  }
+
+  reads.loads.insert(reads.loads.end(), loads.begin(), loads.end());
+  reads.refMoves.push_back(move);
+
+  return true;
+}
+
+//
+// An accessor that returns a const ref, or a ref that is only used by
+// initializers, does not let the field change.
+//
+static bool isReadOnlyAccessor(FnSymbol* accessor) {
+  if (accessor->retTag != RET_REF)
+    return true;
+
+  forv_Vec(CallExpr, call, *accessor->calledBy) {
+    // Reads already forwarded elsewhere
+    if (call->inTree() == false)
+      continue;
+
+    FnSymbol* caller = call->getFunction();
+
+    if (caller->isInitializer() == false &&
+        caller->isPostInitializer() == false)
+      return false;
+  }
+
+  return true;
+}
+
+//
+// A field is immutable if it is only ever written, or has its address
+// taken, by initializers and read-only accessors.  Only scalars and class pointers are forwarded,
+// so that no copy or deinit is needed for the forwarded value.
+//
+static bool isImmutableField(Symbol* field) {
+  Type* type = field->type;
+
+  if (field->isRef() || field->hasFlag(FLAG_SUPER_CLASS) ||
+      (isPrimitiveScalar(type) == false && isClassLikeOrPtr(type) == false))
+    return false;
+
+  for_SymbolSymExprs(se, field) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL || call->get(2) != se)
+      return false;
+
+    if (call->isPrimitive(PRIM_GET_MEMBER_VALUE))
+      continue;
+
+    if (call->isPrimitive(PRIM_SET_MEMBER) ||
+        call->isPrimitive(PRIM_GET_MEMBER)) {
+      FnSymbol* fn = call->getFunction();
+
+      if (fn->isInitializer() || fn->isPostInitializer())
+        continue;
+
+      if (call->isPrimitive(PRIM_GET_MEMBER) &&
+          fn->hasFlag(FLAG_FIELD_ACCESSOR) && isReadOnlyAccessor(fn))
+        continue;
+    }
+
+    return false;
+  }
+
+  return true;
+}
+
+//
+// Collect 'sym' and the symbols its value was computed from within the
+// function that defines it.  Unless 'throughCalls' is set, only plain
+// copies and (de)references are followed.
+//
+static void collectSymbolOrigins(Symbol*            sym,
+                                 bool               throughCalls,
+                                 std::set<Symbol*>& origins) {
+  if (origins.insert(sym).second == false || isVarSymbol(sym) == false)
+    return;
+
+  for_SymbolSymExprs(se, sym) {
+    CallExpr* move = toCallExpr(se->parentExpr);
+
+    if (move == NULL || isMoveOrAssign(move) == false || move->get(1) != se)
+      continue;
+
+    Expr* rhs = move->get(2);
+
+    if (CallExpr* call = toCallExpr(rhs)) {
+      if (call->isPrimitive(PRIM_DEREF)         ||
+          call->isPrimitive(PRIM_ADDR_OF)       ||
+          call->isPrimitive(PRIM_SET_REFERENCE) ||
+          throughCalls) {
+        std::vector<SymExpr*> symExprs;
+
+        collectSymExprs(call, symExprs);
+
+        for_vector(SymExpr, rhsSe, symExprs) {
+          collectSymbolOrigins(rhsSe->symbol(), throughCalls, origins);
+        }
+      }
+
+    } else if (SymExpr* rhsSe = toSymExpr(rhs)) {
+      collectSymbolOrigins(rhsSe->symbol(), throughCalls, origins);
+    }
+  }
+}
+
+//
+// For 'on obj', the fields of 'obj' are local to the on body; reading them
+// at the call site would add communication rather than remove it.
+//
+static bool isOnTargetObject(FnSymbol* fn, ArgSymbol* arg) {
+  forv_Vec(CallExpr, call, *fn->calledBy) {
+    SymExpr* localeSe = toSymExpr(call->get(1));
+    SymExpr* actual   = toSymExpr(formal_to_actual(call, arg));
+
+    if (localeSe == NULL || actual == NULL || actual->isRef())
+      return true;
+
+    std::set<Symbol*> targetOrigins;
+    std::set<Symbol*> actualOrigins;
+
+    collectSymbolOrigins(localeSe->symbol(), true,  targetOrigins);
+    collectSymbolOrigins(actual->symbol(),   false, actualOrigins);
+
+    for_set(Symbol, sym, actualOrigins) {
+      if (targetOrigins.count(sym) != 0)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+static void forwardField(FnSymbol*   fn,
+                         ArgSymbol*  arg,
+                         Symbol*     field,
+                         FieldReads& reads) {
+  SET_LINENO(arg);
+
+  const char* name     = astr(arg->name, "_", field->name);
+  ArgSymbol*  fieldArg = new ArgSymbol(INTENT_CONST_IN, name, field->type);
+
+  forv_Vec(CallExpr, call, *fn->calledBy) {
+    SymExpr*   actual = toSymExpr(formal_to_actual(call, arg));
+    VarSymbol* tmp    = newTemp(name, field->type);
+
+    SET_LINENO(call);
+
+    call->insertBefore(new DefExpr(tmp));
+    call->insertBefore(new CallExpr(PRIM_MOVE, tmp,
+                                    new CallExpr(PRIM_GET_MEMBER_VALUE,
+                                                 actual->symbol(), field)));
+
+    call->insertAtTail(tmp);
+  }
+
+  fn->insertFormalAtTail(new DefExpr(fieldArg));
+
+  for_vector(Expr, load, reads.loads) {
+    load->replace(new SymExpr(fieldArg));
+  }
+
+  for_vector(CallExpr, move, reads.refMoves) {
+    Symbol* ref = toSymExpr(move->get(1))->symbol();
+
+    move->remove();
+    ref->defPoint->remove();
+  }
+}
+
 static bool isSyncSingleMethod(FnSymbol* fn) {
 
   bool retval = false;
@@ -567,6 +567,10 @@ debugScalarReplacementFailure(Symbol* var) {
 
 void
 scalarReplace() {
+  if (fStackAllocateClasses) {
+    stackAllocateClasses();
+  }
+
   if (!fNoScalarReplacement) {
 
     //
@@ -0,0 +1,568 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// stackAllocateClasses
+//
+// Allocate class instances that never escape the function creating them
+// in that function's stack frame instead of on the heap.
+//
+// A candidate is the result of a call to a _new wrapper
+//
+//   move(call_tmp, _new(C, args...))
+//
+// The instance escapes if a reference to it (or to one of its fields) is
+// returned, yielded, stored into memory other than a local variable, passed
+// to an extern or task function or through a virtual call, or passed to a
+// formal that itself lets it escape.  That includes the 'this' formals of
+// the init and postinit called by the _new wrapper.  Formals are analyzed
+// on demand and the results are cached.
+//
+// Only 'new' of unmanaged and borrowed classes is handled.  For owned and
+// shared, the instance is stored into the managing record, whose deinit
+// frees it, so it always escapes here.
+//
+// A non-escaping instance is created by inlining its _new wrapper with the
+// heap allocation replaced by PRIM_STACK_ALLOCATE_CLASS, and each
+// 'delete' of it is reduced to a call to its deinitializer.
+//
+// The pass runs as part of scalarReplace, after inlining has exposed the
+// field accesses of small methods, and is enabled with
+// --stack-allocate-classes.
+//
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "passes.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+// Functions are not analyzed deeper than this along a call chain
+static const int maxEscapeDepth = 8;
+
+// Instances with more scalar fields than this stay on the heap
+static const int maxStackFields = 1024;
+
+static std::map<ArgSymbol*, bool> formalEscapesCache;
+static std::set<ArgSymbol*>       formalsInProgress;
+static std::set<Symbol*>          symbolsInProgress;
+
+static bool isLocalVar(Symbol* sym, FnSymbol* fn);
+static bool usesEscape(Symbol* sym, FnSymbol* fn, int depth,
+                       std::vector<Symbol*>* aliases,
+                       std::vector<CallExpr*>* deletes);
+static bool symbolEscapes(Symbol* sym, FnSymbol* fn, int depth,
+                          std::vector<Symbol*>* aliases,
+                          std::vector<CallExpr*>* deletes);
+static bool formalEscapes(ArgSymbol* formal, FnSymbol* fn, int depth);
+static bool newWrapperEscapes(Symbol* initTemp, FnSymbol* newFn);
+static bool isDeleteCall(CallExpr* call);
+static int countScalarFields(AggregateType* at, int limit);
+static CallExpr* findStackableAllocation(BlockStmt* body);
+static bool isWithin(Expr* expr, Expr* container);
+static BlockStmt* innermostLoop(Expr* expr);
+static bool stackAllocateInstance(CallExpr* move);
+
+/************************************* | **************************************
+*                                                                             *
+* Escape analysis                                                             *
+*                                                                             *
+************************************** | *************************************/
+
+static bool isLocalVar(Symbol* sym, FnSymbol* fn) {
+  return isVarSymbol(sym) &&
+         sym->defPoint != NULL &&
+         sym->defPoint->parentSymbol == fn &&
+         sym->hasFlag(FLAG_EXTERN) == false;
+}
+
+//
+// Returns true if the value of 'sym' in 'fn' can outlive 'fn'.  'sym' is
+// either a pointer to the instance or a reference to one of its fields;
+// loads through a field reference do not propagate the instance.
+//
+// When 'aliases' is not NULL, the local variables that receive a copy of
+// the pointer are collected; each must have a single definition.  When
+// 'deletes' is not NULL, calls that delete the instance are collected
+// instead of being treated as escapes.
+//
+static bool symbolEscapes(Symbol* sym, FnSymbol* fn, int depth,
+                          std::vector<Symbol*>* aliases,
+                          std::vector<CallExpr*>* deletes) {
+  // Variables copied into each other in a loop are analyzed once
+  if (symbolsInProgress.count(sym) != 0)
+    return false;
+
+  symbolsInProgress.insert(sym);
+
+  bool retval = usesEscape(sym, fn, depth, aliases, deletes);
+
+  symbolsInProgress.erase(sym);
+
+  return retval;
+}
+
+static bool usesEscape(Symbol* sym, FnSymbol* fn, int depth,
+                       std::vector<Symbol*>* aliases,
+                       std::vector<CallExpr*>* deletes) {
+  bool isFieldRef = sym->isRef();
+
+  for_SymbolSymExprs(se, sym) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL)
+      return true;
+
+    if (call->isPrimitive(PRIM_MOVE) || call->isPrimitive(PRIM_ASSIGN)) {
+      if (se == call->get(1)) {
+        // A store through a field reference, or a (re)definition of sym
+        continue;
+      }
+
+      Symbol* lhs = toSymExpr(call->get(1))->symbol();
+
+      if (isFieldRef == true && lhs->isRef() == false)
+        continue;                       // a load of the field's value
+
+      if (isLocalVar(lhs, fn) == false || lhs->isRef() != isFieldRef)
+        return true;
+
+      if (aliases != NULL) {
+        if (lhs->getSingleDef() == NULL)
+          return true;
+
+        aliases->push_back(lhs);
+      }
+
+      if (symbolEscapes(lhs, fn, depth, aliases, deletes))
+        return true;
+
+    } else if (call->isPrimitive(PRIM_GET_MEMBER_VALUE) ||
+               call->isPrimitive(PRIM_SET_MEMBER)) {
+      // Only as the object being accessed, not as the value being stored
+      if (se != call->get(1) || isFieldRef)
+        return true;
+
+    } else if (call->isPrimitive(PRIM_GET_MEMBER)) {
+      CallExpr* parent = toCallExpr(call->parentExpr);
+
+      if (se != call->get(1) || isFieldRef ||
+          parent == NULL || parent->isPrimitive(PRIM_MOVE) == false)
+        return true;
+
+      Symbol* ref = toSymExpr(parent->get(1))->symbol();
+
+      if (isLocalVar(ref, fn) == false || ref->isRef() == false)
+        return true;
+
+      if (symbolEscapes(ref, fn, depth, NULL, NULL))
+        return true;
+
+    } else if (call->isPrimitive(PRIM_DEREF)) {
+      if (isFieldRef == false)
+        return true;
+
+    } else if (call->isPrimitive(PRIM_GETCID) ||
+               call->isPrimitive(PRIM_TESTCID) ||
+               call->isPrimitive(PRIM_CHECK_NIL) ||
+               call->isPrimitive(PRIM_PTR_EQUAL) ||
+               call->isPrimitive(PRIM_PTR_NOTEQUAL) ||
+               call->isPrimitive(PRIM_WIDE_GET_LOCALE) ||
+               call->isPrimitive(PRIM_WIDE_GET_NODE)) {
+      continue;
+
+    } else if (call->isPrimitive(PRIM_CAST) ||
+               call->isPrimitive(PRIM_DYNAMIC_CAST)) {
+      // An upcast or downcast yields another pointer to the instance
+      CallExpr* parent = toCallExpr(call->parentExpr);
+
+      if (se != call->get(2) || isFieldRef ||
+          isClass(call->typeInfo()) == false ||
+          parent == NULL || parent->isPrimitive(PRIM_MOVE) == false)
+        return true;
+
+      Symbol* lhs = toSymExpr(parent->get(1))->symbol();
+
+      if (isLocalVar(lhs, fn) == false || lhs->isRef())
+        return true;
+
+      if (aliases != NULL) {
+        if (lhs->getSingleDef() == NULL)
+          return true;
+
+        aliases->push_back(lhs);
+      }
+
+      if (symbolEscapes(lhs, fn, depth, aliases, deletes))
+        return true;
+
+    } else if (FnSymbol* callee = call->resolvedFunction()) {
+      if (deletes != NULL && isDeleteCall(call)) {
+        deletes->push_back(call);
+        continue;
+      }
+
+      ArgSymbol* formal = actual_to_formal(se);
+
+      // A pointer passed to a ref formal could be rebound by the callee
+      if (formal->isRef() != isFieldRef) {
+        if (isFieldRef == true)
+          continue;                     // passed by value
+
+        return true;
+      }
+
+      if (formalEscapes(formal, callee, depth + 1))
+        return true;
+
+    } else {
+      // Returns, yields, virtual calls, and anything else not understood
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool formalEscapes(ArgSymbol* formal, FnSymbol* fn, int depth) {
+  std::map<ArgSymbol*, bool>::iterator it = formalEscapesCache.find(formal);
+
+  if (it != formalEscapesCache.end())
+    return it->second;
+
+  // Recursive calls are assumed to let the instance escape
+  if (depth > maxEscapeDepth || formalsInProgress.count(formal) != 0)
+    return true;
+
+  if (fn->hasFlag(FLAG_EXTERN) ||
+      fn->hasFlag(FLAG_BEGIN)  ||
+      fn->hasFlag(FLAG_ON)     ||
+      fn->hasFlag(FLAG_COBEGIN_OR_COFORALL)) {
+    formalEscapesCache[formal] = true;
+    return true;
+  }
+
+  formalsInProgress.insert(formal);
+
+  bool retval = symbolEscapes(formal, fn, depth, NULL, NULL);
+
+  formalsInProgress.erase(formal);
+
+  // Results that depend on an in-progress formal are not cached
+  if (formalsInProgress.empty() || retval == false)
+    formalEscapesCache[formal] = retval;
+
+  return retval;
+}
+
+//
+// Returns true if the _new wrapper 'newFn' lets the instance in 'initTemp'
+// escape other than through its return value, e.g. through an init or
+// postinit that registers 'this' somewhere.
+//
+static bool newWrapperEscapes(Symbol* initTemp, FnSymbol* newFn) {
+  Symbol* ret = newFn->getReturnSymbol();
+
+  for_SymbolSymExprs(se, initTemp) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL)
+      return true;
+
+    if (call->isPrimitive(PRIM_MOVE)) {
+      // The allocation, or the result
+      if (se == call->get(1) || toSymExpr(call->get(1))->symbol() == ret)
+        continue;
+
+      return true;
+
+    } else if (call->isPrimitive(PRIM_CAST)) {
+      CallExpr* parent = toCallExpr(call->parentExpr);
+
+      if (se == call->get(2) &&
+          parent != NULL && parent->isPrimitive(PRIM_MOVE) &&
+          toSymExpr(parent->get(1))->symbol() == ret)
+        continue;
+
+      return true;
+
+    } else if (call->isPrimitive(PRIM_SETCID) ||
+               call->isPrimitive(PRIM_RETURN)) {
+      continue;
+
+    } else if (FnSymbol* callee = call->resolvedFunction()) {
+      ArgSymbol* formal = actual_to_formal(se);
+
+      if (formal->isRef() || formalEscapes(formal, callee, 1))
+        return true;
+
+    } else {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// 'delete x' resolves to the single-argument overload of chpl__delete
+static bool isDeleteCall(CallExpr* call) {
+  FnSymbol* fn = call->resolvedFunction();
+
+  return fn != NULL &&
+         fn->name == astr("chpl__delete") &&
+         fn->numFormals() == 1;
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Stack allocation                                                            *
+*                                                                             *
+************************************** | *************************************/
+
+// Returns the number of scalar fields in 'at', or 'limit' + 1 if there are
+// more than that.  Class fields count as one scalar.
+static int countScalarFields(AggregateType* at, int limit) {
+  int count = 0;
+
+  for_fields(field, at) {
+    AggregateType* fat = toAggregateType(field->type);
+
+    if (fat != NULL && isClass(fat) == false)
+      count += countScalarFields(fat, limit - count);
+    else
+      count += 1;
+
+    if (count > limit)
+      return limit + 1;
+  }
+
+  return count;
+}
+
+//
+// The _new wrapper for a class allocates its result with
+//
+//   move(cast_tmp, chpl_here_alloc(size, md))
+//   move(initTemp, cast(C, cast_tmp))
+//
+// Returns the cast, or NULL if 'body' does not have that shape.
+//
+static CallExpr* findStackableAllocation(BlockStmt* body) {
+  for_alist(stmt, body->body) {
+    CallExpr* move = toCallExpr(stmt);
+
+    if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+      continue;
+
+    CallExpr* alloc = toCallExpr(move->get(2));
+
+    if (alloc == NULL ||
+        alloc->isResolved() == false ||
+        alloc->resolvedFunction()->hasFlag(FLAG_ALLOCATOR) == false)
+      continue;
+
+    CallExpr* castMove = toCallExpr(move->next);
+
+    if (castMove == NULL || castMove->isPrimitive(PRIM_MOVE) == false)
+      return NULL;
+
+    CallExpr* cast = toCallExpr(castMove->get(2));
+
+    if (cast == NULL || cast->isPrimitive(PRIM_CAST) == false)
+      return NULL;
+
+    SymExpr* castArg  = toSymExpr(cast->get(2));
+    Symbol*  allocTmp = toSymExpr(move->get(1))->symbol();
+
+    if (castArg == NULL || castArg->symbol() != allocTmp)
+      return NULL;
+
+    // The allocation must be the only use of the temp
+    if (allocTmp->getSingleUse() != castArg)
+      return NULL;
+
+    return cast;
+  }
+
+  return NULL;
+}
+
+static bool isWithin(Expr* expr, Expr* container) {
+  for (Expr* e = expr; e != NULL; e = e->parentExpr) {
+    if (e == container)
+      return true;
+  }
+
+  return false;
+}
+
+static BlockStmt* innermostLoop(Expr* expr) {
+  for (Expr* e = expr->parentExpr; e != NULL; e = e->parentExpr) {
+    BlockStmt* block = toBlockStmt(e);
+
+    if (block != NULL && block->isLoopStmt())
+      return block;
+  }
+
+  return NULL;
+}
+
+static bool stackAllocateInstance(CallExpr* move) {
+  FnSymbol*      fn      = toFnSymbol(move->parentSymbol);
+  CallExpr*      newCall = toCallExpr(move->get(2));
+  FnSymbol*      newFn   = newCall->resolvedFunction();
+  AggregateType* ct      = toAggregateType(newFn->retType);
+  Symbol*        sym     = toSymExpr(move->get(1))->symbol();
+
+  if (ct == NULL || isClass(ct) == false ||
+      isLocalVar(sym, fn) == false || sym->getSingleDef() == NULL)
+    return false;
+
+  if (countScalarFields(ct, maxStackFields) > maxStackFields)
+    return false;
+
+  CallExpr* alloc = findStackableAllocation(newFn->body);
+
+  if (alloc == NULL)
+    return false;
+
+  Symbol* initTemp = toSymExpr(toCallExpr(alloc->parentExpr)->get(1))->symbol();
+
+  if (newWrapperEscapes(initTemp, newFn))
+    return false;
+
+  std::vector<Symbol*>   aliases;
+  std::vector<CallExpr*> deletes;
+
+  if (symbolEscapes(sym, fn, 0, &aliases, &deletes))
+    return false;
+
+  //
+  // The stack slot is reused each time the allocation executes, so when
+  // it is inside a loop, nothing holding the instance may live across
+  // iterations.
+  //
+  if (BlockStmt* loop = innermostLoop(move)) {
+    if (isWithin(sym->defPoint, loop) == false)
+      return false;
+
+    for_vector(Symbol, alias, aliases) {
+      if (isWithin(alias->defPoint, loop) == false)
+        return false;
+    }
+  }
+
+  SET_LINENO(move);
+
+  // Inline the _new wrapper and move its allocation to the stack
+  BlockStmt* bCopy = copyFnBodyForInlining(newCall, newFn, move);
+  CallExpr*  cast  = findStackableAllocation(bCopy);
+
+  INT_ASSERT(cast != NULL);
+
+  CallExpr* allocMove = toCallExpr(cast->parentExpr->prev);
+
+  allocMove->remove();
+  cast->replace(new CallExpr(PRIM_STACK_ALLOCATE_CLASS, ct->symbol));
+
+  for_alist(copy, bCopy->body) {
+    if (copy->next != NULL) {
+      if (DefExpr* def = toDefExpr(copy)) {
+        if (LabelSymbol* label = toLabelSymbol(def->sym)) {
+          label->removeFlag(FLAG_EPILOGUE_LABEL);
+        }
+      }
+
+      move->insertBefore(copy->remove());
+
+    } else {
+      CallExpr* returnStmt = toCallExpr(copy);
+
+      newCall->replace(returnStmt->get(1)->remove());
+    }
+  }
+
+  // The memory goes away with the stack frame; only deinitialize it
+  for_vector(CallExpr, call, deletes) {
+    SET_LINENO(call);
+
+    Expr* arg = call->get(1)->remove();
+
+    if (FnSymbol* deinitFn = ct->getDestructor()) {
+      Symbol* obj = toSymExpr(arg)->symbol();
+
+      if (obj->type != ct) {
+        VarSymbol* tmp = newTemp("stack_deinit_tmp", ct);
+
+        call->insertBefore(new DefExpr(tmp));
+        call->insertBefore(new CallExpr(PRIM_MOVE, tmp,
+                                        new CallExpr(PRIM_CAST, ct->symbol,
+                                                     obj)));
+        obj = tmp;
+      }
+
+      call->replace(new CallExpr(deinitFn, obj));
+
+    } else {
+      call->remove();
+    }
+  }
+
+  if (fReportStackAllocation &&
+      fn->getModule()->modTag == MOD_USER) {
+    printf("Allocated %s on the stack (%s:%d)\n",
+           ct->symbol->name, move->fname(), move->linenum());
+  }
+
+  return true;
+}
+
+void stackAllocateClasses() {
+  std::vector<CallExpr*> candidates;
+
+  forv_Vec(CallExpr, call, gCallExprs) {
+    if (call->inTree() &&
+        call->isPrimitive(PRIM_MOVE) &&
+        isFnSymbol(call->parentSymbol)) {
+      CallExpr* rhs = toCallExpr(call->get(2));
+
+      if (rhs != NULL &&
+          rhs->isResolved() &&
+          rhs->resolvedFunction()->hasFlag(FLAG_NEW_WRAPPER))
+        candidates.push_back(call);
+    }
+  }
+
+  for_vector(CallExpr, move, candidates) {
+    stackAllocateInstance(move);
+  }
+
+  formalEscapesCache.clear();
+  formalsInProgress.clear();
+}
@@ -36,6 +36,7 @@
 #include "library.h"
 #include "LoopExpr.h"
 #include "forallOptimizations.h"
+#include "optimizations.h"
 #include "scopeResolve.h"
 #include "splitInit.h"
 #include "stlUtil.h"
@@ -131,6 +132,8 @@ void normalize() {
 
   doPreNormalizeArrayOptimizations();
 
+  fuseOnStmts();
+
   moveAndCheckInterfaceConstraints();
   wrapImplementsStatements();
 
@@ -1485,10 +1485,12 @@ static void markLoopProperties(ForLoop* forLoop, BlockStmt* ibody,
                                bool forVectorize) {
   bool forIsOrderIndep = forLoop->isOrderIndependent();
   bool forHasHazard = forLoop->hasVectorizationHazard();
+  bool forVectorizeRequested = forLoop->isVectorizeRequested();
 
   if (forVectorize) {
     forLoop->orderIndependentSet(true);
     forIsOrderIndep = true;
+    forVectorizeRequested = true;
   }
 
   // If forLoop is not marked order independent, then
@@ -1518,6 +1520,10 @@ static void markLoopProperties(ForLoop* forLoop, BlockStmt* ibody,
           bool hazard = loop->hasVectorizationHazard();
           hazard = hazard || forHasHazard;
           loop->setHasVectorizationHazard(hazard);
+          // If the for loop asked to be vectorized, so does the one
+          // we are replacing it with.
+          if (forVectorizeRequested)
+            loop->vectorizeRequestedSet(true);
         }
       }
     }
@@ -2346,6 +2352,215 @@ buildIteratorCall(Symbol* ret, int fnid, Symbol* iterator, Vec<Type*>& children)
   return outerBlock;
 }
 
+// Returns why the loop advances 'iterFn' through its iterator class
+// instead of inlining it, for --report-iterator-lowering.
+static const char*
+iteratorClassReason(FnSymbol* iterFn, bool zippered) {
+  if (fNoInlineIterators)
+    return "iterator inlining is disabled";
+  else if (isVirtualIterator(iterFn))
+    return "it is dynamically dispatched";
+  else if (iterFn->hasFlag(FLAG_RECURSIVE_ITERATOR))
+    return "it is recursive";
+  else if (!canInlineIterator(iterFn))
+    return "it has too many yields";
+  else if (zippered)
+    return "it is zippered";
+  else
+    return "it could not be inlined";
+}
+
+static void
+reportIteratorClassLoop(ForLoop* forLoop, FnSymbol* iterFn, bool zippered) {
+  ModuleSymbol* mod = forLoop->getModule();
+
+  if (developer || mod->modTag == MOD_USER) {
+    printf("Loop (%s:%d) uses the iterator class of %s: %s\n",
+           forLoop->fname(), forLoop->linenum(), iterFn->name,
+           iteratorClassReason(iterFn, zippered));
+  }
+}
+
+static void
+collectZipperedIteratorTypes(Type* type, Vec<Type*>& types) {
+  if (type->symbol->hasFlag(FLAG_TUPLE)) {
+    AggregateType* tupleType = toAggregateType(type);
+
+    for (int i = 1; i <= tupleType->fields.length; i++)
+      collectZipperedIteratorTypes(tupleType->getField(i)->type, types);
+  } else {
+    types.add(type);
+  }
+}
+
+// Returns true if a goto in the loop body jumps outside of the loop,
+// e.g. for a 'break', a 'return' or a thrown error.
+static bool
+hasOutboundGoto(ForLoop* forLoop) {
+  std::vector<GotoStmt*> gotos;
+
+  collectGotoStmts(forLoop, gotos);
+
+  for_vector(GotoStmt, gt, gotos) {
+    Expr* target = toSymExpr(gt->label)->symbol()->defPoint;
+    bool  inside = false;
+
+    for (Expr* expr = target; expr != NULL; expr = expr->parentExpr) {
+      if (expr == forLoop) {
+        inside = true;
+        break;
+      }
+    }
+
+    if (inside == false)
+      return true;
+  }
+
+  return false;
+}
+
+//
+// Inline the first iterator of a zippered loop around the loop body and
+// advance the others through their iterator classes at each of its yields.
+// The first iterator determines the number of iterations, so the loop
+// needs no test of its own.  The generated code looks like:
+//
+//   zip1(_iterator2); init(_iterator2);
+//   <body of the first iterator, where each yield is replaced by>
+//     zip2(_iterator2);
+//     // Bounds checks inserted here.
+//     idx2 = getValue(_iterator2);
+//     <loop body>
+//     zip3(_iterator2); incr(_iterator2);
+//   // Bounds checks inserted here.
+//   zip4(_iterator2);
+//
+// This lets a follower with several yields become a plain loop nest.
+//
+// Returns true if the ForLoop was converted and removed from the tree.
+static bool
+expandZipperedIteratorInline(ForLoop* forLoop) {
+  Symbol*     iterator = forLoop->iteratorGet()->symbol();
+  Symbol*     index    = forLoop->indexGet()->symbol();
+  Vec<Type*>  types;
+
+  if (forLoop->isCoforallLoop() || index == gNone || hasOutboundGoto(forLoop))
+    return false;
+
+  collectZipperedIteratorTypes(iterator->type, types);
+
+  if (types.n < 2)
+    return false;
+
+  FnSymbol*  firstFn = getTheIteratorFn(types.v[0]);
+  Vec<Type*> firstChildren;
+
+  getIteratorChildren(firstChildren, types.v[0]);
+
+  if (firstFn->iteratorInfo == NULL                  ||
+      firstChildren.n > 0                            ||
+      isVirtualIterator(firstFn)                     ||
+      firstFn->hasFlag(FLAG_RECURSIVE_ITERATOR)      ||
+      firstFn->throwsError()                         ||
+      !isBoundedIterator(firstFn)                    ||
+      !canInlineIterator(firstFn))
+    return false;
+
+  // The other iterators keep their state in their iterator classes; the
+  // loop stays order independent only if each of them is a single loop
+  // that is order independent.
+  bool allOrderIndependent = true;
+
+  for (int i = 1; i < types.n; i++) {
+    FnSymbol* iterFn = getTheIteratorFn(types.v[i]);
+
+    if (iterFn->hasFlag(FLAG_YIELD_WITHIN_ON))
+      return false;
+
+    iterFn->collapseBlocks();
+
+    Vec<BaseAST*> asts;
+    bool          curOrderIndependent = false;
+
+    collect_asts_postorder(iterFn, asts);
+
+    if (CallExpr* singleLoopYield = isSingleLoopIterator(iterFn, asts)) {
+      if (LoopStmt* loop = LoopStmt::findEnclosingLoop(singleLoopYield)) {
+        curOrderIndependent = loop->isOrderIndependent();
+      }
+    }
+
+    allOrderIndependent = allOrderIndependent && curOrderIndependent;
+  }
+
+  if (firstFn->hasFlag(FLAG_VECTORIZE_YIELDING_LOOPS) && !allOrderIndependent)
+    return false;
+
+  SET_LINENO(forLoop);
+
+  Vec<Symbol*> iterators;
+  Vec<Symbol*> indices;
+
+  setupSimultaneousIterators(iterators, indices, iterator, index, forLoop);
+
+  for (int i = 1; i < iterators.n; i++) {
+    Vec<Type*> children;
+    FnSymbol*  iterFn = getTheIteratorFn(iterators.v[i]);
+
+    getIteratorChildren(children, iterators.v[i]->type);
+
+    forLoop->insertBefore(buildIteratorCall(NULL, ZIP1, iterators.v[i], children));
+    forLoop->insertBefore(buildIteratorCall(NULL, INIT, iterators.v[i], children));
+
+    forLoop->insertAtHead(buildIteratorCall(indices.v[i], GETVALUE, iterators.v[i], children));
+
+    forLoop->insertAtTail(buildIteratorCall(NULL, ZIP3, iterators.v[i], children));
+    forLoop->insertAtTail(buildIteratorCall(NULL, INCR, iterators.v[i], children));
+
+    forLoop->insertAfter(buildIteratorCall(NULL, ZIP4, iterators.v[i], children));
+
+    if (isBoundedIterator(iterFn) && !fNoBoundsChecks) {
+      VarSymbol* hasMore    = newTemp("hasMore",    dtBool);
+      VarSymbol* isFinished = newTemp("isFinished", dtBool);
+
+      forLoop->insertBefore(new DefExpr(isFinished));
+      forLoop->insertBefore(new DefExpr(hasMore));
+
+      forLoop->insertAtHead(new CondStmt(new SymExpr(isFinished),
+                                         new CallExpr(PRIM_RT_ERROR,
+                                                      new_CStringSymbol("zippered iterations have non-equal lengths"))));
+
+      forLoop->insertAtHead(new CallExpr(PRIM_MOVE, isFinished, new CallExpr(PRIM_UNARY_LNOT, hasMore)));
+
+      forLoop->insertAtHead(buildIteratorCall(hasMore, HASMORE, iterators.v[i], children));
+
+      forLoop->insertAfter(new CondStmt(new SymExpr(hasMore),
+                                        new CallExpr(PRIM_RT_ERROR,
+                                                     new_CStringSymbol("zippered iterations have non-equal lengths"))));
+
+      forLoop->insertAfter(buildIteratorCall(hasMore, HASMORE, iterators.v[i], children));
+    }
+
+    forLoop->insertAtHead(buildIteratorCall(NULL, ZIP2, iterators.v[i], children));
+
+    if (fReportIteratorLowering)
+      reportIteratorClassLoop(forLoop, iterFn, true);
+  }
+
+  if (forLoop->isOrderIndependent())
+    forLoop->orderIndependentSet(allOrderIndependent);
+
+  // Each copy of the body gets its own zippered index; the index of the
+  // first iterator becomes the index of the loop being inlined.
+  forLoop->insertAtHead(index->defPoint->remove());
+  forLoop->insertBefore(indices.v[0]->defPoint->remove());
+
+  forLoop->iteratorGet()->setSymbol(iterators.v[0]);
+  forLoop->indexGet()->setSymbol(indices.v[0]);
+
+  return expandIteratorInline(forLoop);
+}
+
 // Replace a ForLoop with its inline equivalent, if possible.
 // Otherwise, convert it into a C-style for loop.
 // The given forLoop is converted unconditionally.
@@ -2363,6 +2578,9 @@ expandForLoop(ForLoop* forLoop) {
         canInlineIterator(iterFn)                     &&
         ! isVirtualIterator(iterFn)                   ) {
       converted = expandIteratorInline(forLoop);
+    } else if (fInlineZipperedIterators &&
+               iterator->type->symbol->hasFlag(FLAG_TUPLE)) {
+      converted = expandZipperedIteratorInline(forLoop);
     }
   }
 
@@ -2456,6 +2674,11 @@ expandForLoop(ForLoop* forLoop) {
       forLoop->insertAfter (buildIteratorCall(NULL, ZIP4, iterators.v[i], children));
 
       FnSymbol* iterFn = getTheIteratorFn(iterators.v[i]);
+
+      if (fReportIteratorLowering)
+        reportIteratorClassLoop(forLoop, iterFn,
+                                iterator->type->symbol->hasFlag(FLAG_TUPLE));
+
       if (iterFn->hasFlag(FLAG_YIELD_WITHIN_ON)) {
         USR_FATAL_CONT(forLoop, "'yield' statements within 'on' clauses are not currently supported for iterators that are not inlined (e.g., within zippered loops)");
         break;
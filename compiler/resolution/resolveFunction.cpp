@@ -853,8 +853,9 @@ static void markIterator(FnSymbol* fn) {
        * or, if the body of the loop is just a yield
    */
   bool markOrderIndep = fn->hasFlag(FLAG_ORDER_INDEPENDENT_YIELDING_LOOPS);
+  bool markVectorize = fn->hasFlag(FLAG_VECTORIZE_YIELDING_LOOPS);
   bool markAllYieldingLoops = fn->hasFlag(FLAG_PROMOTION_WRAPPER) ||
-                              fn->hasFlag(FLAG_VECTORIZE_YIELDING_LOOPS) ||
+                              markVectorize ||
                               markOrderIndep;
 
   bool allYieldingLoopsJustYield = true;
@@ -873,6 +874,8 @@ static void markIterator(FnSymbol* fn) {
           allYieldingLoopsJustYield = allYieldingLoopsJustYield && justYield;
           if (justYield || markAllYieldingLoops) {
             loop->orderIndependentSet(true);
+            if (markVectorize)
+              loop->vectorizeRequestedSet(true);
             anyMarked = true;
           } else {
             anyNotMarked = true;
@@ -29,6 +29,7 @@
 private use DSIUtil;
 
 private use HaltWrappers;
+private use ChapelLocks;
 
 //
 // TODO List
@@ -47,6 +48,11 @@ private use HaltWrappers;
 
 config param debugBlockCyclicDist = false; // internal development flag (debugging)
 
+//
+// This flag is used to disable lazy initialization of the RAD cache.
+//
+config param disableBlockCyclicLazyRAD = defaultDisableLazyRADOpt;
+
 proc _determineRankFromArg(startIdx) param {
   return if isTuple(startIdx) then startIdx.size else 1;
 }
@@ -631,6 +637,8 @@ proc BlockCyclicDom.dsiBuildArray(type eltType, param initElts:bool) {
                                          myLocArr = myLocArrTemp,
                                          dom=_to_unmanaged(this));
 
+  if arr.doRADOpt && disableBlockCyclicLazyRAD then arr.setupRADOpt();
+
   return arr;
 }
 
@@ -854,6 +862,7 @@ proc LocBlockCyclicDom._sizes {
 // BlockCyclic Array Class
 //
 class BlockCyclicArr: BaseRectangularArr {
+  var doRADOpt: bool = defaultDoRADOpt;
 
   //
   // LEFT LINK: the global domain descriptor for this array
@@ -869,6 +878,8 @@ class BlockCyclicArr: BaseRectangularArr {
   // optimized reference to a local LocBlockCyclicArr instance (or nil)
   //
   var myLocArr: unmanaged LocBlockCyclicArr(eltType, rank, idxType, stridable)?;
+
+  const SENTINEL = max(1*int);
 }
 
 override proc BlockCyclicArr.dsiGetBaseDom() return dom;
@@ -877,6 +888,46 @@ override proc BlockCyclicArr.dsiIteratorYieldsLocalElements() param {
   return true;
 }
 
+//
+// The RAD cache is only used for 1D arrays, whose flat local index can
+// be computed from an index without consulting the owning locale.
+//
+// NOTE: Each locale's myElems array must be initialized prior to
+// setting up the RAD cache.
+//
+proc BlockCyclicArr.setupRADOpt() {
+  if rank == 1 {
+    for localeIdx in dom.dist.targetLocDom {
+      on dom.dist.targetLocales(localeIdx) {
+        const myLocArr = locArr(localeIdx);
+        if myLocArr.locRAD != nil {
+          delete myLocArr.locRAD;
+          myLocArr.locRAD = nil;
+        }
+        if disableBlockCyclicLazyRAD {
+          myLocArr.locRAD = new unmanaged LocRADCache(eltType, 1, int, false,
+                                                      dom.dist.targetLocDom);
+          for l in dom.dist.targetLocDom {
+            if l != localeIdx {
+              myLocArr.locRAD!.RAD(l) = locArr(l).myElems._value.dsiGetRAD();
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+override proc BlockCyclicArr.dsiPostReallocate() {
+  // Call this *after* the domain has been reallocated
+  if doRADOpt then setupRADOpt();
+}
+
+proc BlockCyclicArr.setRADOpt(val=true) {
+  doRADOpt = val;
+  if doRADOpt then setupRADOpt();
+}
+
 override proc BlockCyclicArr.dsiElementInitializationComplete() {
   coforall localeIdx in dom.dist.targetLocDom {
     on dom.dist.targetLocales(localeIdx) {
@@ -968,6 +1019,26 @@ proc BlockCyclicArr.dsiAccess(i: idxType) ref where rank == 1 {
   //  compilerError(loci.type:string);
   //  var desc = locArr(loci);
   //  return locArr(loci)(i);
+  if doRADOpt {
+    if const myLocArr = this.myLocArr {
+      var rlocIdx = dom.dist.idxToLocaleInd(i);
+      if !disableBlockCyclicLazyRAD {
+        const locRAD = chpl__lazyLocRAD(myLocArr, eltType, 1, int, false,
+                                        dom.dist.targetLocDom, SENTINEL);
+        chpl__lazyFillRAD(locRAD, rlocIdx, SENTINEL,
+                          locArr(rlocIdx).myElems);
+      }
+      pragma "no copy" pragma "no auto destroy" var myLocRAD = _to_nonnil(myLocArr.locRAD);
+      pragma "no copy" pragma "no auto destroy" var radata = myLocRAD.RAD;
+      if radata(rlocIdx).shiftedData != nil {
+        // the flat index only depends on the distribution's parameters,
+        // which every locale's local array shares
+        const flatIdx = myLocArr.mdInd2FlatInd(i);
+        var dataIdx = radata(rlocIdx).getDataIndex(flatIdx);
+        return radata(rlocIdx).getDataElem(dataIdx);
+      }
+    }
+  }
   return locArr(dom.dist.idxToLocaleInd(i))(i);
 }
 
@@ -1141,6 +1212,9 @@ class LocBlockCyclicArr {
   const sizes : (rank+1)*int = allocDom._sizes;
   const localeIndex: if rank == 1 then int else rank*int;
 
+  var locRAD: unmanaged LocRADCache(eltType, 1, int, false)?; // non-nil if doRADOpt=true
+  var locRADLock: chpl_LocalSpinlock;
+
   proc init(type eltType,
             param rank: int,
             type idxType,
@@ -1203,6 +1277,9 @@ class LocBlockCyclicArr {
     }
 
     // Elements in myElems are deinited in dsiDestroyArr if necessary.
+
+    if locRAD != nil then
+      delete locRAD;
   }
 
   // guard against dynamic dispatch resolution trying to resolve
@@ -1120,24 +1120,11 @@ proc BlockArr.nonLocalAccess(i: rank*idxType) ref {
     if const myLocArr = this.myLocArr {
       var rlocIdx = dom.dist.targetLocsIdx(i);
       if !disableBlockLazyRAD {
-        if myLocArr.locRAD == nil {
-          myLocArr.locRADLock.lock();
-          if myLocArr.locRAD == nil {
-            var tempLocRAD = new unmanaged LocRADCache(eltType, rank, idxType, stridable, dom.dist.targetLocDom);
-            tempLocRAD.RAD.blk = SENTINEL;
-            myLocArr.locRAD = tempLocRAD;
-          }
-          myLocArr.locRADLock.unlock();
-        }
-        const locRAD = _to_nonnil(myLocArr.locRAD);
-        if locRAD.RAD(rlocIdx).blk == SENTINEL {
-          locRAD.lockRAD(rlocIdx);
-          if locRAD.RAD(rlocIdx).blk == SENTINEL {
-            locRAD.RAD(rlocIdx) =
-              locArr(rlocIdx).myElems._value.dsiGetRAD();
-          }
-          locRAD.unlockRAD(rlocIdx);
-        }
+        const locRAD = chpl__lazyLocRAD(myLocArr, eltType, rank, idxType,
+                                        stridable, dom.dist.targetLocDom,
+                                        SENTINEL);
+        chpl__lazyFillRAD(locRAD, rlocIdx, SENTINEL,
+                          locArr(rlocIdx).myElems);
       }
       pragma "no copy" pragma "no auto destroy" var myLocRAD = myLocArr.locRAD;
       pragma "no copy" pragma "no auto destroy" var radata = _to_nonnil(myLocRAD).RAD;
@@ -1762,16 +1749,9 @@ proc BlockArr.doiScan(op, dom) where (rank == 1) &&
   type resType = op.generate().type;
   var res = dom.buildArray(resType, initElts=!isPOD(resType));
 
-  // Store one element per locale in order to track our local total
-  // for a cross-locale scan as well as flags to negotiate reading and
-  // writing it.  This domain really wants an easier way to express
-  // it...
-  use ReplicatedDist;
+  // One mailbox per locale for the log-depth exchange of locale totals
   const ref targetLocs = this.dsiTargetLocales();
-  const elemPerLocDom = {1..1} dmapped Replicated(targetLocs);
-  var elemPerLoc: [elemPerLocDom] resType;
-  var inputReady$: [elemPerLocDom] sync bool;
-  var outputReady$: [elemPerLocDom] sync bool;
+  const boxes = chpl__scanMailboxes(resType, targetLocs);
 
   // Fire up tasks per participating locale
   coforall locid in dom.dist.targetLocDom {
@@ -1789,35 +1769,9 @@ proc BlockArr.doiScan(op, dom) where (rank == 1) &&
       if debugBlockScan then
         writeln(locid, ": ", (numTasks, rngs, state, tot));
 
-      // save our local scan total away and signal that it's ready
-      elemPerLoc[1] = tot;
-      inputReady$[1].writeEF(true);
-
-      // the "first" locale scans the per-locale contributions as they
-      // become ready
-      if (locid == dom.dist.targetLocDom.low) {
-        const metaop = op.clone();
-
-        var next: resType = metaop.identity;
-        for locid in dom.dist.targetLocDom {
-          const targetloc = targetLocs[locid];
-          const locready = inputReady$.replicand(targetloc)[1].readFE();
-
-          // store the scan value and mark that it's ready
-          ref locVal = elemPerLoc.replicand(targetloc)[1];
-          locVal <=> next;
-          outputReady$.replicand(targetloc)[1].writeEF(true);
-
-          // accumulate to prep for the next iteration
-          metaop.accumulateOntoState(next, locVal);
-        }
-        delete metaop;
-      }
-
-      // block until someone tells us that our local value has been updated
-      // and then read it
-      const resready = outputReady$[1].readFE();
-      const myadjust = elemPerLoc[1];
+      // combine the totals of the locales before us
+      const myadjust = chpl__scanExclusivePrefix(myop, boxes,
+                         dom.dist.targetLocDom.indexOrder(locid), tot);
       if debugBlockScan then
         writeln(locid, ": myadjust = ", myadjust);
 
@@ -1829,19 +1783,28 @@ proc BlockArr.doiScan(op, dom) where (rank == 1) &&
 
       // have our local array compute its post scan with the globally
       // accurate state vector
-      myLocArr._value.chpl__postScan(op, res, numTasks, rngs, state);
+      myLocArr._value.chpl__postScan(op, res, numTasks, rngs, state,
+                                     myLocDom[dom]);
       if debugBlockScan then
         writeln(locid, ": ", myLocArr);
 
       delete myop;
     }
   }
+  chpl__deleteScanMailboxes(boxes);
   if isPOD(resType) then res.dsiElementInitializationComplete();
 
   delete op;
   return res;
 }
 
+// A block of a multidimensional array is not contiguous in row-major
+// order, so gather the scan order by segments instead.
+proc BlockArr.doiScan(op, dom) where (rank > 1) &&
+                                     chpl__scanStateResTypesMatch(op) {
+  return chpl__scanByGather(this, op, dom, debugBlockScan);
+}
+
 
 ////// Factory functions ////////////////////////////////////////////////////
 
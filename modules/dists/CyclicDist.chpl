@@ -911,15 +911,8 @@ proc CyclicArr.dsiAccess(i:rank*idxType) ref {
           }
           myLocArr.locRADLock.unlock();
         }
-        const locRAD = _to_nonnil(myLocArr.locRAD);
-        if locRAD.RAD(rlocIdx).blk == SENTINEL {
-          locRAD.lockRAD(rlocIdx);
-          if locRAD.RAD(rlocIdx).blk == SENTINEL {
-            locRAD.RAD(rlocIdx) =
-              locArr(rlocIdx).myElems._value.dsiGetRAD();
-          }
-          locRAD.unlockRAD(rlocIdx);
-        }
+        chpl__lazyFillRAD(_to_nonnil(myLocArr.locRAD), rlocIdx, SENTINEL,
+                          locArr(rlocIdx).myElems);
       }
       pragma "no copy" pragma "no auto destroy" var myLocRAD = myLocArr.locRAD;
       pragma "no copy" pragma "no auto destroy" var radata = _to_nonnil(myLocRAD).RAD;
@@ -1313,3 +1306,13 @@ proc newCyclicDom(rng: range...) {
 proc newCyclicArr(rng: range..., type eltType) {
   return newCyclicArr({(...rng)}, eltType);
 }
+
+config param debugCyclicScan = false;
+
+//
+// Consecutive elements of a Cyclic array live on different locales, so no
+// locale holds a contiguous run of the scan.  See chpl__scanByGather().
+//
+proc CyclicArr.doiScan(op, dom) where chpl__scanStateResTypesMatch(op) {
+  return chpl__scanByGather(this, op, dom, debugCyclicScan);
+}
@@ -619,3 +619,216 @@ proc bulkCommConvertCoordinate(ind, bView:domain, aView:domain)
   }
   return result;
 }
+
+//
+// Cross-locale phase of a distributed scan.
+//
+// Every participating locale calls chpl__scanExclusivePrefix() with its
+// position in scan order and the total of its local pre-scan, and gets back
+// the combined totals of all locales before it.  This is computed by
+// recursive doubling: in round k each locale sends its running total to the
+// locale 2**k positions after it, so the exchange takes ceil(log2(n))
+// rounds of point-to-point messages instead of a chain through one locale.
+// The mailboxes receiving those messages must all exist before any locale
+// starts sending, so they are allocated up front by chpl__scanMailboxes().
+//
+class ScanMailbox {
+  type resType;
+  const nRounds: int;
+  var vals: [0..#nRounds] resType;
+  var ready$: [0..#nRounds] sync bool;
+}
+
+// Allocate one mailbox per target locale, indexed by scan order
+proc chpl__scanMailboxes(type resType, const ref targetLocs: [] locale) {
+  const n = targetLocs.size;
+  var nRounds = 0;
+  while (1 << nRounds) < n do nRounds += 1;
+
+  var boxes: [0..#n] unmanaged ScanMailbox(resType)?;
+  coforall i in 0..#n with (ref boxes) {
+    on targetLocs[targetLocs.domain.orderToIndex(i)] do
+      boxes[i] = new unmanaged ScanMailbox(resType, nRounds);
+  }
+  return boxes;
+}
+
+proc chpl__deleteScanMailboxes(boxes) {
+  coforall box in boxes do on box do delete box;
+}
+
+// Return the exclusive prefix of 'tot' across the locales before 'me'
+proc chpl__scanExclusivePrefix(op, boxes, me: int, tot) {
+  type resType = tot.type;
+  const n = boxes.size;
+  var incl = tot,
+      excl: resType = op.identity;
+
+  var round = 0, dist = 1;
+  while dist < n {
+    if me + dist < n {
+      const dst = boxes[me + dist]!, v = incl, k = round;
+      on dst {
+        dst.vals[k] = v;
+        dst.ready$[k].writeEF(true);
+      }
+    }
+    if me - dist >= 0 {
+      const box = boxes[me]!;
+      box.ready$[round].readFE();
+      const r = box.vals[round];
+
+      // r covers the locales just before our current window
+      var t = r;
+      op.accumulateOntoState(t, excl);
+      excl = t;
+      t = r;
+      op.accumulateOntoState(t, incl);
+      incl = t;
+    }
+    round += 1;
+    dist *= 2;
+  }
+  return excl;
+}
+
+//
+// A distributed scan for arrays whose locales do not each hold a
+// contiguous run of the scan order: Cyclic arrays, and multidimensional
+// Block and Stencil arrays, whose blocks are not contiguous in row-major
+// order.  The row-major positions of 'dom' are cut into one contiguous
+// segment per locale.  Each locale gathers its segment from the owners of
+// its elements with one bulk exchange per owner, scans it locally,
+// combines the locale totals with chpl__scanExclusivePrefix(), and sends
+// the results back to their owners the same way.
+//
+proc chpl__scanByGather(arr, op, dom, param debug: bool) {
+  use RangeChunk;
+
+  type eltType = arr.eltType;
+  type resType = op.generate().type;
+  var res = dom.buildArray(resType, initElts=!isPOD(resType));
+
+  const ref targetLocs = arr.dsiTargetLocales();
+  const ref targetLocDom = arr.dom.dist.targetLocDom;
+  const nLocs = targetLocDom.sizeAs(int);
+  const boxes = chpl__scanMailboxes(resType, targetLocs);
+
+  coforall locid in targetLocDom {
+    on targetLocs[locid] {
+      const me = targetLocDom.indexOrder(locid);
+      const myop = op.clone();
+
+      // The positions (in scan order) of my segment
+      const mySeg = chunk(0..#dom.sizeAs(int), nLocs, me);
+
+      // Group my positions by owning locale, in order within each group
+      var owner: [mySeg] int;
+      forall p in mySeg with (ref owner) do
+        owner[p] = targetLocDom.indexOrder(
+                     arr.dom.dist.targetLocsIdx(dom.orderToIndex(p)));
+      var counts: [0..#nLocs] int;
+      forall o in owner with (+ reduce counts) do
+        counts[o] += 1;
+      const starts = (+ scan counts) - counts;
+      var order: [0..#mySeg.size] int;
+      var cursor = starts;
+      for p in mySeg {
+        order[cursor[owner[p]]] = p;
+        cursor[owner[p]] += 1;
+      }
+
+      // Pull my segment from its owners
+      var gathered: [0..#mySeg.size] eltType;
+      coforall src in 0..#nLocs with (ref gathered) {
+        const r = starts[src]..#counts[src];
+        const srcLocArr = arr.locArr[targetLocDom.orderToIndex(src)];
+        if r.size > 0 then on srcLocArr {
+          const srcPos: [r] int = order[r];
+          var vals: [r] eltType;
+          forall (v, p) in zip(vals, srcPos) do
+            v = srcLocArr.myElems[dom.orderToIndex(p)];
+          gathered[r] = vals;
+        }
+      }
+      var buf: [mySeg] eltType;
+      forall (g, p) in zip(gathered, order) with (ref buf) do
+        buf[p] = g;
+
+      // Scan the segment and fold in the totals of earlier segments
+      var segRes: [mySeg] resType;
+      var (numTasks, rngs, state, tot) =
+        buf._value.chpl__preScan(myop, segRes, buf.domain);
+      const myadjust = chpl__scanExclusivePrefix(myop, boxes, me, tot);
+      if debug then
+        writeln(locid, ": segment = ", mySeg, ", myadjust = ", myadjust);
+      for s in state do
+        myop.accumulateOntoState(s, myadjust);
+      buf._value.chpl__postScan(op, segRes, numTasks, rngs, state,
+                                buf.domain);
+
+      // Return the results to the owners of the elements
+      var scattered: [0..#mySeg.size] resType;
+      forall (s, p) in zip(scattered, order) do
+        s = segRes[p];
+      coforall src in 0..#nLocs {
+        const r = starts[src]..#counts[src];
+        const srcLocArr = arr.locArr[targetLocDom.orderToIndex(src)];
+        if r.size > 0 then on srcLocArr {
+          const srcPos: [r] int = order[r];
+          const vals: [r] resType = scattered[r];
+          forall (v, p) in zip(vals, srcPos) do
+            res.localAccess(dom.orderToIndex(p)) = v;
+        }
+      }
+
+      delete myop;
+    }
+  }
+  chpl__deleteScanMailboxes(boxes);
+  if isPOD(resType) then res.dsiElementInitializationComplete();
+
+  delete op;
+  return res;
+}
+
+//
+// Remote access data (RAD) caches
+//
+// A distributed array's per-locale piece may keep a LocRADCache with
+// one _remoteAccessData entry per target locale, letting a remote
+// element access go straight to the owning locale's data instead of
+// through its array class.  The pieces provide 'locRAD' and
+// 'locRADLock' fields; entries whose 'blk' is 'sentinel' are not yet
+// populated.
+//
+
+// Return 'holder's cache, creating it with all entries unpopulated
+// if this is the first access through it.
+proc chpl__lazyLocRAD(holder, type eltType, param rank: int, type idxType,
+                      param stridable: bool, targetLocDom, sentinel) {
+  if holder.locRAD == nil {
+    holder.locRADLock.lock();
+    if holder.locRAD == nil {
+      var tempLocRAD = new unmanaged LocRADCache(eltType, rank, idxType,
+                                                 stridable, targetLocDom);
+      tempLocRAD.RAD.blk = sentinel;
+      holder.locRAD = tempLocRAD;
+    }
+    holder.locRADLock.unlock();
+  }
+  return _to_nonnil(holder.locRAD);
+}
+
+// Populate entry 'rlocIdx' of 'locRAD' from 'remoteElems', the owning
+// locale's storage, unless another task has done so already.  The
+// storage is only dereferenced when the entry needs filling.
+inline proc chpl__lazyFillRAD(locRAD, rlocIdx, sentinel,
+                              const ref remoteElems) {
+  if locRAD.RAD(rlocIdx).blk == sentinel {
+    locRAD.lockRAD(rlocIdx);
+    if locRAD.RAD(rlocIdx).blk == sentinel then
+      locRAD.RAD(rlocIdx) = remoteElems._value.dsiGetRAD();
+    locRAD.unlockRAD(rlocIdx);
+  }
+}
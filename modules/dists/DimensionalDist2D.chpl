@@ -28,6 +28,7 @@
 //  when the domain's stride changes.
 
 use DSIUtil;
+private use ChapelLocks;
 //use WrapperDist;
 
 // debugging/trace certain DSI methods as they are being invoked
@@ -36,6 +37,9 @@ config param traceDimensionalDistDsiAccess = false;
 config param traceDimensionalDistIterators = false;
 config param fakeDimensionalDistParDim = -1;
 
+// This flag is used to disable lazy initialization of the RAD cache.
+config param disableDimensionalLazyRAD = defaultDisableLazyRADOpt;
+
 // so user-specified phases can be retained while sorting verbose output
 var traceDimensionalDistPrefix = "";
 
@@ -367,6 +371,20 @@ class DimensionalArr : BaseRectangularArr {
   // NOTE: 'dom' must be initialized prior to initializing 'localAdescs'
   var localAdescs: [dom.targetIds]
                       unmanaged LocDimensionalArr(eltType, allocDom.locDdescType);
+
+  // whether to cache remote access data in the local array descriptors
+  var doRADOpt: bool = defaultDoRADOpt;
+
+  // the local array descriptor on this locale, if any
+  var myLocAdesc: unmanaged LocDimensionalArr(eltType, allocDom.locDdescType)?;
+
+  const SENTINEL = max(2*int);
+
+  proc postinit() {
+    for locAdesc in localAdescs do
+      if locAdesc.locale == here then
+        myLocAdesc = locAdesc;
+  }
 }
 
 class LocDimensionalArr {
@@ -376,6 +394,11 @@ class LocDimensionalArr {
   // may be initialized separately
   var myStorageArr: [locDom.myStorageDom] eltType;
 
+  // remote access data for the other locales' storage; non-nil if doRADOpt
+  var locRAD: unmanaged LocRADCache(eltType, 2, locDom.myStorageDom.idxType,
+                                    locDom.myStorageDom.stridable)?;
+  var locRADLock: chpl_LocalSpinlock;
+
   proc init(type eltType,
             const locDom,
             param initElts: bool) {
@@ -387,6 +410,9 @@ class LocDimensionalArr {
 
   proc deinit() {
     // Elements in myStorageArr are deinited in dsiDestroyArr if necessary.
+
+    if locRAD != nil then
+      delete locRAD;
   }
 
   // guard against dynamic dispatch resolution trying to resolve
@@ -982,9 +1008,42 @@ proc DimensionalDom.dsiBuildArray(type eltType, param initElts:bool)
                                     dom      = _to_unmanaged(this),
                                     allocDom = _to_unmanaged(this));
   assert(!result.isAlias);
+  if result.doRADOpt && disableDimensionalLazyRAD then result.setupRADOpt();
   return result;
 }
 
+//
+// NOTE: Each locale's myStorageArr must be initialized prior to
+// setting up the RAD cache.
+//
+proc DimensionalArr.setupRADOpt() {
+  for (locId, locAdesc) in zip(targetIds, localAdescs) {
+    on locAdesc {
+      if locAdesc.locRAD != nil {
+        delete locAdesc.locRAD;
+        locAdesc.locRAD = nil;
+      }
+      if disableDimensionalLazyRAD {
+        locAdesc.locRAD = new unmanaged LocRADCache(eltType, 2,
+                                 locAdesc.locDom.myStorageDom.idxType,
+                                 locAdesc.locDom.myStorageDom.stridable,
+                                 targetIds);
+        for l in targetIds {
+          if l != locId {
+            locAdesc.locRAD!.RAD(l) =
+              localAdescs[l].myStorageArr._value.dsiGetRAD();
+          }
+        }
+      }
+    }
+  }
+}
+
+proc DimensionalArr.setRADOpt(val=true) {
+  doRADOpt = val;
+  if doRADOpt then setupRADOpt();
+}
+
 
 override proc DimensionalDom.dsiDestroyDom() {
   coforall desc in localDdescs do
@@ -1012,6 +1071,24 @@ proc DimensionalArr.dsiAccess(indexx: dom.indexT) ref: eltType {
   const alDom = this.allocDom;
   const (l1,i1):(locIdT, alDom.stoIndexT) = alDom.dom1.dsiAccess1d(indexx(0));
   const (l2,i2):(locIdT, alDom.stoIndexT) = alDom.dom2.dsiAccess1d(indexx(1));
+  if doRADOpt {
+    if const myLocAdesc = this.myLocAdesc {
+      if !disableDimensionalLazyRAD {
+        const locRAD = chpl__lazyLocRAD(myLocAdesc, eltType, 2,
+                                 myLocAdesc.locDom.myStorageDom.idxType,
+                                 myLocAdesc.locDom.myStorageDom.stridable,
+                                 targetIds, SENTINEL);
+        chpl__lazyFillRAD(locRAD, (l1,l2), SENTINEL,
+                          localAdescs[l1,l2].myStorageArr);
+      }
+      pragma "no copy" pragma "no auto destroy" var myLocRAD = _to_nonnil(myLocAdesc.locRAD);
+      pragma "no copy" pragma "no auto destroy" var radata = myLocRAD.RAD;
+      if radata(l1,l2).theData != nil {
+        var dataIdx = radata(l1,l2).getDataIndex((i1,i2));
+        return radata(l1,l2).getDataElem(dataIdx);
+      }
+    }
+  }
   const locAdesc = this.localAdescs[l1,l2];
 //writeln("locAdesc.myStorageArr on ", locAdesc.myStorageArr.locale.id);
   return locAdesc.myStorageArr(i1,i2);
@@ -1096,7 +1173,8 @@ proc DimensionalArr.dsiReallocate(d: domain) {
 }
 
 override proc DimensionalArr.dsiPostReallocate() {
-  // nothing for now
+  // Call this *after* the domain has been reallocated
+  if doRADOpt then setupRADOpt();
 }
 
 override proc DimensionalArr.dsiElementInitializationComplete() {
@@ -457,8 +457,7 @@ class ReplicatedArr : AbsBaseArr {
   }
 
   // scan the local locale's replicand
-  proc doiScan(op, dom) where ((rank == 1) &&
-                               chpl__scanStateResTypesMatch(op)) {
+  proc doiScan(op, dom) where chpl__scanStateResTypesMatch(op) {
     return localArrs[here.id]!.arrLocalRep._instance.doiScan(op, dom);
   }
 }
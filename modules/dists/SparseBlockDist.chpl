@@ -176,13 +176,15 @@ class SparseBlockDom: BaseSparseDomImpl {
       return retval;
     }
 
+    // Unsorted input (e.g. an edge list) is bucketed by target locale
+    // instead of being sorted globally; each locale sorts its own bucket.
+    if !dataSorted then return bulkAddBucketed_help(inds, isUnique);
+
     // without _new_, record functions throw null deref
     var comp = new TargetLocaleComparator(rank=rank, idxType=idxType,
                                           sparseLayoutType=sparseLayoutType,
                                           dist=dist);
 
-    if !dataSorted then sort(inds, comparator=comp);
-
     var localeRanges: [dist.targetLocDom] range;
     on inds {
       for l in dist.targetLocDom {
@@ -217,6 +219,72 @@ class SparseBlockDom: BaseSparseDomImpl {
     return _retval;
   }
 
+  //
+  // Add unsorted indices in bulk.  Indices are counted and scattered into
+  // one contiguous bucket per target locale in parallel on the locale that
+  // holds ``inds``.  Every target then pulls its whole bucket with a single
+  // bulk transfer and hands it to its local layout's bulkAdd, so the only
+  // sorting done is of each locale's own indices, in parallel.
+  //
+  proc bulkAddBucketed_help(inds: [?indsDom] index(rank,idxType),
+                            isUnique) {
+    use RangeChunk;
+
+    const nTargets = dist.targetLocDom.size;
+    var _totalAdded: atomic int;
+
+    on inds {
+      var buckets: [0..#indsDom.size] index(rank, idxType);
+      var bucketStart: [0..nTargets] int;
+      const numChunks = max(1, min(here.maxTaskPar, indsDom.size));
+      var dest: [indsDom] int;
+      // counts[c, t]: indices in chunk c bound for target t, then the
+      // position in buckets where chunk c writes its first such index
+      var counts: [0..#numChunks, 0..#nTargets] int;
+
+      coforall c in 0..#numChunks with (ref dest, ref counts) {
+        for k in chunk(indsDom.dim(0), numChunks, c) {
+          const t = dist.targetLocDom.indexOrder(dist.targetLocsIdx(inds[k]));
+          dest[k] = t;
+          counts[c, t] += 1;
+        }
+      }
+
+      var sum = 0;
+      for t in 0..#nTargets {
+        bucketStart[t] = sum;
+        for c in 0..#numChunks {
+          const cnt = counts[c, t];
+          counts[c, t] = sum;
+          sum += cnt;
+        }
+      }
+      bucketStart[nTargets] = sum;
+
+      // Chunks keep their input order within each bucket
+      coforall c in 0..#numChunks with (ref counts, ref buckets) {
+        for k in chunk(indsDom.dim(0), numChunks, c) {
+          const t = dest[k];
+          buckets[counts[c, t]] = inds[k];
+          counts[c, t] += 1;
+        }
+      }
+
+      coforall l in dist.targetLocDom {
+        const t = dist.targetLocDom.indexOrder(l);
+        const myRange = bucketStart[t]..bucketStart[t+1]-1;
+        if myRange.size > 0 then on dist.targetLocales[l] {
+          var myInds: [0..#myRange.size] index(rank, idxType) =
+            buckets[myRange];
+          const _retval = locDoms[l]!.mySparseBlock.bulkAdd(myInds,
+              dataSorted=false, isUnique=isUnique, preserveInds=false);
+          _totalAdded.add(_retval);
+        }
+      }
+    }
+    return _totalAdded.read();
+  }
+
   proc bulkAddHere_help(inds: [] index(rank,idxType),
       dataSorted=false, isUnique=false) {
 
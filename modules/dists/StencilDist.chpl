@@ -211,8 +211,42 @@ config param disableStencilLazyRAD = defaultDisableLazyRADOpt;
 
     // ghost caches are now up-to-date
 
-  After updating, any read from the array should be up-to-date. The
-  ``updateFluff`` function does not currently accept any arguments.
+  After updating, any read from the array should be up-to-date.
+
+  ``updateFluff`` accepts two optional arguments that limit which cached
+  elements are refreshed:
+
+  * ``depth``: a ``rank*idxType`` tuple giving the number of cached layers
+    to refresh in each dimension, nearest the locale's own block first. It
+    defaults to ``fluff`` and each component must be between zero and the
+    corresponding ``fluff`` component. A zero skips that dimension, including
+    any corners that lie along it.
+  * ``sides``: a ``rank*int`` tuple where ``-1`` refreshes only the cached
+    elements below the locale's block in that dimension, ``1`` only those
+    above it, and ``0`` (the default) both.
+
+  For 1D arrays either argument may be given as a scalar. For example, a
+  stencil that only reads one row above and below each element could use:
+
+  .. code-block:: chapel
+
+    A.updateFluff(depth=(1,0));
+
+  The ``updateFluffAsync`` function takes the same arguments but returns
+  immediately with a :class:`StencilFluffUpdate` handle while the update
+  proceeds in the background. This lets a locale compute on the interior of
+  its block while the cached elements are in flight:
+
+  .. code-block:: chapel
+
+    const update = A.updateFluffAsync();
+    forall (i,j) in Interior do B[i,j] = f(A, i, j);  // no fluff reads
+    update.wait();
+    forall (i,j) in Boundary do B[i,j] = f(A, i, j);
+
+  The array's elements must not be written, and its cached elements must not
+  be read, until ``wait`` returns. Only one update of a given array may be in
+  flight at a time.
 
   **Reading and Writing to Array Elements**
 
@@ -420,6 +454,24 @@ class LocStencilArr {
   }
 }
 
+/*
+  A handle for a cache update started by ``updateFluffAsync``.
+*/
+class StencilFluffUpdate {
+  pragma "no doc"
+  var done$: sync bool;
+
+  /* Wait for the update to complete. May be called more than once. */
+  proc wait() {
+    done$.readFF();
+  }
+
+  /* Returns ``true`` if the update has completed. */
+  proc isDone(): bool {
+    return done$.isFull;
+  }
+}
+
 private proc makeZero(param rank : int, type idxType) {
   var ret : rank*idxType;
   return ret;
@@ -1212,24 +1264,11 @@ proc StencilArr.nonLocalAccess(i: rank*idxType) ref {
       const myLocArr = _to_nonnil(this.myLocArr);
       var rlocIdx = dom.dist.targetLocsIdx(i);
       if !disableStencilLazyRAD {
-        if myLocArr.locRAD == nil {
-          myLocArr.locRADLock.lock();
-          if myLocArr.locRAD == nil {
-            var tempLocRAD = new unmanaged LocRADCache(eltType, rank, idxType, stridable, dom.dist.targetLocDom);
-            tempLocRAD.RAD.blk = SENTINEL;
-            myLocArr.locRAD = tempLocRAD;
-          }
-          myLocArr.locRADLock.unlock();
-        }
-        const locRAD = _to_nonnil(myLocArr.locRAD);
-        if locRAD.RAD(rlocIdx).blk == SENTINEL {
-          locRAD.lockRAD(rlocIdx);
-          if locRAD.RAD(rlocIdx).blk == SENTINEL {
-            locRAD.RAD(rlocIdx) =
-              locArr(rlocIdx).myElems._value.dsiGetRAD();
-          }
-          locRAD.unlockRAD(rlocIdx);
-        }
+        const locRAD = chpl__lazyLocRAD(myLocArr, eltType, rank, idxType,
+                                        stridable, dom.dist.targetLocDom,
+                                        SENTINEL);
+        chpl__lazyFillRAD(locRAD, rlocIdx, SENTINEL,
+                          locArr(rlocIdx).myElems);
       }
       pragma "no copy" pragma "no auto destroy" var myLocRAD = _to_nonnil(myLocArr.locRAD);
       pragma "no copy" pragma "no auto destroy" var radata = myLocRAD.RAD;
@@ -1577,7 +1616,8 @@ proc StencilArr.noFluffView() {
 //
 // Ideally the compiler could do something like this for us...
 //
-proc StencilArr.naiveUpdateFluff() {
+proc StencilArr.naiveUpdateFluff(depth = dom.fluff,
+                                  sides = makeZero(rank, int)) {
   coforall i in dom.dist.targetLocDom {
     on dom.dist.targetLocales(i) {
       ref myLocDom = locArr[i].locDom;
@@ -1588,14 +1628,50 @@ proc StencilArr.naiveUpdateFluff() {
         //
         // if "L" is zero, that indicates we are at the center of the stencil
         // and do not need to update
-        if !isZeroTuple(L) && S.size != 0 {
-          locArr[i].myElems[D] = locArr[N].myElems[S];
+        if !isZeroTuple(L) && S.size != 0 &&
+           _fluffSelected(L, depth, sides) {
+          // Non-contiguous faces are moved with a single strided bulk
+          // transfer by DefaultRectangular.
+          locArr[i].myElems[_trimFluff(D, L, depth)] =
+            locArr[N].myElems[_trimFluff(S, L, depth)];
         }
       }
     }
   }
 }
 
+//
+// Whether the fluff region on side 'L' of a locale's block is part of an
+// update limited to 'depth' layers on the given 'sides'.
+//
+proc StencilArr._fluffSelected(L, depth: rank*idxType, sides: rank*int) {
+  const to = chpl__tuplify(L);
+  for param d in 0..rank-1 {
+    if to(d) != 0 {
+      if depth(d) == 0 then return false;
+      if sides(d) != 0 && sides(d) != to(d) then return false;
+    }
+  }
+  return true;
+}
+
+//
+// Limit 'R', a fluff region on side 'L' of a block or the part of a
+// neighbor's block that fills it, to the 'depth' layers nearest the
+// boundary between the two blocks.
+//
+proc StencilArr._trimFluff(R, L, depth: rank*idxType) {
+  const to = chpl__tuplify(L);
+  var dims = R.dims();
+  for param d in 0..rank-1 {
+    if to(d) < 0 then
+      dims(d) = dims(d) # -depth(d);
+    else if to(d) > 0 then
+      dims(d) = dims(d) # depth(d);
+  }
+  return {(...dims)};
+}
+
 //
 // TODO: GET or PUT the data? Does it matter for performance?
 //
@@ -1625,7 +1701,8 @@ proc StencilArr.naiveUpdateFluff() {
 //    b) Bulk-copy the remote buffer into a local buffer
 //    c) Copy elements from the local buffer into the cache
 //
-proc StencilArr._packedUpdate() {
+proc StencilArr._packedUpdate(depth = dom.fluff,
+                              sides = makeZero(rank, int)) {
   coforall i in dom.dist.targetLocDom {
     on dom.dist.targetLocales(i) {
       var myLocDom = locArr[i].locDom;
@@ -1637,15 +1714,20 @@ proc StencilArr._packedUpdate() {
       // BHARSH TODO: can we fuse these two foralls? My current concern is that
       // by waiting we might prevent another iteration running and possibly
       // find ourselves in a deadlock.
-      forall (D, S, recvIdx, sendBufIdx) in zip(myLocDom.sendDest, myLocDom.sendSrc,
-                                                myLocDom.Neighs,
-                                                myLocDom.NeighDom) {
+      forall (fullD, fullS, recvIdx, sendBufIdx) in zip(myLocDom.sendDest,
+                                                        myLocDom.sendSrc,
+                                                        myLocDom.Neighs,
+                                                        myLocDom.NeighDom) {
+        // The receiving locale sees this region on the opposite side
+        const recvBufIdx = translateIdx(sendBufIdx);
+
         // If S.size == 0, no communication is required
-        if S.size != 0 {
+        if fullS.size != 0 && _fluffSelected(recvBufIdx, depth, sides) {
+          const D = _trimFluff(fullD, recvBufIdx, depth),
+                S = _trimFluff(fullS, recvBufIdx, depth);
           const chunkSize  = max(1, S.dim(rank-1).size); // avoid divide by zero
           const numChunks = S.size / chunkSize;
           if numChunks >= stencilDistPackedUpdateMinChunks {
-            const recvBufIdx = translateIdx(sendBufIdx);
 
             // Pack the buffer
             //
@@ -1664,15 +1746,21 @@ proc StencilArr._packedUpdate() {
           }
         }
       }
-      forall (D, S, srcIdx, recvBufIdx) in zip(myLocDom.recvDest, myLocDom.recvSrc,
-                                               myLocDom.Neighs,
-                                               myLocDom.NeighDom) {
+      forall (fullD, fullS, srcIdx, recvBufIdx) in zip(myLocDom.recvDest,
+                                                       myLocDom.recvSrc,
+                                                       myLocDom.Neighs,
+                                                       myLocDom.NeighDom) {
+        if fullS.size == 0 || !_fluffSelected(recvBufIdx, depth, sides) then
+          continue;
+
+        const D = _trimFluff(fullD, recvBufIdx, depth),
+              S = _trimFluff(fullS, recvBufIdx, depth);
         const chunkSize  = max(1, S.dim(rank-1).size); // avoid divide by zero
         const numChunks = S.size / chunkSize;
 
         // If we did a naive update in the previous loop, this iteration does
         // not need to do anything.
-        if S.size != 0 && numChunks >= stencilDistPackedUpdateMinChunks {
+        if numChunks >= stencilDistPackedUpdateMinChunks {
           const srcBufIdx = translateIdx(recvBufIdx);
           if debugStencilDist then
             writeln(here, "::", recvBufIdx, " WAITING");
@@ -1697,7 +1785,8 @@ proc StencilArr.shouldDoPackedUpdate() param : bool {
 
 // Update caches
 //
-// TODO: allow a bool argument here?
+// 'depth' and 'sides' may be scalars for 1D arrays; see the module
+// documentation for their meaning.
 //
 // TODO: allow for some kind of user-defined packing/unpacking for complicated
 // types?
@@ -1709,16 +1798,54 @@ proc StencilArr.shouldDoPackedUpdate() param : bool {
 // approach. What we really want is to do a naive transfer if the periodic
 // neighbor is the current locale.
 //
-proc StencilArr.updateFluff() {
+proc StencilArr.updateFluff(depth = dom.fluff, sides = makeZero(rank, int)) {
   if isZeroTuple(dom.fluff) then return;
 
+  const d = _checkFluffDepth(depth),
+        s = _checkFluffSides(sides);
+
   if shouldDoPackedUpdate() && dom.dist.targetLocales.size > 1 {
-    this._packedUpdate();
+    this._packedUpdate(d, s);
   } else {
-    this.naiveUpdateFluff();
+    this.naiveUpdateFluff(d, s);
   }
 }
 
+//
+// Start updating the caches in the background, returning a handle that
+// can be waited on.  Only one update may be in flight per array.
+//
+proc StencilArr.updateFluffAsync(depth = dom.fluff,
+                                 sides = makeZero(rank, int)) {
+  const d = _checkFluffDepth(depth),
+        s = _checkFluffSides(sides);
+  var handle = new shared StencilFluffUpdate();
+
+  begin with (in handle) {
+    this.updateFluff(d, s);
+    handle.done$.writeEF(true);
+  }
+
+  return handle;
+}
+
+proc StencilArr._checkFluffDepth(depth) {
+  const ret = chpl__tuplify(depth): rank*idxType;
+  for param d in 0..rank-1 do
+    if ret(d) < 0 || ret(d) > dom.fluff(d) then
+      halt("updateFluff: depth ", ret, " must be between 0 and the fluff ",
+           dom.fluff, " in each dimension");
+  return ret;
+}
+
+proc StencilArr._checkFluffSides(sides) {
+  const ret = chpl__tuplify(sides): rank*int;
+  for param d in 0..rank-1 do
+    if ret(d) < -1 || ret(d) > 1 then
+      halt("updateFluff: sides ", ret, " must be -1, 0 or 1 in each dimension");
+  return ret;
+}
+
 override proc StencilArr.dsiReallocate(bounds:rank*range(idxType,BoundedRangeType.bounded,stridable))
 {
   //
@@ -2103,3 +2230,59 @@ where !disableStencilDistBulkTransfer {
 
 override proc StencilArr.doiCanBulkTransferRankChange() param return true;
 
+
+config param debugStencilScan = false;
+
+// Same scheme as BlockArr.doiScan: each locale pre-scans its block (not its
+// fluff), the locale totals are combined in a log-depth exchange, and each
+// locale then adjusts its block of the result.
+proc StencilArr.doiScan(op, dom) where (rank == 1) &&
+                                       chpl__scanStateResTypesMatch(op) {
+
+  // The result of this scan, which will be Stencil-distributed as well
+  type resType = op.generate().type;
+  var res = dom.buildArray(resType, initElts=!isPOD(resType));
+
+  const ref targetLocs = this.dsiTargetLocales();
+  const boxes = chpl__scanMailboxes(resType, targetLocs);
+
+  coforall locid in dom.dist.targetLocDom {
+    on targetLocs[locid] {
+      const myop = op.clone();
+
+      ref myLocArrDesc = locArr[locid];
+      ref myLocArr = myLocArrDesc.myElems;
+      const myBlock = myLocArrDesc.locDom.myBlock[dom];
+
+      var (numTasks, rngs, state, tot) =
+        myLocArr._value.chpl__preScan(myop, res, myBlock);
+      if debugStencilScan then
+        writeln(locid, ": ", (numTasks, rngs, state, tot));
+
+      const myadjust = chpl__scanExclusivePrefix(myop, boxes,
+                         dom.dist.targetLocDom.indexOrder(locid), tot);
+      if debugStencilScan then
+        writeln(locid, ": myadjust = ", myadjust);
+
+      for s in state do
+        myop.accumulateOntoState(s, myadjust);
+
+      myLocArr._value.chpl__postScan(op, res, numTasks, rngs, state,
+                                     myBlock);
+
+      delete myop;
+    }
+  }
+  chpl__deleteScanMailboxes(boxes);
+  if isPOD(resType) then res.dsiElementInitializationComplete();
+
+  delete op;
+  return res;
+}
+
+// A block of a multidimensional array is not contiguous in row-major
+// order, so gather the scan order by segments instead.
+proc StencilArr.doiScan(op, dom) where (rank > 1) &&
+                                       chpl__scanStateResTypesMatch(op) {
+  return chpl__scanByGather(this, op, dom, debugStencilScan);
+}
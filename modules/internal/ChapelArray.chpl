@@ -172,10 +172,6 @@ module ChapelArray {
   use SysCTypes;
   use ChapelPrivatization;
 
-  // Explicitly use a processor atomic, as most calls to this function are
-  // likely be on locale 0
-  pragma "no doc"
-  var numPrivateObjects: chpl__processorAtomicType(int);
   pragma "no doc"
   param nullPid = -1;
 
@@ -227,6 +223,9 @@ module ChapelArray {
   //    relatively low overhead, adds work to Locale 0 that is not present on
   //    the other locales, and again would be surprising if a Block array were
   //    created over other locales only (say, Locales[2] and Locales[3]).
+  //    The runtime hands out ids there and recycles them once an object has
+  //    been freed on every locale, which keeps the privatization table small
+  //    for codes that create many temporary domains and arrays.
 
   // Given a dsi Dist/Dom/Array, create an pid integer identifying the
   // privatized version on all locales; and populate each locale
@@ -234,12 +233,16 @@ module ChapelArray {
   // without communication.
   proc _newPrivatizedClass(value) : int {
 
-    const n = numPrivateObjects.fetchAdd(1);
+    extern proc chpl_newPrivatizedPid(): int;
+
+    var n: int;
 
     const hereID = here.id;
     const privatizeData = value.dsiGetPrivatizeData();
-    on Locales[0] do
+    on Locales[0] {
+      n = chpl_newPrivatizedPid();
       _newPrivatizedClassHelp(value, value, n, hereID);
+    }
 
     proc _newPrivatizedClassHelp(parentValue, originalValue, n, hereID) {
       var newValue = originalValue;
@@ -276,6 +279,10 @@ module ChapelArray {
 
     on Locales[0] {
       _freePrivatizedClassHelp(pid, original);
+
+      // Every locale has cleared its entry, so the pid can be reused.
+      extern proc chpl_freePrivatizedPid(pid:int);
+      chpl_freePrivatizedPid(pid);
     }
 
     proc _freePrivatizedClassHelp(pid, original) {
@@ -20,6 +20,7 @@
 
 module ChapelAutoAggregation {
   private use CopyAggregation;
+  private use RMWAggregation;
 
   config param verboseAggregation = false;
 
@@ -60,6 +61,82 @@ module ChapelAutoAggregation {
     return nil;  // return type signals that we shouldn't aggregate
   }
 
+  pragma "aggregator generator"
+  proc chpl_rmwAggregatorFor(arr: [], iterand, param op: string) {
+    if chpl__rmwSupported(arr.eltType, op) &&
+       chpl__iterandSupportsRMWAggregation(iterand) then
+      return new RMWAggregator(arr.eltType, op);
+    else
+      return none;  // return type signals that we shouldn't aggregate
+  }
+
+  pragma "aggregator generator"
+  proc chpl_rmwAggregatorFor(arr, iterand, param op: string) {
+    return none;  // return type signals that we shouldn't aggregate
+  }
+
+  // recursive parallel iterators can't have task-private aggregators
+  private proc chpl__iterandSupportsRMWAggregation(const ref x) param {
+    return isArray(x) || isDomain(x) || isRange(x);
+  }
+
+  // Aggregated atomic updates are delayed until the aggregator is flushed,
+  // at the latest when the task running the forall body ends.  Only the
+  // end of the forall orders them with other memory operations.
+  private proc chpl__rmwSupported(type t, param op: string) param {
+    if isAtomicType(t) then
+      return ((op == "add" || op == "sub") && isNumericType(t.T)) ||
+             ((op == "or" || op == "and" || op == "xor") &&
+              isIntegralType(t.T));
+    else
+      return (isNumericType(t) || isBoolType(t)) &&
+             (op == "+=" || op == "-=" || op == "*=" || op == "&=" ||
+              op == "|=" || op == "^=");
+  }
+
+  // `A[e] op= v` or `A[e].op(v)` at the end of a forall body. `agg` is `none`
+  // if the update can't be aggregated. The compiler matched the update by
+  // name only, so in that case `A[e]` need not even be an lvalue: evaluate
+  // the update as it was written.
+  inline proc chpl__autoRMW(agg: nothing, A, e, v, param op: string) {
+    if op == "+=" then A[e] += v;
+    else if op == "-=" then A[e] -= v;
+    else if op == "*=" then A[e] *= v;
+    else if op == "&=" then A[e] &= v;
+    else if op == "|=" then A[e] |= v;
+    else if op == "^=" then A[e] ^= v;
+    else if op == "add" then A[e].add(v);
+    else if op == "sub" then A[e].sub(v);
+    else if op == "or" then A[e].or(v);
+    else if op == "and" then A[e].and(v);
+    else if op == "xor" then A[e].xor(v);
+    else compilerError("unknown read-modify-write operation: " + op);
+  }
+
+  inline proc chpl__autoRMW(ref agg: RMWAggregator(?), A, e, v,
+                            param op: string) {
+    ref dst = A[e];
+    if dst.locale.id == here.id then
+      chpl__applyRMW(dst, v, op);
+    else
+      agg.update(dst, v);
+  }
+
+  inline proc chpl__applyRMW(ref dst, v, param op: string) {
+    if op == "+=" then dst += v;
+    else if op == "-=" then dst -= v;
+    else if op == "*=" then dst *= v;
+    else if op == "&=" then dst &= v;
+    else if op == "|=" then dst |= v;
+    else if op == "^=" then dst ^= v;
+    else if op == "add" then dst.add(v);
+    else if op == "sub" then dst.sub(v);
+    else if op == "or" then dst.or(v);
+    else if op == "and" then dst.and(v);
+    else if op == "xor" then dst.xor(v);
+    else compilerError("unknown read-modify-write operation: " + op);
+  }
+
   private proc elemTypeSupportsAggregation(type t) param {
     return isPODType(t);
   }
@@ -286,6 +363,127 @@ module ChapelAutoAggregation {
 
   }
 
+  module RMWAggregation {
+    use SysCTypes;
+    use CPtr;
+    use AggregationPrimitives;
+
+    private const yieldFrequency = getEnvInt("CHPL_AGGREGATION_YIELD_FREQUENCY", 1024);
+    private const rmwBuffSize = getEnvInt("CHPL_AGGREGATION_RMW_BUFF_SIZE", 4096);
+
+    private proc rmwValType(type t) type {
+      if isAtomicType(t) then return t.T;
+      else return t;
+    }
+
+    /*
+     * Aggregates read-modify-write updates (`dst op= val`, or `dst.add(val)`
+     * and friends for atomics) by shipping (address, value) pairs to the
+     * locale that owns dst and applying them there. Consecutive updates to
+     * the same element are combined before they are shipped.
+     * Not parallel safe and is expected to be created on a per-task basis
+     * High memory usage since there are per-destination buffers
+     */
+    record RMWAggregator {
+      type elemType;
+      param op: string;
+      type valType = rmwValType(elemType);
+      type aggType = (c_ptr(elemType), valType);
+      const bufferSize = rmwBuffSize;
+      const myLocaleSpace = LocaleSpace;
+      var opsUntilYield = yieldFrequency;
+      var lBuffers: [myLocaleSpace] [0..#bufferSize] aggType;
+      var rBuffers: [myLocaleSpace] remoteBuffer(aggType);
+      var bufferIdxs: [myLocaleSpace] int;
+
+      proc postinit() {
+        for loc in myLocaleSpace {
+          rBuffers[loc] = new remoteBuffer(aggType, bufferSize, loc);
+        }
+      }
+
+      proc deinit() {
+        flush();
+      }
+
+      proc flush() {
+        for loc in myLocaleSpace {
+          _flushBuffer(loc, bufferIdxs[loc], freeData=true);
+        }
+      }
+
+      inline proc update(ref dst: elemType, const in val: valType) {
+        if verboseAggregation {
+          writeln("RMWAggregator.update is called");
+        }
+        const loc = dst.locale.id;
+        const dstAddr = getAddr(dst);
+
+        ref bufferIdx = bufferIdxs[loc];
+
+        // Combine with the previous update if it is to the same element,
+        // otherwise buffer the address and the value
+        if bufferIdx > 0 && lBuffers[loc][bufferIdx-1](0) == dstAddr {
+          ref prevVal = lBuffers[loc][bufferIdx-1](1);
+          prevVal = _combine(prevVal, val);
+        } else {
+          lBuffers[loc][bufferIdx] = (dstAddr, val);
+          bufferIdx += 1;
+        }
+
+        if bufferIdx == bufferSize {
+          _flushBuffer(loc, bufferIdx, freeData=false);
+          opsUntilYield = yieldFrequency;
+        } else if opsUntilYield == 0 {
+          chpl_task_yield();
+          opsUntilYield = yieldFrequency;
+        } else {
+          opsUntilYield -= 1;
+        }
+      }
+
+      // `dst op= a; dst op= b` is `dst op= _combine(a, b)`
+      inline proc _combine(a: valType, b: valType): valType {
+        if op == "+=" || op == "-=" || op == "add" || op == "sub" then
+          return a + b;
+        else if op == "*=" then
+          return a * b;
+        else if op == "&=" || op == "and" then
+          return a & b;
+        else if op == "|=" || op == "or" then
+          return a | b;
+        else
+          return a ^ b;
+      }
+
+      proc _flushBuffer(loc: int, ref bufferIdx, freeData) {
+        const myBufferIdx = bufferIdx;
+        if myBufferIdx == 0 then return;
+
+        // Allocate a remote buffer
+        ref rBuffer = rBuffers[loc];
+        const remBufferPtr = rBuffer.cachedAlloc();
+
+        // Copy local buffer to remote buffer
+        rBuffer.PUT(lBuffers[loc], myBufferIdx);
+
+        // Apply the updates on the owning locale
+        on Locales[loc] {
+          for (dstAddr, val) in rBuffer.localIter(remBufferPtr, myBufferIdx) {
+            chpl__applyRMW(dstAddr.deref(), val, op);
+          }
+          if freeData {
+            rBuffer.localFree(remBufferPtr);
+          }
+        }
+        if freeData {
+          rBuffer.markFreed();
+        }
+        bufferIdx = 0;
+      }
+    }
+  }
+
   module AggregationPrimitives {
     use CPtr;
     use SysCTypes;
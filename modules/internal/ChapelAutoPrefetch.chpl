@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Support for --auto-prefetch.  For `forall i in ... { ... A[idx[i]] ... }`
+// the compiler adds a call
+//
+//   chpl__autoPrefetch(A, idx, i);
+//
+// at the top of the loop body, which prefetches the element of `A` that
+// iteration `i + autoPrefetchDistance` is going to access.  Calls whose
+// arguments turn out not to be suitable arrays resolve to a no-op.
+module ChapelAutoPrefetch {
+  private use SysCTypes, CPtr;
+
+  /* How many iterations ahead of the current one to prefetch.  Setting
+     this to 0 turns off the prefetches added by ``--auto-prefetch``. */
+  config param autoPrefetchDistance = 16;
+
+  private proc chpl__idxTypeMatches(const ref A: [], const ref idx: []) param {
+    if A.rank == 1 then
+      return idx.eltType == A.idxType;
+    else
+      return idx.eltType == A.rank*A.idxType;
+  }
+
+  inline proc chpl__autoPrefetch(const ref A: [], const ref idx: [], i)
+  where autoPrefetchDistance > 0 && isIntegralType(i.type) &&
+        idx.rank == 1 && isPODType(A.eltType) &&
+        chpl__idxTypeMatches(A, idx) {
+    const j = i + autoPrefetchDistance;
+    if idx.domain.contains(j) {
+      const k = idx[j];
+      if A.domain.contains(k) then
+        chpl__prefetchElem(A[k]);
+    }
+  }
+
+  inline proc chpl__autoPrefetch(const ref A, const ref idx, i) { }
+
+  // Issue a prefetch for the element referred to by `elt` without waiting
+  // for it.  For a remote element this brings it into the remote cache if
+  // that is enabled; for a local one it is a processor prefetch.
+  private inline proc chpl__prefetchElem(const ref elt) {
+    extern proc chpl_gen_comm_prefetch(node: chpl_nodeID_t, raddr: c_void_ptr,
+                                       size: size_t, commID: int(32),
+                                       ln: c_int, fn: int(32));
+    const node = __primitive("_wide_get_node", elt);
+    const addr = __primitive("_wide_get_addr", elt);
+    chpl_gen_comm_prefetch(node, addr, c_sizeof(elt.type), -1,
+                           __primitive("_get_user_line"): c_int,
+                           __primitive("_get_user_file"));
+  }
+}
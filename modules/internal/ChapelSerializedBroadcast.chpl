@@ -48,28 +48,63 @@ module ChapelSerializedBroadcast {
       halt("internal error: can't broadcast module-scope arrays yet");
     } else {
       const data = localeZeroGlobal.chpl__serialize();
-      const root = here.id;
-      coforall loc in Locales do on loc {
-        if here.id != root {
-          pragma "no copy"
-          pragma "no auto destroy"
-          var temp = localeZeroGlobal.type.chpl__deserialize(data);
+      chpl__broadcastGlobalTree(localeZeroGlobal, id, data,
+                                here.id, 0, numLocales);
+    }
+  }
+
+  //
+  // The broadcast and destroy operations each spread out from the root
+  // locale along a binary tree of on-statements rather than having the
+  // root start one on-statement per locale.  A call handles the locales
+  // whose ids relative to the root are in [lo, hi), and runs on the
+  // first of those.  It starts the upper half of its range on the
+  // first locale of that half, and keeps splitting the lower half
+  // itself.  So the root starts only log2(numLocales) on-statements,
+  // and the whole broadcast completes in log2(numLocales) steps.
+  //
+  private proc chpl__treeLocale(root : int, rel : int) {
+    return Locales[(root + rel) % numLocales];
+  }
+
+  private proc chpl__broadcastGlobalTree(ref localeZeroGlobal, id : int,
+                                         const data, root : int,
+                                         lo : int, hi : int) {
+    if hi - lo == 1 {
+      if lo != 0 {
+        pragma "no copy"
+        pragma "no auto destroy"
+        var temp = localeZeroGlobal.type.chpl__deserialize(data);
 
-          const destVoidPtr = chpl_get_global_serialize_table(id);
-          const dest = destVoidPtr:c_ptr(localeZeroGlobal.type);
+        const destVoidPtr = chpl_get_global_serialize_table(id);
+        const dest = destVoidPtr:c_ptr(localeZeroGlobal.type);
 
-          __primitive("=", dest.deref(), temp);
-        }
+        __primitive("=", dest.deref(), temp);
+      }
+    } else {
+      const mid = (lo + hi) / 2;
+      cobegin {
+        on chpl__treeLocale(root, mid) do
+          chpl__broadcastGlobalTree(localeZeroGlobal, id, data,
+                                    root, mid, hi);
+        chpl__broadcastGlobalTree(localeZeroGlobal, id, data,
+                                  root, lo, mid);
       }
     }
   }
 
   proc chpl__destroyBroadcastedGlobal(ref localeZeroGlobal, id : int)
   where chpl__enableSerializedGlobals {
+    chpl__destroyBroadcastedGlobalTree(localeZeroGlobal, id,
+                                       here.id, 0, numLocales);
+  }
+
+  private proc chpl__destroyBroadcastedGlobalTree(ref localeZeroGlobal,
+                                                  id : int, root : int,
+                                                  lo : int, hi : int) {
     type globalType = localeZeroGlobal.type;
-    const root = here.id;
-    coforall loc in Locales do on loc {
-      if here.id != root {
+    if hi - lo == 1 {
+      if lo != 0 {
         const voidPtr = chpl_get_global_serialize_table(id);
         var ptr = voidPtr:c_ptr(globalType);
 
@@ -79,6 +114,15 @@ module ChapelSerializedBroadcast {
 
         chpl__autoDestroy(temp);
       }
+    } else {
+      const mid = (lo + hi) / 2;
+      cobegin {
+        on chpl__treeLocale(root, mid) do
+          chpl__destroyBroadcastedGlobalTree(localeZeroGlobal, id,
+                                             root, mid, hi);
+        chpl__destroyBroadcastedGlobalTree(localeZeroGlobal, id,
+                                           root, lo, mid);
+      }
     }
   }
 }
@@ -66,6 +66,7 @@ module ChapelStandard {
   public use ChapelSerializedBroadcast;
   public use ExportWrappers;
   public use ChapelAutoAggregation;
+  public use ChapelAutoPrefetch;
 
   // Standard modules.
   public use Builtins;
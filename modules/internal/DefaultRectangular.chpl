@@ -2255,9 +2255,9 @@ module DefaultRectangular {
 
   config param debugDRScan = false;
 
-  /* This computes a 1D scan in parallel on the array, for 1D arrays only */
-  proc DefaultRectangularArr.doiScan(op, dom) where (rank == 1) &&
-                                                chpl__scanStateResTypesMatch(op) {
+  /* This computes a scan in parallel on the array.  Multidimensional
+     arrays are scanned in row-major order. */
+  proc DefaultRectangularArr.doiScan(op, dom) where chpl__scanStateResTypesMatch(op) {
     use RangeChunk;
 
     type resType = op.generate().type;
@@ -2269,7 +2269,7 @@ module DefaultRectangular {
     // Take second pass updating result based on the scanned 'state' if there
     // are multiple tasks
     if numTasks > 1 {
-      this.chpl__postScan(op, res, numTasks, rngs, state);
+      this.chpl__postScan(op, res, numTasks, rngs, state, dom);
     }
     if isPOD(resType) then res.dsiElementInitializationComplete();
 
@@ -2327,8 +2327,9 @@ module DefaultRectangular {
   // distributed array scans.
   proc DefaultRectangularArr.chpl__preScan(op, res: [] ?resType, dom) {
     import RangeChunk;
-    // Compute who owns what
-    const rng = dom.dim(0);
+    // Compute who owns what.  For multidimensional arrays, chunk the
+    // row-major positions of the indices instead of the indices themselves.
+    const rng = if rank == 1 then dom.dim(0) else 0..#dom.sizeAs(int);
     const numTasks = if __primitive("task_get_serial") then
                       1 else _computeNumChunks(rng.sizeAs(int));
     const rngs = RangeChunk.chunks(rng, numTasks);
@@ -2343,12 +2344,14 @@ module DefaultRectangular {
     coforall tid in rngs.indices {
       const current: resType;
       const myop = op.clone();
-      for i in rngs[tid] {
+      for i in chpl__scanIndices(dom, rngs[tid]) {
         ref elem = dsiAccess(i);
         myop.accumulate(elem);
         res[i] = myop.generate();
       }
-      state[tid] = res[rngs[tid].high];
+      state[tid] = if rngs[tid].sizeAs(int) > 0
+                     then res[chpl__scanLastIndex(dom, rngs[tid])]
+                     else myop.generate();
       delete myop;
     }
 
@@ -2374,11 +2377,13 @@ module DefaultRectangular {
   // A second helper routine that does the second parallel pass over
   // the result vector adding the prefix state computed by the earlier
   // tasks.  This is broken out into a helper function in order to be
-  // made use of by distributed array scans.
-  proc DefaultRectangularArr.chpl__postScan(op, res, numTasks, rngs, state) {
+  // made use of by distributed array scans.  'dom' must be the domain
+  // that was passed to chpl__preScan, since 'rngs' are positions in it.
+  proc DefaultRectangularArr.chpl__postScan(op, res, numTasks, rngs, state,
+                                            dom) {
     coforall tid in rngs.indices {
       const myadjust = state[tid];
-      for i in rngs[tid] {
+      for i in chpl__scanIndices(dom, rngs[tid]) {
         op.accumulateOntoState(res[i], myadjust);
       }
     }
@@ -2387,6 +2392,42 @@ module DefaultRectangular {
       writeln("res = ", res);
   }
 
+  // The indices covered by one chunk of a scan.  For 1D arrays 'rng' is
+  // a range of indices.  Otherwise it is a range of row-major positions,
+  // and the indices are stepped like an odometer rather than recomputed
+  // from each position.
+  iter chpl__scanIndices(dom, rng: range) {
+    if dom.rank == 1 {
+      for i in rng do yield i;
+    } else if rng.sizeAs(int) > 0 {
+      param rank = dom.rank;
+      const dims = dom.dims();
+      var ctr: rank*int;
+      var idx = dom.orderToIndex(rng.low);
+      for param d in 0..rank-1 do
+        ctr(d) = ((idx(d) - dims(d).first) / dims(d).stride): int;
+
+      for 1..rng.sizeAs(int) {
+        yield idx;
+        var d = rank-1;
+        while d >= 0 {
+          ctr(d) += 1;
+          if ctr(d) < dims(d).sizeAs(int) {
+            idx(d) = dims(d).first + (ctr(d) * dims(d).stride): dom.idxType;
+            break;
+          }
+          ctr(d) = 0;
+          idx(d) = dims(d).first;
+          d -= 1;
+        }
+      }
+    }
+  }
+
+  proc chpl__scanLastIndex(dom, rng: range) {
+    return if dom.rank == 1 then rng.high else dom.orderToIndex(rng.high);
+  }
+
 
 
   /*
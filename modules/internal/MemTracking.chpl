@@ -31,6 +31,7 @@ module MemTracking
     memLeaks: bool = false,
     memMax: uint = 0,
     memThreshold: uint = 0,
+    memTrackSample: uint = 0,
     memLog: string;
 
   pragma "no auto destroy"
@@ -54,9 +55,11 @@ module MemTracking
   config const
     memLeaksByDesc: string;
 
-  // Safely cast to size_t instances of memMax and memThreshold.
+  // Safely cast to size_t instances of memMax, memThreshold, and
+  // memTrackSample.
   const cMemMax = memMax.safeCast(size_t),
-    cMemThreshold = memThreshold.safeCast(size_t);
+    cMemThreshold = memThreshold.safeCast(size_t),
+    cMemTrackSample = memTrackSample.safeCast(size_t);
 
   //
   // This communicates the settings of the various memory tracking
@@ -78,6 +81,7 @@ module MemTracking
                                          ref ret_memLeaks: bool,
                                          ref ret_memMax: size_t,
                                          ref ret_memThreshold: size_t,
+                                         ref ret_memTrackSample: size_t,
                                          ref ret_memLog: c_string,
                                          ref ret_memLeaksLog: c_string) {
     ret_memTrack = memTrack;
@@ -86,6 +90,7 @@ module MemTracking
     ret_memLeaks = memLeaks;
     ret_memMax = cMemMax;
     ret_memThreshold = cMemThreshold;
+    ret_memTrackSample = cMemTrackSample;
 
     if (here.id != 0) {
       if memLeaksByDesc.size != 0 {
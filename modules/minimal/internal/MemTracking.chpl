@@ -35,6 +35,7 @@ module MemTracking
                                          ref ret_memLeaksTable: bool,
                                          ref ret_memMax: uint(64),       // **
                                          ref ret_memThreshold: uint(64), // **
+                                         ref ret_memTrackSample: uint(64), // **
                                          ref ret_memLog: c_string,
                                          ref ret_memLeaksLog: c_string) {
 
@@ -60,21 +60,58 @@
        }
      }
 
-   The implementation is dependent on the communication layer and the
-   underlying hardware, but typically some sort of tree or dissemination based
-   barrier that's optimized for the network will be used.
+   Tasks on each locale first combine their arrivals through a tree of
+   counters on that locale.  The last task to arrive on each locale then
+   takes part in a dissemination barrier across locales: in round `r` it
+   signals the locale `2**r` ahead of it with a remote atomic add and waits
+   for the signal from the locale `2**r` behind it, so the barrier completes
+   in `ceil(log2(numLocales))` rounds with no locale acting as a hot spot.
 */
 module AllLocalesBarriers {
   use BlockDist, Barriers;
 
+  /* The part of the global barrier that lives on one locale. */
+  pragma "no doc"
+  class LocaleBarrier: treeBarrier {
+    const locId: int;
+    const numRounds: int;
+    var roundFlags: [0..#numRounds] atomic int;
+    var partners: [0..#numRounds] unmanaged LocaleBarrier?;
+    var episode: int;
+
+    proc init(numTasksPerLocale: int) {
+      super.init(numTasksPerLocale, reusable=true);
+      locId = here.id;
+      var rounds = 0;
+      while (1 << rounds) < numLocales do rounds += 1;
+      numRounds = rounds;
+    }
+
+    // Only the last task to arrive on this locale gets here, so episode
+    // needs no protection.  The flags only ever grow, which lets a partner
+    // that is already one episode ahead signal us without confusion.
+    override proc allArrived() {
+      episode += 1;
+      for r in 0..#numRounds {
+        partners[r]!.roundFlags[r].add(1);
+        while roundFlags[r].read() < episode do chpl_task_yield();
+      }
+    }
+  }
+
   pragma "no doc"
   class AllLocalesBarrier: BarrierBaseType {
 
     const BarrierSpace = LocaleSpace dmapped Block(LocaleSpace);
-    var globalBarrier: [BarrierSpace] unmanaged aBarrier(reusable=true, procAtomics=true, hackIntoCommBarrier=true);
+    var globalBarrier: [BarrierSpace] unmanaged LocaleBarrier;
 
     proc init(numTasksPerLocale: int) {
-      globalBarrier = [b in BarrierSpace] new unmanaged aBarrier(numTasksPerLocale, reusable=true, procAtomics=true, hackIntoCommBarrier=true);
+      globalBarrier = [b in BarrierSpace] new unmanaged LocaleBarrier(numTasksPerLocale);
+      this.complete();
+      forall b in globalBarrier {
+        for r in 0..#b.numRounds do
+          b.partners[r] = globalBarrier[(b.locId + (1 << r)) % numLocales];
+      }
     }
 
     proc deinit() {
@@ -33,6 +33,7 @@ module DistributedIters
 use DynamicIters,
     Time,
     DSIUtil;
+private use ChapelLocks;
 
 /*
   Toggle debugging output.
@@ -568,6 +569,305 @@ where tag == iterKind.follower
   for i in current do yield i;
 }
 
+// Distributed Work-Stealing Iterator.
+// Serial version.
+/*
+  :arg c: The range (or domain) to iterate over. The range (domain) size must
+    be positive.
+  :type c: `range(?)` or `domain`
+
+  :arg chunkSize: The chunk size to yield to each task. Must be positive.
+    Defaults to 1.
+  :type chunkSize: `int`
+
+  :arg numTasks: The number of tasks to use. Must be nonnegative. If this
+    argument has value 0, the iterator will use the value indicated by
+    ``dataParTasksPerLocale``.
+  :type numTasks: int
+
+  :arg parDim: If ``c`` is a domain, then this specifies the dimension index
+    to parallelize across. Must be non-negative and less than the rank of
+    the domain ``c``. Defaults to 0.
+  :type parDim: int
+
+  :arg localeChunkSize: The number of iterations a locale takes from its
+    work pool at a time, and the smallest number it steals from another
+    locale. Must be nonnegative. If this argument has value 0, the iterator
+    will use an undefined heuristic in an attempt to choose a value that will
+    perform well.
+  :type localeChunkSize: `int`
+
+  :arg coordinated: If true (and multi-locale), then have the locale invoking
+    the iterator coordinate task distribution only; that is, disallow it from
+    receiving work.
+  :type coordinated: bool
+
+  :arg workerLocales: An array of locales over which to distribute the work.
+    Defaults to ``Locales`` (all available locales).
+  :type workerLocales: [] locale
+
+  :yields: Indices in the range ``c``.
+
+  This iterator balances load hierarchically without a central counter.
+
+  Given an input range (or domain) ``c``, each worker locale starts with a
+  pool holding its own contiguous block of ``c``, split the same way as a
+  ``Block`` distribution over the worker locales. A locale takes chunks of
+  ``localeChunkSize`` iterations from the front of its pool and distributes
+  sub-chunks of size ``chunkSize`` to its tasks, using the ``dynamic``
+  iterator from the ``DynamicIters`` module. Only when its pool is empty does
+  a locale visit the other worker locales in turn, stealing half of the
+  first non-empty pool it finds from the back. The stolen iterations refill
+  its own pool, so they can be stolen again in turn. A locale stops once
+  every other pool is empty.
+
+  Since locales only communicate once they run out of their own work, this
+  iterator suits irregular loops whose work is mostly balanced, and keeps
+  each locale on the part of ``c`` a ``Block`` distribution would give it.
+
+  Available for serial and zippered contexts.
+*/
+iter distributedWorkStealing(c,
+                             chunkSize:int=1,
+                             numTasks:int=0,
+                             parDim:int=0,
+                             localeChunkSize:int=0,
+                             coordinated:bool=false,
+                             workerLocales=Locales)
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Work-stealing iterator (serial): must "
+                  + "use a valid domain or range"),
+                 1);
+  if debugDistributedIters
+  then writeln("DistributedIters: Work-stealing iterator (serial): working ",
+               "with ", (if isDomain(c) then "domain " else "range "), c);
+  for i in c do yield i;
+}
+
+// Zippered leader.
+pragma "no doc"
+iter distributedWorkStealing(param tag:iterKind,
+                             c,
+                             chunkSize:int=1,
+                             numTasks:int=0,
+                             parDim:int=0,
+                             localeChunkSize:int=0,
+                             coordinated:bool=false,
+                             workerLocales=Locales)
+where tag == iterKind.leader
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Work-stealing iterator (leader): must "
+                  + "use a valid domain or range"),
+                 1);
+  assert(chunkSize > 0,
+         ("DistributedIters: Work-stealing iterator (leader): "
+          + "chunkSize must be a positive integer"));
+  assert(localeChunkSize >= 0,
+         ("DistributedIters: Work-stealing iterator (leader): "
+          + "localeChunkSize must be a nonnegative integer"));
+
+  type cType = c.type;
+
+  if isDomain(c) then
+  {
+    assert(c.rank > 0, ("DistributedIters: Work-stealing iterator (leader): "
+                        + "Must use a valid domain"));
+    assert(parDim >= 0, ("DistributedIters: Work-stealing iterator (leader): "
+                        + "parDim must be a non-negative integer"));
+    assert(parDim < c.rank, ("DistributedIters: Work-stealing iterator "
+                             + "(leader): parDim must be a dimension of the "
+                             + "domain"));
+    var parDimDim = c.dim(parDim);
+    for t in distributedWorkStealing(tag=iterKind.leader,
+                                     c=parDimDim,
+                                     chunkSize=chunkSize,
+                                     numTasks=numTasks,
+                                     parDim=0,
+                                     localeChunkSize=localeChunkSize,
+                                     coordinated=coordinated,
+                                     workerLocales=workerLocales)
+    {
+      var tempDom : cType = computeZeroBasedDomain(c);
+      var tempTup = tempDom.dims();
+      tempTup(parDim) = t(0);
+      yield tempTup;
+    }
+  }
+  else // c is a range.
+  {
+    const iterCount = c.size;
+
+    if iterCount == 0 then halt("DistributedIters: Work-stealing iterator ",
+                                "(leader): the range is empty");
+
+    const denseRange:cType = densify(c,c);
+
+    if iterCount == 1
+       || numTasks == 1 && numLocales == 1
+    then
+    {
+      if debugDistributedIters
+      then writeln("DistributedIters: Work-stealing iterator (leader): ",
+                   "serial execution due to insufficient work or compute ",
+                   "resources");
+      yield (denseRange,);
+    }
+    else
+    {
+      const numWorkerLocales = workerLocales.size;
+      const masterLocale = here.locale;
+
+      const actualWorkerLocales =
+        [L in workerLocales] if numLocales == 1
+                                || !coordinated
+                                || L != masterLocale
+                             then L;
+      const nPools = actualWorkerLocales.size;
+
+      if infoDistributedIters then
+      {
+        const actualWorkerLocaleIds = [L in actualWorkerLocales] L.id:string;
+        const actualWorkerLocaleIdsSorted = actualWorkerLocaleIds.sorted();
+        writeln("DistributedIters: distributedWorkStealing:");
+        writeln("  coordinated = ", coordinated);
+        writeln("  numLocales = ", numLocales);
+        writeln("  numWorkerLocales = ", numWorkerLocales);
+        writeln("  actualWorkerLocales.size = ", nPools);
+        writeln("  masterLocale.id = ", masterLocale.id);
+        writeln("  actualWorkerLocaleIds = [ ",
+                ", ".join(actualWorkerLocaleIdsSorted),
+                " ]");
+      }
+
+      var localeTimes:[0..#numLocales]real;
+      var totalTime:Timer;
+      if timeDistributedIters then totalTime.start();
+
+      // TODO: Find a better heuristic backed by experimentation
+      const computedSize = if localeChunkSize == 0
+                           then denseRange.size / nPools / 10
+                           else localeChunkSize;
+      // localeChunkSize should not be less than chunkSize
+      const actualLocaleChunkSize = max(computedSize, chunkSize);
+
+      // Seed each locale's pool with its Block-distributed share.
+      var poolsTemp:[0..#nPools] unmanaged WorkStealingPool?;
+      coforall (L, poolIdx) in zip(actualWorkerLocales, 0..#nPools)
+      with (ref poolsTemp)
+      do on L
+      {
+        const (lo, hi) = _computeBlock(iterCount, nPools, poolIdx,
+                                       iterCount-1);
+        poolsTemp[poolIdx] = new unmanaged WorkStealingPool(lo:int, hi:int);
+      }
+      const pools = poolsTemp!; //#15080
+
+      coforall (L, poolIdx) in zip(actualWorkerLocales, 0..#nPools)
+      with (ref localeTimes)
+      do on L
+      {
+        var localeTime:Timer;
+        if timeDistributedIters then localeTime.start();
+
+        // Keep the victims local; stealing then only touches their pools.
+        const myPools = pools;
+        const myPool = myPools[poolIdx];
+
+        while true
+        {
+          var localeRange = myPool.take(actualLocaleChunkSize);
+
+          if localeRange.size == 0 then
+          {
+            for offset in 1..<nPools
+            {
+              const victim = myPools[(poolIdx + offset) % nPools];
+              var stolen:range;
+              on victim do stolen = victim.steal(actualLocaleChunkSize);
+              if stolen.size > 0 then
+              {
+                if debugDistributedIters
+                then writeln("DistributedIters: Work-stealing iterator ",
+                             "(leader): ", here.locale, ": stole ", stolen,
+                             " from ", victim.locale);
+                myPool.refill(stolen);
+                break;
+              }
+            }
+            localeRange = myPool.take(actualLocaleChunkSize);
+            if localeRange.size == 0 then break;
+          }
+
+          const denseLocaleRange:cType = localeRange;
+          for denseTaskRangeTuple in DynamicIters.dynamic(tag=iterKind.leader,
+                                                          denseLocaleRange,
+                                                          chunkSize,
+                                                          numTasks)
+          {
+            const taskRange:cType = unDensify(denseTaskRangeTuple(0),
+                                              denseLocaleRange);
+            if debugDistributedIters
+            then writeln("DistributedIters: Work-stealing iterator ",
+                         "(leader): ", here.locale, ": yielding ",
+                         unDensify(taskRange,c), " (", taskRange.size,
+                         "/", denseLocaleRange.size,
+                         " locale-owned of ", iterCount,
+                         " total) as ", taskRange);
+            yield (taskRange,);
+          }
+        }
+
+        if timeDistributedIters then
+        {
+          localeTime.stop();
+          localeTimes[here.id] = localeTime.elapsed();
+        }
+      }
+
+      coforall pool in pools do on pool do delete pool;
+
+      if timeDistributedIters then
+      {
+        totalTime.stop();
+        writeTimeStatistics(totalTime.elapsed(), localeTimes, coordinated);
+      }
+    }
+  }
+}
+
+// Zippered follower.
+pragma "no doc"
+iter distributedWorkStealing(param tag:iterKind,
+                             c,
+                             chunkSize:int,
+                             numTasks:int,
+                             parDim:int,
+                             localeChunkSize:int,
+                             coordinated:bool,
+                             workerLocales=Locales,
+                             followThis)
+where tag == iterKind.follower
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Work-stealing iterator (follower): must "
+                  + "use a valid domain or range"),
+                 1);
+  const current = if isDomain(c)
+                  then c.these(tag=iterKind.follower, followThis=followThis)
+                  else unDensify(followThis(0), c);
+
+  if debugDistributedIters
+  then writeln("DistributedIters: Work-stealing iterator (follower): ",
+               here.locale, ": received ",
+               if isDomain(c) then "domain " else "range ",
+               followThis, " (", current.size,
+               "/", c.size, "); shifting to ", current);
+
+  for i in current do yield i;
+}
+
 /*
   Helpers.
 */
@@ -651,6 +951,56 @@ private proc guidedSubrange(c:range(?),
   return subrange;
 }
 
+// Work pool for distributedWorkStealing.
+/*
+  Holds the dense iterations ``lo..hi`` a locale has yet to run. The owning
+  locale takes chunks from the front; other locales steal from the back.
+*/
+pragma "no doc"
+class WorkStealingPool
+{
+  var lo, hi:int;
+  var lock:chpl_LocalSpinlock;
+
+  proc init(lo:int, hi:int)
+  {
+    this.lo = lo;
+    this.hi = hi;
+  }
+
+  // Remove up to the first 'chunkSize' iterations.
+  proc take(chunkSize:int):range
+  {
+    lock.lock();
+    const r = lo..min(hi, lo + chunkSize - 1);
+    if r.size > 0 then lo = r.high + 1;
+    lock.unlock();
+    return r;
+  }
+
+  // Remove the last half of the iterations, but at least 'minSize' of them
+  // if there are that many.
+  proc steal(minSize:int):range
+  {
+    lock.lock();
+    const remaining = max(hi - lo + 1, 0);
+    const count = min(max(remaining / 2, minSize), remaining);
+    const r = (hi - count + 1)..hi;
+    hi -= count;
+    lock.unlock();
+    return r;
+  }
+
+  // Replace the (empty) pool with stolen iterations.
+  proc refill(r:range)
+  {
+    lock.lock();
+    lo = r.low;
+    hi = r.high;
+    lock.unlock();
+  }
+}
+
 // Per-locale time statistics.
 /*
   :arg wallTime: The wall time statistic.
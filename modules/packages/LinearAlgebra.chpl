@@ -188,6 +188,7 @@ module LinearAlgebra {
 
 import BLAS;
 use LAPACK only lapack_memory_order, isLAPACKType;
+private use CPtr;
 
 /* Determines if using native Chapel implementations */
 private param usingBLAS = BLAS.header != '';
@@ -601,17 +602,31 @@ proc dot(a, B: []) where isNumeric(a) {
 
 /* Explicit matrix-(matrix|vector) multiplication */
 private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
-  // matrix-vector
-  if Adom.rank == 2 && Bdom.rank == 1 then
-    return _matvecMult(A, B);
-  // vector-matrix
-  else if Adom.rank == 1 && Bdom.rank == 2 then
-    return _matvecMult(B, A, trans=true);
-  // matrix-matrix
-  else if Adom.rank == 2 && Bdom.rank == 2 then
-    return _matmatMult(A, B);
-  else
-    compilerError("Ranks are not 1 or 2");
+  if isDistributed(A) || isDistributed(B) {
+    // matrix-vector
+    if Adom.rank == 2 && Bdom.rank == 1 then
+      return _distMatvecMult(A, B);
+    // vector-matrix
+    else if Adom.rank == 1 && Bdom.rank == 2 then
+      return _distMatvecMult(B, A, trans=true);
+    // matrix-matrix
+    else if Adom.rank == 2 && Bdom.rank == 2 then
+      return _distMatmatMult(A, B);
+    else
+      compilerError("Ranks are not 1 or 2");
+  } else {
+    // matrix-vector
+    if Adom.rank == 2 && Bdom.rank == 1 then
+      return _matvecMult(A, B);
+    // vector-matrix
+    else if Adom.rank == 1 && Bdom.rank == 2 then
+      return _matvecMult(B, A, trans=true);
+    // matrix-matrix
+    else if Adom.rank == 2 && Bdom.rank == 2 then
+      return _matmatMult(A, B);
+    else
+      compilerError("Ranks are not 1 or 2");
+  }
 }
 
 
@@ -809,57 +824,493 @@ proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
 }
 
 pragma "no doc"
-/* Helper for Generic matrix-matrix multiplication */
+/* Helper for Generic matrix-matrix multiplication
+
+   Computes ``CMat += AMat * BMat`` with a packed, cache-blocked kernel
+   in the style of GotoBLAS/BLIS:
+
+   * ``C`` is split into a 2D grid of tiles, one per task.
+   * Within a tile, the ``jc`` loop steps over ``NC``-wide column panels
+     of ``B``, the ``pc`` loop over ``KC``-deep slices of the shared
+     dimension, and the ``ic`` loop over ``MC``-tall row blocks of ``A``.
+     ``KC``, ``MC`` and ``NC`` are sized so that a micro-panel pair
+     stays in L1, a packed block of ``A`` in L2, and a packed panel of
+     ``B`` in the task's share of L3.
+   * The current block of ``A`` and panel of ``B`` are packed into
+     aligned buffers as ``MR``-row and ``NR``-column micro-panels, so
+     the micro-kernel reads both with unit stride.
+   * The micro-kernel keeps an ``MR x NR`` block of ``C`` in a tuple,
+     which the backend can hold in (vector) registers.
+*/
 proc _matmatMultHelper(ref AMat: [?Adom] ?eltType,
                        ref BMat : [?Bdom] eltType,
-                       ref CMat : [] eltType)
+                       ref CMat : [?Cdom] eltType)
 {
-  // TODO - Add logic to calculate blockSize
-  // based on eltType and L1 cache size
-  const blockSize = 32;
-  const bVecRange = 0..#blockSize;
-  const blockDom = {bVecRange, bVecRange};
+  private use RangeChunk;
+
+  param MR = _gemmMR(eltType),
+        NR = _gemmNR(eltType);
+
+  const m = Adom.shape(0),
+        k = Adom.shape(1),
+        n = Bdom.shape(1);
+  if m == 0 || n == 0 || k == 0 then return;
+
+  const (MCmax, KCmax, NCmax) = _gemmBlockSizes(eltType, MR, NR);
+
+  //
+  // Lay the tasks out in a tM x tN grid whose tiles of C are as close
+  // to square as we can make them.
+  //
+  const numTasks = max(1, min(here.maxTaskPar,
+                              divceil(m, MR) * divceil(n, NR)));
+  var tM = 1;
+  for t in 1..numTasks {
+    if numTasks % t == 0 &&
+       abs(m:real/t - n:real/(numTasks/t)) <
+       abs(m:real/tM - n:real/(numTasks/tM)) then
+      tM = t;
+  }
+  const tN = numTasks / tM;
+
+  coforall tid in 0..#numTasks {
+    const myRows = chunk(0..#m, tM, tid / tN),
+          myCols = chunk(0..#n, tN, tid % tN);
+
+    if myRows.size > 0 && myCols.size > 0 {
+      const KC = min(KCmax, k),
+            MC = min(MCmax, divceil(myRows.size, MR) * MR),
+            NC = min(NCmax, divceil(myCols.size, NR) * NR);
+
+      var Ap = c_aligned_alloc(eltType, 64, MC * KC),
+          Bp = c_aligned_alloc(eltType, 64, KC * NC);
+
+      for jc in myCols by NC {
+        const nc = min(NC, myCols.high - jc + 1);
+        for pc in 0..#k by KC {
+          const kc = min(KC, k - pc);
+          _gemmPackB(BMat, Bp, pc, jc, kc, nc, NR);
+          for ic in myRows by MC {
+            const mc = min(MC, myRows.high - ic + 1);
+            _gemmPackA(AMat, Ap, ic, pc, mc, kc, MR);
+            _gemmMacroKernel(Ap, Bp, CMat, ic, jc, mc, nc, kc, MR, NR);
+          }
+        }
+      }
+
+      c_free(Ap);
+      c_free(Bp);
+    }
+  }
+}
+
+pragma "no doc"
+/* Micro-tile height for the packed matrix-matrix multiplication */
+private proc _gemmMR(type eltType) param {
+  if eltType == real(32) then return 16;
+  else if eltType == real(64) then return 8;
+  else if eltType == complex(64) then return 8;
+  else if eltType == complex(128) then return 4;
+  else return 4;
+}
+
+pragma "no doc"
+/* Micro-tile width for the packed matrix-matrix multiplication */
+private proc _gemmNR(type eltType) param {
+  if eltType == complex(128) then return 2;
+  else return 4;
+}
+
+pragma "no doc"
+/*
+   Returns the ``(MC, KC, NC)`` cache blocking for the packed
+   matrix-matrix multiplication, sized from the caches of ``here``.
+   Unknown cache sizes get typical values.
+*/
+private proc _gemmBlockSizes(type eltType, param MR, param NR) {
+  use SysCTypes;
+  extern proc chpl_topo_getCacheSize(level: c_int): size_t;
+
+  proc cacheSize(level: int, dflt: int) {
+    const s = chpl_topo_getCacheSize(level: c_int): int;
+    return if s > 0 then s else dflt;
+  }
+
+  const L1 = cacheSize(1, 32 * 1024),
+        L2 = cacheSize(2, 256 * 1024),
+        L3 = cacheSize(3, 8 * 1024 * 1024);
+  const eltSize = numBytes(eltType);
+
+  // An MR x KC sliver of A and a KC x NR sliver of B fill half of L1.
+  const KC = max(L1 / 2 / (eltSize * (MR + NR)), 16);
+  // An MC x KC packed block of A fills half of L2.
+  const MC = max(L2 / 2 / (eltSize * KC) / MR * MR, MR);
+  // A KC x NC packed panel of B fills half of this task's share of L3.
+  const NC = max(L3 / 2 / here.maxTaskPar / (eltSize * KC) / NR * NR, NR);
+
+  return (MC, KC, NC);
+}
+
+pragma "no doc"
+/*
+   Packs ``A[ic..#mc, pc..#kc]`` (0-based) into ``Ap`` as a sequence of
+   ``MR``-row micro-panels, each stored column by column.  Rows past
+   the end of the block are zero-filled.
+*/
+private proc _gemmPackA(const ref AMat: [?Adom] ?eltType, Ap: c_ptr(eltType),
+                        ic: int, pc: int, mc: int, kc: int, param MR) {
   const (Adim0, Adim1) = Adom.dims();
+  const iOff = Adim0.low + ic,
+        kOff = Adim1.low + pc;
+
+  for ir in 0..#mc by MR {
+    const mr = min(MR, mc - ir);
+    const panel = Ap + ir * kc;
+    for p in 0..#kc {
+      for i in 0..#mr do
+        panel[p*MR + i] = AMat[iOff + ir + i, kOff + p];
+      for i in mr..<MR do
+        panel[p*MR + i] = 0:eltType;
+    }
+  }
+}
+
+pragma "no doc"
+/*
+   Packs ``B[pc..#kc, jc..#nc]`` (0-based) into ``Bp`` as a sequence of
+   ``NR``-column micro-panels, each stored row by row.  Columns past
+   the end of the panel are zero-filled.
+*/
+private proc _gemmPackB(const ref BMat: [?Bdom] ?eltType, Bp: c_ptr(eltType),
+                        pc: int, jc: int, kc: int, nc: int, param NR) {
   const (Bdim0, Bdim1) = Bdom.dims();
+  const kOff = Bdim0.low + pc,
+        jOff = Bdim1.low + jc;
+
+  for jr in 0..#nc by NR {
+    const nr = min(NR, nc - jr);
+    const panel = Bp + jr * kc;
+    for p in 0..#kc {
+      for j in 0..#nr do
+        panel[p*NR + j] = BMat[kOff + p, jOff + jr + j];
+      for j in nr..<NR do
+        panel[p*NR + j] = 0:eltType;
+    }
+  }
+}
 
-  const numTasks = min(here.maxTaskPar, Bdom.shape(1));
-  coforall tid in 0..#numTasks {
-    const myChunk = chunk(Bdim1, numTasks, tid);
+pragma "no doc"
+/*
+   Multiplies the packed ``mc x kc`` block of A by the packed
+   ``kc x nc`` panel of B, accumulating into ``C[ic..#mc, jc..#nc]``
+   (0-based), one ``MR x NR`` micro-tile at a time.
+*/
+private proc _gemmMacroKernel(Ap: c_ptr(?eltType), Bp: c_ptr(eltType),
+                              ref CMat: [?Cdom] eltType,
+                              ic: int, jc: int, mc: int, nc: int, kc: int,
+                              param MR, param NR) {
+  const (Cdim0, Cdim1) = Cdom.dims();
+  const iOff = Cdim0.low + ic,
+        jOff = Cdim1.low + jc;
+
+  for jr in 0..#nc by NR {
+    const nr = min(NR, nc - jr);
+    for ir in 0..#mc by MR {
+      const mr = min(MR, mc - ir);
+
+      var ab: (MR*NR)*eltType;
+      _gemmMicroKernel(kc, Ap + ir * kc, Bp + jr * kc, ab);
+
+      for j in 0..#nr do
+        for i in 0..#mr do
+          CMat[iOff + ir + i, jOff + jr + j] += ab[j*MR + i];
+    }
+  }
+}
 
-    var AA: [blockDom] eltType,
-        BB: [blockDom] eltType,
-        CC: [blockDom] eltType;
+pragma "no doc"
+/*
+   The register-tiled micro-kernel: ``ab += Ap * Bp`` for one ``MR``-row
+   micro-panel of A and one ``NR``-column micro-panel of B.  The param
+   loops unroll fully, so ``ab`` can live in registers and each step of
+   ``p`` is a set of independent multiply-adds the backend can
+   vectorize.
+*/
+private inline proc _gemmMicroKernel(kc: int, a: c_ptr(?eltType),
+                                     b: c_ptr(eltType),
+                                     ref ab: ?abType) {
+  param MR = _gemmMR(eltType),
+        NR = _gemmNR(eltType);
+
+  for p in 0..#kc {
+    const ap = a + p*MR,
+          bp = b + p*NR;
+    for param j in 0..<NR {
+      const bj = bp[j];
+      for param i in 0..<MR do
+        ab[j*MR + i] += ap[i] * bj;
+    }
+  }
+}
 
-    for (jj,kk) in {myChunk by blockSize, Bdim0 by blockSize} {
-      const jMax = min(jj+blockSize-1, myChunk.high);
-      const kMax = min(kk+blockSize-1, Bdim0.high);
-      const jRange = 0..jMax-jj;
-      const kRange = 0..kMax-kk;
+pragma "no doc"
+/* Width of the shared-dimension panels used by the distributed kernels */
+private param _summaPanelWidth = 256;
 
-      for (jB, j) in zip(jj..jMax, 0..) do
-        for (kB, k) in zip(kk..kMax, 0..) do
-          BB[j,k] = BMat[kB,jB];
+pragma "no doc"
+/* Is ``A`` a whole (not a view of a) Block-distributed array? */
+private proc _isBlockArr(A: []) param {
+  use BlockDist;
+  if chpl__isArrayView(A) then
+    return false;
+  else
+    return isSubtype(A.domain.dist.type, Block);
+}
 
-      for ii in Adim0 by blockSize {
-        const iMax = min(ii+blockSize-1, Adim0.high);
-        const iRange = 0..iMax-ii;
+pragma "no doc"
+/* Is ``A`` a whole (not a view of a) BlockCyclic-distributed array? */
+private proc _isBlockCyclicArr(A: []) param {
+  use BlockCycDist;
+  if chpl__isArrayView(A) then
+    return false;
+  else
+    return isSubtype(A.domain.dist.type, BlockCyclic);
+}
 
-        for (iB, i) in zip(ii..iMax, 0..) do
-          for (kB, k) in zip(kk..kMax, 0..) do
-            AA[i,k] = AMat[iB, kB];
+pragma "no doc"
+/* Can the distributed kernels work on ``A`` in place? */
+private proc _isGridArr(A: []) param {
+  return _isBlockArr(A) || _isBlockCyclicArr(A);
+}
+
+pragma "no doc"
+/*
+   Distributed matrix-matrix multiplication
+
+   Operands are used in their existing distribution.  The result is
+   Block-distributed over the grid of locales of ``A``, or of ``B`` if
+   only ``B`` is Block or BlockCyclic.  Other operands, such as array
+   views and strided arrays, use the local kernel on local copies.
+*/
+private proc _distMatmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  if Adom.rank != 2 || Bdom.rank != 2 then
+    compilerError("Ranks are not 2 and 2");
+  if Adom.shape(1) != Bdom.shape(0) then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
+  if !Adom.stridable && !Bdom.stridable && _isGridArr(A) {
+    return _summaMatmatMult(A, B, A.targetLocales());
+  } else if !Adom.stridable && !Bdom.stridable && _isGridArr(B) {
+    return _summaMatmatMult(A, B, B.targetLocales());
+  } else {
+    var AL: [{(...Adom.dims())}] eltType = A,
+        BL: [{(...Bdom.dims())}] eltType = B;
+    return _matmatMult(AL, BL);
+  }
+}
 
-        for cc in CC do
-          cc = 0;
+pragma "no doc"
+/*
+   SUMMA matrix-matrix multiplication.
+
+   ``C`` is Block-distributed over ``targets`` and each locale owns one
+   block of it.  It steps through the shared dimension in panels of
+   ``_summaPanelWidth``.  For each panel it fetches, with bulk
+   transfers, the part of the ``A`` panel that covers its rows and the
+   part of the ``B`` panel that covers its columns.  When the operands
+   are Block-distributed over ``targets``, each panel of ``A`` goes out
+   along a row of the locale grid, and each panel of ``B`` along a
+   column.  The panels are double-buffered, so fetching the next one
+   overlaps the local multiply of the current one.
+*/
+private proc _summaMatmatMult(const ref A: [?Adom] ?eltType,
+                              const ref B: [?Bdom] eltType,
+                              targets: [] locale) {
+  use BlockDist;
+
+  const Cspace = {Adom.dim(0), Bdom.dim(1)};
+  const Cdom = Cspace dmapped Block(boundingBox=Cspace,
+                                    targetLocales=targets);
+  var C: [Cdom] eltType;
+
+  const kRange = Adom.dim(1),
+        bOff = Bdom.dim(0).low - kRange.low;
+  const kb = min(kRange.size, _summaPanelWidth),
+        numPanels = divceil(kRange.size, kb);
+
+  coforall loc in C.targetLocales() do on loc {
+    const myC = C.localSubdomain();
+    if myC.size > 0 {
+      const (rows, cols) = myC.dims();
+      var Abuf: [0..1] [rows, 0..#kb] eltType,
+          Bbuf: [0..1] [0..#kb, cols] eltType;
+
+      proc panelWidth(p: int) {
+        return min(kb, kRange.high - (kRange.low + p*kb) + 1);
+      }
 
-        for (k,j,i) in {kRange, jRange, iRange} do
-          CC[i,j] += AA[i,k] * BB[j,k];
+      proc fetch(p: int, buf: int) {
+        const lo = kRange.low + p*kb,
+              w = panelWidth(p);
+        Abuf[buf][rows, 0..#w] = A[rows, lo..#w];
+        Bbuf[buf][0..#w, cols] = B[lo+bOff..#w, cols];
+      }
 
-        for (iB, i) in zip(ii..iMax, 0..) do
-          for (jB, j) in zip(jj..jMax, 0..) do
-            CMat[iB,jB] += CC[i,j];
+      fetch(0, 0);
+      for p in 0..#numPanels {
+        const cur = p % 2,
+              w = panelWidth(p);
+        cobegin {
+          if p + 1 < numPanels then
+            fetch(p + 1, 1 - cur);
+          _matmatMultHelper(Abuf[cur][rows, 0..#w],
+                            Bbuf[cur][0..#w, cols],
+                            C.localSlice(myC));
+        }
       }
     }
   }
+
+  return C;
+}
+
+pragma "no doc"
+/*
+   Distributed matrix-vector multiplication
+
+   Computes ``A*X``, or ``transpose(A)*X`` if ``trans``.  A Block or
+   BlockCyclic matrix is used in place, and the result is distributed
+   the same way over the first column (row, if ``trans``) of ``A``'s grid
+   of locales, matching ``A``'s row (column) blocks.  Other matrices,
+   such as array views and strided arrays, use the local kernel on local
+   copies.
+*/
+private proc _distMatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
+                             trans=false) {
+  if Adom.rank != 2 || Xdom.rank != 1 then
+    compilerError("Ranks are not 2 and 1");
+  if !trans {
+    if Adom.shape(1) != Xdom.shape(0) then
+      halt("Mismatched shape in matrix-vector multiplication");
+  } else {
+    if Adom.shape(0) != Xdom.shape(0) then
+      halt("Mismatched shape in matrix-vector multiplication");
+  }
+
+  if !Adom.stridable && _isGridArr(A) {
+    return _gridMatvecMult(A, X, trans);
+  } else {
+    var AL: [{(...Adom.dims())}] eltType = A,
+        XL: [{(...Xdom.dims())}] eltType = X;
+    return _matvecMult(AL, XL, trans);
+  }
+}
+
+pragma "no doc"
+/*
+   Matrix-vector multiplication for a Block or BlockCyclic matrix.
+   Every locale multiplies its blocks of ``A`` by bulk-fetched copies of
+   the parts of ``X`` they need.  The owner of each piece of the result
+   then gathers and sums the partial results from the other locales in
+   its row (column, if ``trans``) of the grid.  The partial results are
+   kept densely, in the order of the owner's local indices of ``Y``.
+*/
+private proc _gridMatvecMult(const ref A: [?Adom] ?eltType,
+                             const ref X: [?Xdom] eltType, trans: bool) {
+  use BlockDist, BlockCycDist;
+
+  param cyclic = _isBlockCyclicArr(A);
+
+  const targets = A.targetLocales();
+  const (gridRows, gridCols) = targets.domain.dims();
+
+  // Distribute Y exactly like the rows (columns) of A
+  const d = if trans then 1 else 0;
+  const outDim = Adom.dim(d),
+        xOff = Xdom.dim(0).low - Adom.dim(1-d).low;
+  const yTargets = if trans then [l in targets[gridRows.low, ..]] l
+                   else [l in targets[.., gridCols.low]] l;
+  const yStart = if cyclic then A.domain.dist.lowIdx(d) else 0,
+        yBlock = if cyclic then A.domain.dist.blocksize(d) else 0;
+  const Ydom = if cyclic
+    then {outDim} dmapped BlockCyclic(startIdx=yStart, blocksize=yBlock,
+                                      targetLocales=yTargets)
+    else {outDim} dmapped Block(boundingBox={A.domain.dist.boundingBox.dim(d)},
+                                targetLocales=yTargets);
+  var Y: [Ydom] eltType;
+
+  const (ownerGrid, peerGrid) = if trans then (gridCols, gridRows)
+                                else (gridRows, gridCols);
+
+  coforall o in ownerGrid {
+    const owner = if trans then targets[gridRows.low, o]
+                  else targets[o, gridCols.low];
+    on owner {
+      var numY = 0, firstY = outDim.low;
+      for myY in Y.localSubdomains() {
+        if numY == 0 then firstY = myY.dim(0).low;
+        numY += myY.size;
+      }
+      const nY = numY, yLow = firstY;
+
+      // Position of index i of Y among the owner's local indices
+      proc yPos(i) {
+        if cyclic {
+          const b = (i - yStart) / yBlock;
+          return (b / ownerGrid.size) * yBlock + (i - yStart) % yBlock;
+        } else {
+          return i - yLow;
+        }
+      }
+
+      var parts: [peerGrid] [0..#nY] eltType;
+
+      coforall p in peerGrid with (ref parts) {
+        const peer = if trans then targets[p, o] else targets[o, p];
+        on peer {
+          var part: [0..#nY] eltType;
+
+          for myA in A.localSubdomains() {
+            if myA.size == 0 then continue;
+
+            const (rows, cols) = myA.dims();
+            const xDim = if trans then rows else cols;
+            var xl: [xDim] eltType;
+            xl = X[xDim.low+xOff..#xDim.size];
+
+            if !trans {
+              forall i in rows with (ref part) {
+                var sum: eltType;
+                for j in cols do
+                  sum += A.localAccess(i, j) * xl[j];
+                part[yPos(i)] = sum;
+              }
+            } else {
+              forall j in cols with (ref part) {
+                var sum: eltType;
+                for i in rows do
+                  sum += A.localAccess(i, j) * xl[i];
+                part[yPos(j)] = sum;
+              }
+            }
+          }
+
+          parts[p] = part;
+        }
+      }
+
+      for myY in Y.localSubdomains() {
+        forall i in myY.dim(0) {
+          var sum: eltType;
+          for p in peerGrid do
+            sum += parts[p][yPos(i)];
+          Y.localAccess(i) = sum;
+        }
+      }
+    }
+  }
+
+  return Y;
 }
 
 pragma "no doc"
@@ -2198,6 +2649,29 @@ A common usage of this interface might look like this:
   // A is now a 3x3 sparse identity matrix
   writeln(A);
 
+**Distributed CSR Matrices**
+
+A sparse subdomain of a domain distributed by ``Block`` with
+``sparseLayoutType=CS`` stores each locale's block of the matrix as a local
+CSR domain.  Giving ``Block`` a ``numLocales x 1`` grid of target locales
+makes every locale own a contiguous band of rows.  Such matrices are built
+efficiently from unsorted edge lists with ``bulkAdd``, and support
+matrix-vector products through :proc:`dot`:
+
+.. code-block:: chapel
+
+  use BlockDist;
+
+  const Space = {1..n, 1..n},
+        grid = reshape(Locales, {0..#numLocales, 0..0});
+  const D = Space dmapped Block(boundingBox=Space, targetLocales=grid,
+                                sparseLayoutType=CS);
+  var SD: sparse subdomain(D);
+  SD.bulkAdd(edges);  // edges: [] 2*int, in any order
+
+  var A: [SD] real = 1.0;
+  var y = A.dot(x);   // y is Block-distributed over the rows of A
+
 
 .. note::
   This is an early prototype package submodule. As a result, interfaces may
@@ -2381,15 +2855,23 @@ module Sparse {
   private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) where (isSparseArr(A) || isSparseArr(B)) {
     // matrix-vector
     if Adom.rank == 2 && Bdom.rank == 1 {
-      if !isCSArr(A) then
-        compilerError("Only CSR format is supported for sparse multiplication");
-      return _csrmatvecMult(A, B);
+      if isDistCSArr(A) {
+        return _distCsrmatvecMult(A, B);
+      } else {
+        if !isCSArr(A) then
+          compilerError("Only CSR format is supported for sparse multiplication");
+        return _csrmatvecMult(A, B);
+      }
     }
     // vector-matrix
     else if Adom.rank == 1 && Bdom.rank == 2 {
-      if !isCSArr(B) then
-        compilerError("Only CSR format is supported for sparse multiplication");
-      return _csrmatvecMult(B, A, trans=true);
+      if isDistCSArr(B) {
+        return _distCsrmatvecMult(B, A, trans=true);
+      } else {
+        if !isCSArr(B) then
+          compilerError("Only CSR format is supported for sparse multiplication");
+        return _csrmatvecMult(B, A, trans=true);
+      }
     }
     // matrix-matrix
     else if Adom.rank == 2 && Bdom.rank == 2 {
@@ -2403,7 +2885,8 @@ module Sparse {
   }
 
   /* Compute the dot-product */
-  proc _array.dot(A: []) where isCSArr(A) || isCSArr(this) {
+  proc _array.dot(A: []) where isCSArr(A) || isCSArr(this) ||
+                               isDistCSArr(A) || isDistCSArr(this) {
     import LinearAlgebra;
     return LinearAlgebra.Sparse.dot(this, A);
   }
@@ -2415,6 +2898,50 @@ module Sparse {
   }
 
 
+  /* Minimum number of non-zeros worth handing to a task in CSR kernels */
+  private param _csrMinNnzPerTask = 4096;
+
+  /* Rows handed out at a time by the dynamic SpGEMM row scheduler */
+  private param _csrRowBlock = 64;
+
+  /* Number of tasks to use for a CSR kernel touching ``nnz`` non-zeros */
+  private proc _csrNumTasks(nnz) {
+    const maxTasks = if dataParTasksPerLocale==0
+                     then here.maxTaskPar else dataParTasksPerLocale;
+    return max(1, min(maxTasks, (nnz / _csrMinNnzPerTask): int));
+  }
+
+  /*
+    Split the rows covered by ``indPtr`` into ``numChunks`` contiguous blocks
+    holding roughly the same number of non-zeros.  Returns the first row of
+    each block followed by one past the last row, so block ``c`` is
+    ``bounds[c]..bounds[c+1]-1``.
+  */
+  private proc _csrRowPartition(const ref indPtr: [?D] ?idxType,
+                                numChunks: int) {
+    const lo = D.low,
+          hi = D.high - 1,
+          first = indPtr[lo],
+          nnz = indPtr[hi+1] - first;
+
+    var bounds: [0..numChunks] idxType;
+    bounds[0] = lo;
+    bounds[numChunks] = hi + 1;
+
+    forall c in 1..numChunks-1 {
+      // Binary search for the first row starting at or past the target
+      const target = first + ((nnz * c) / numChunks): idxType;
+      var l = lo, h = hi + 1;
+      while l < h {
+        const m = l + (h - l) / 2;
+        if indPtr[m] < target then l = m + 1;
+                              else h = m;
+      }
+      bounds[c] = l;
+    }
+    return bounds;
+  }
+
   /* CSR Matrix-vector multiplication */
   private proc _csrmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
                               trans=false) where isCSArr(A)
@@ -2430,39 +2957,251 @@ module Sparse {
     if !trans {
       if Adom.shape(1) != Xdom.shape(0) then
         halt("Mismatched shape in matrix-vector multiplication");
-        // TODO: Loop over non-zero rows only
+    } else {
+      if Adom.shape(0) != Xdom.shape(0) then
+        halt("Mismatched shape in matrix-vector multiplication");
+    }
+
+    if !Adom._value.compressRows {
+      // CSC storage: fall back to the generic sparse iterators
+      if !trans {
         forall i in Adom.dim(0) {
           for j in Adom.dimIter(1, i) {
             Y[i] += A[i, j] * X[j];
           }
         }
+      } else {
+        ref X2 = X.reindex(Adom.dim(0));
+        forall i in Adom.dim(0) with (+ reduce Y) {
+          for j in Adom.dimIter(1, i) {
+            Y[j] += A[i, j] * X2[i];
+          }
+        }
+      }
+      return Y;
+    }
+
+    if !trans {
+      _csrmatvecKernel(A.dom.startIdx, A.dom.idx, A.data, X, Y, trans);
+    } else {
+      // Ensure same domain indices
+      ref X2 = X.reindex(Adom.dim(0));
+      _csrmatvecKernel(A.dom.startIdx, A.dom.idx, A.data, X2, Y, trans);
+    }
+    return Y;
+  }
+
+  /*
+    Matrix-vector product over the raw arrays of a CSR matrix: ``Y = A*X``,
+    or ``Y = transpose(A)*X`` if ``trans``.  ``X`` and ``Y`` are indexed
+    with the matrix's own column and row indices.
+
+    Rows are dealt out to tasks in contiguous blocks of roughly equal
+    non-zero counts so that a few dense rows do not serialize the product.
+  */
+  private proc _csrmatvecKernel(const ref indPtr: [] ?idxType,
+                                const ref ind: [] idxType,
+                                const ref vals: [] ?eltType,
+                                const ref X, ref Y: [] eltType,
+                                trans: bool) {
+    const nnz = indPtr[indPtr.domain.high] - indPtr[indPtr.domain.low];
+    const numTasks = _csrNumTasks(nnz);
+    const bounds = _csrRowPartition(indPtr, numTasks);
+
+    if !trans {
+      // Gather: each row is an independent sparse dot product
+      coforall tid in 0..#numTasks with (ref Y) {
+        for i in bounds[tid]..bounds[tid+1]-1 {
+          var sum: eltType;
+          for p in indPtr[i]..indPtr[i+1]-1 do
+            sum += vals[p] * X[ind[p]];
+          Y[i] = sum;
+        }
+      }
+    } else {
+      // Scatter: rows update arbitrary columns, so every task accumulates
+      // into its own copy of Y and the copies are summed at the end.
+      coforall tid in 0..#numTasks with (+ reduce Y) {
+        for i in bounds[tid]..bounds[tid+1]-1 {
+          const xi = X[i];
+          for p in indPtr[i]..indPtr[i+1]-1 do
+            Y[ind[p]] += vals[p] * xi;
+        }
+      }
+    }
+  }
+
+  /*
+    Matrix-vector multiplication for a SparseBlock-distributed matrix whose
+    locales store their blocks as CSR.
+
+    Each locale collects the distinct indices of ``X`` that its non-zeros
+    touch and fetches only those entries, with one request per locale
+    owning any of them, before running the local CSR kernel.  The locale
+    that owns each piece of the Block-distributed result sums the partial
+    results from the other locales in its row (column, if ``trans``) of the
+    target locale grid, so a row-block layout (``numLocales x 1`` grid)
+    needs no summation at all.
+  */
+  private proc _distCsrmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
+                                  trans=false) {
+    use BlockDist;
+
+    if Adom.rank != 2 || Xdom.rank != 1 then
+      compilerError("Ranks are not 2 and 1");
+
+    if !trans {
+      if Adom.shape(1) != Xdom.shape(0) then
+        halt("Mismatched shape in matrix-vector multiplication");
     } else {
       if Adom.shape(0) != Xdom.shape(0) then
         halt("Mismatched shape in matrix-vector multiplication");
+    }
 
-      // Ensure same domain indices
-      ref X2 = X.reindex(Adom.dim(0));
+    const dist = Adom._value.dist;
+    const ref targets = dist.targetLocales;
+    const (gridRows, gridCols) = dist.targetLocDom.dims();
+
+    // Distribute Y exactly like the rows (columns) of A
+    const outDim = if trans then Adom.dim(1) else Adom.dim(0),
+          bbox = if trans then dist.boundingBox.dim(1)
+                 else dist.boundingBox.dim(0),
+          xOff = Xdom.dim(0).low - (if trans then Adom.dim(0).low
+                                    else Adom.dim(1).low);
+    const yTargets = if trans then [l in targets[gridRows.low, ..]] l
+                     else [l in targets[.., gridCols.low]] l;
+    const Ydom = {outDim} dmapped Block(boundingBox={bbox},
+                                        targetLocales=yTargets);
+    var Y: [Ydom] eltType;
 
-      forall i in Adom.dim(0) with (+ reduce Y) {
-        for j in Adom.dimIter(1, i) {
-          Y[j] += A[i, j] * X2[i];
+    const (ownerGrid, peerGrid) = if trans then (gridCols, gridRows)
+                                  else (gridRows, gridCols);
+
+    coforall o in ownerGrid {
+      const ownerIdx = if trans then (gridRows.low, o) else (o, gridCols.low);
+      on targets[ownerIdx] {
+        const myY = Y.localSubdomain().dim(0);
+        var parts: [peerGrid] [myY] eltType;
+
+        coforall p in peerGrid with (ref parts) {
+          const peerIdx = if trans then (p, o) else (o, p);
+          on targets[peerIdx] {
+            const locDom = Adom._value.locDoms[peerIdx]!.mySparseBlock._value;
+            const locArr = A._value.locArr[peerIdx]!.myElems._value;
+            if !locDom.compressRows then
+              compilerError("Only CSR format is supported for sparse multiplication");
+
+            const (rows, cols) = locDom.parentDom.dims();
+            const xDim = if trans then rows else cols;
+            var part: [myY] eltType;
+
+            if locDom._nnz > 0 {
+              // Mark the entries of X this block reads
+              var mark: [xDim] int;
+              if !trans {
+                forall q in 0..#locDom._nnz with (ref mark) do
+                  mark[locDom.idx[q]] = 1;
+              } else {
+                forall i in rows with (ref mark) do
+                  if locDom.startIdx[i+1] > locDom.startIdx[i] then
+                    mark[i] = 1;
+              }
+
+              // ... and compact them into a sorted list
+              var pos: [xDim] int = + scan mark;
+              var need: [0..#pos[xDim.high]] Adom.idxType;
+              forall j in xDim with (ref need) do
+                if mark[j] != 0 then need[pos[j]-1] = j;
+
+              var xl: [xDim] eltType;
+              _fetchVectorEntries(X, need, xOff, xl);
+
+              _csrmatvecKernel(locDom.startIdx, locDom.idx, locArr.data,
+                               xl, part, trans);
+            }
+            parts[p] = part;
+          }
+        }
+
+        forall i in myY {
+          var sum: eltType;
+          for p in peerGrid do
+            sum += parts[p][i];
+          Y.localAccess(i) = sum;
         }
       }
     }
+
     return Y;
   }
 
+  /*
+    Set ``xl[j] = X[j+xOff]`` for every ``j`` in ``need``.  If ``X`` is
+    distributed, the requests are grouped by the locale owning each entry
+    and every such locale is visited once to gather its entries in bulk.
+  */
+  private proc _fetchVectorEntries(const ref X: [?Xdom] ?eltType,
+                                   const ref need: [] ?idxType,
+                                   xOff, ref xl: [] eltType) {
+    const n = need.size;
+    if n == 0 then return;
+
+    if !isDistributed(X) {
+      // One bulk copy of the span covering all requests
+      const lo = need[0], hi = need[n-1];
+      xl[lo..hi] = X[lo+xOff..hi+xOff];
+      return;
+    }
+
+    // Group the requests by owning locale, keeping them sorted in each group
+    var owner: [0..#n] int;
+    forall (o, j) in zip(owner, need) do
+      o = Xdom.dist.idxToLocale(j + xOff).id;
+
+    var counts: [0..#numLocales] int;
+    forall o in owner with (+ reduce counts) do
+      counts[o] += 1;
+    const starts = (+ scan counts) - counts;
+
+    var order: [0..#n] idxType;
+    var cursor = starts;
+    for (o, j) in zip(owner, need) {
+      order[cursor[o]] = j;
+      cursor[o] += 1;
+    }
+
+    var vals: [0..#n] eltType;
+    coforall lid in 0..#numLocales with (ref vals) {
+      const r = starts[lid]..#counts[lid];
+      if r.size > 0 then on Locales[lid] {
+        const myIdx: [r] idxType = order[r];
+        var myVals: [r] eltType;
+        forall (v, j) in zip(myVals, myIdx) do
+          v = X[j + xOff];
+        vals[r] = myVals;
+      }
+    }
+
+    forall (j, v) in zip(order, vals) with (ref xl) do
+      xl[j] = v;
+  }
+
   /* Sparse matrix-matrix multiplication.
 
      Does not assume sorted indices, but preserves sorted indices.
 
-     Implementation derived from the SMMP algorithm:
+     Implementation is Gustavson's row-by-row algorithm, split into the
+     symbolic and numeric passes of the SMMP algorithm:
 
       "Sparse Matrix Multiplication Package (SMMP)"
         Randolph E. Bank and Craig C. Douglas
 
       https://link.springer.com/article/10.1007/BF02070824
 
+     Both passes run in parallel over rows of the result.  Each task owns a
+     dense accumulator the width of a result row, and rows are handed out
+     in small blocks from a shared counter since the work per row depends
+     on the structure of both operands.
   */
   private proc _csrmatmatMult(A: [?ADom] ?eltType, B: [?BDom] eltType)
     where isCSArr(A) && isCSArr(B)
@@ -2478,8 +3217,6 @@ module Sparse {
     if innerARange != innerBRange then
         halt("Mismatched shape in sparse matrix-matrix multiplication");
 
-    // TODO: Return empty (rowRange, colRange) sparse array if A or B size == 0
-
     /* Note on compressed sparse (CS) internals:
        - startIdx.domain (indPtr) can start with any index
        - idx.domain (ind) starts on 0
@@ -2489,13 +3226,15 @@ module Sparse {
     // major axis (or row) for result matrix
     var indPtr: [rowRange.low..rowRange.high+1] idxType;
 
-    pass1(A, B, indPtr);
+    const numTasks = _csrNumTasks(ADom.size + BDom.size);
+
+    pass1(A, B, indPtr, numTasks);
 
     const nnz = indPtr[indPtr.domain.last];
     var ind: [0..#nnz] idxType;
     var data: [0..#nnz] eltType;
 
-    pass2(A, B, indPtr, ind, data);
+    pass2(A, B, indPtr, ind, data, numTasks);
 
     var C = CSRMatrix({rowRange, colRange}, data, ind, indPtr);
 
@@ -2508,54 +3247,58 @@ module Sparse {
 
 
   /* Populate indPtr and total nnz (last element of indPtr) */
-  private proc pass1(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr) {
-    // TODO: Parallelize - mask -> atomic ints,
-    //                   - Write a scan to compute idxPtr in O(log(n))
+  private proc pass1(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType,
+                     ref indPtr, numTasks: int) {
 
     /* Aliases for readability */
     proc _array.indPtr ref return this.dom.startIdx;
     proc _array.ind ref return this.dom.idx;
 
     const row_range = ADom.dim(0);
-    const inner_Arange = ADom.dim(1);
-    const inner_Brange = BDom.dim(0);
     const col_range = BDom.dim(1);
 
     type idxType = ADom.idxType;
 
-    var mask: [col_range.low..col_range.high] idxType;
-    mask = col_range.low-1;    // init to something not in col range
-    indPtr[col_range.low] = 0; // col indices definitely start at 0
-    var nnz = 0: idxType;
-
-    // Rows of output matrix C
-    for i in row_range {
-      var row_nnz = 0;
-      const Apos_range = A.indPtr[i]..A.indPtr[i+1]-1;  // nonzero position range
-      // Row pointers of A
-      for jpos in Apos_range {
-        // Column index of A
-        const j = A.ind[jpos];
-        const Bpos_range = B.indPtr[j]..B.indPtr[j+1]-1;
-        // Row pointers of B
-        for kk in Bpos_range {
-          // Column index of B
-          var k = B.ind[kk];
-          if mask[k] != i { // default of 0 for mask would not count a 0-indexed matrix
-            mask[k] = i;
-            row_nnz += 1;
+    var rowNnz: [row_range] idxType;
+    var nextBlock: atomic int;
+
+    coforall tid in 0..#numTasks with (ref rowNnz) {
+      // Task-private mask: mask[k] == i iff column k was already seen in row i
+      var mask: [col_range.low..col_range.high] idxType = row_range.low-1;
+
+      while true {
+        const lo = row_range.low + nextBlock.fetchAdd(1) * _csrRowBlock;
+        if lo > row_range.high then break;
+
+        // Rows of output matrix C
+        for i in lo..min(lo+_csrRowBlock-1, row_range.high) {
+          var row_nnz = 0: idxType;
+          // Row pointers of A
+          for jpos in A.indPtr[i]..A.indPtr[i+1]-1 {
+            // Column index of A
+            const j = A.ind[jpos];
+            // Row pointers of B
+            for kk in B.indPtr[j]..B.indPtr[j+1]-1 {
+              // Column index of B
+              const k = B.ind[kk];
+              if mask[k] != i {
+                mask[k] = i;
+                row_nnz += 1;
+              }
+            }
           }
+          rowNnz[i] = row_nnz;
         }
       }
-
-      nnz = nnz + row_nnz;
-      indPtr[i+1] = nnz;
     }
+
+    indPtr[row_range.low] = 0;
+    indPtr[row_range.low+1..row_range.high+1] = + scan rowNnz;
   }
 
   /* Populate indices and data */
-  private proc pass2(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr, ref ind, ref data) {
-    // TODO: Parallelize - next, sums -> task-private stacks
+  private proc pass2(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType,
+                     ref indPtr, ref ind, ref data, numTasks: int) {
 
     /* Aliases for readability */
     proc _array.indPtr ref return this.dom.startIdx;
@@ -2564,61 +3307,67 @@ module Sparse {
     type idxType = ADom.idxType;
 
     const row_range = ADom.dim(0);
-    const inner_Arange = ADom.dim(1);
-    const inner_Brange = BDom.dim(0);
     const col_range = BDom.dim(1);
 
     const cols = col_range;
 
-    var next: [cols] idxType = -1,
-        sums: [cols] eltType;
-
-    var nnz = 0;
-
-    for i in row_range {
-      var head = 0:idxType,
-          length = 0:idxType;
+    var nextBlock: atomic int;
+
+    coforall tid in 0..#numTasks with (ref ind, ref data) {
+      // Task-private dense accumulator, threaded into a linked list of the
+      // columns touched by the current row
+      const unlinked = cols.low - 1;
+      var next: [cols] idxType = unlinked,
+          sums: [cols] eltType;
+
+      while true {
+        const lo = row_range.low + nextBlock.fetchAdd(1) * _csrRowBlock;
+        if lo > row_range.high then break;
+
+        for i in lo..min(lo+_csrRowBlock-1, row_range.high) {
+          var head = unlinked,
+              length = 0:idxType;
+
+          // Maps row index (i) -> nnz index of A
+          for jpos in A.indPtr[i]..A.indPtr[i+1]-1 {
+            // Nonzero column index of A for row i
+            const j = A.ind[jpos];
+            const v = A.data[jpos];
+
+            // Maps row index (j) -> nnz index of B
+            for kk in B.indPtr[j]..B.indPtr[j+1]-1 {
+              // Nonzero column index of B for row j
+              const k = B.ind[kk];
+
+              sums[k] += v*B.data[kk];
+
+              // first touch of column k in this row: link it in
+              if next[k] == unlinked {
+                next[k] = head;
+                head = k;
+                length += 1;
+              }
+            }
+          }
 
-      // Maps row index (i) -> nnz index of A
-      const Apos_range = A.indPtr[i]..A.indPtr[i+1]-1;
-      for jpos in Apos_range {
-        // Nonzero column index of A for row i
-        const j = A.ind[jpos];
-        const v = A.data[jpos];
+          // Row i owns ind/data[indPtr[i]..indPtr[i+1]-1] exclusively
+          var nnz = indPtr[i];
+          for 1..length {
+            ind[nnz] = head;
+            data[nnz] = sums[head];
 
-        // Maps row index (j) -> nnz index of B
-        const Bpos_range = B.indPtr[j]..B.indPtr[j+1]-1;
-        for kk in Bpos_range {
-          // Nonzero column index of B for row j
-          const k = B.ind[kk];
+            nnz += 1;
 
-          sums[k] += v*B.data[kk];
+            // pop next k off the list
+            const temp = head;
+            head = next[head];
 
-          // ?fromMMS: what is all of this pushing about?
-          // push k to stack
-          if next[k] == -1 {
-            next[k] = head;
-            head = k;
-            length += 1;
+            // clear accumulator as we traverse
+            next[temp] = unlinked;
+            sums[temp] = 0;
           }
         }
       }
-
-      // Recounting is faster than accessing 'nnz in indPtr[i]..indPtr[i+1]-1'
-      for 1..length {
-        ind[nnz] = head;
-        data[nnz] = sums[head];
-
-        nnz += 1;
-
-        // pop next k off stack
-        const temp = head;
-        head = next[head];
-
-        // clear stack as we traverse
-        next[temp] = -1;
-        sums[temp] = 0;
-      }
     }
   }
 
@@ -2634,9 +3383,10 @@ module Sparse {
     type idxType = A.ind.eltType;
 
     var temp: [0..#A.ind.size] (idxType, eltType);
-    temp = for (idx, datum) in zip(A.ind, A.data) do (idx, datum);
+    forall (t, idx, datum) in zip(temp, A.ind, A.data) do t = (idx, datum);
 
-    for i in rowRange {
+    // Rows are independent, so sort them in parallel
+    forall i in rowRange with (ref temp) {
       const rowStart = A.indPtr[i],
             rowEnd = A.indPtr[i+1]-1;
       if rowEnd - rowStart > 0 {
@@ -2644,7 +3394,7 @@ module Sparse {
       }
     }
 
-    for i in temp.domain {
+    forall i in temp.domain with (ref A) {
       (A.ind[i], A.data[i]) = temp[i];
     }
   }
@@ -2662,15 +3412,78 @@ module Sparse {
 
   /* Transpose CSR matrix */
   proc transpose(A: [?Adom] ?eltType) where isCSArr(A) {
-    var Dom = transpose(Adom);
-    var B: [Dom] eltType;
+    if Adom._value.compressRows {
+      return _csrTranspose(A);
+    } else {
+      var Dom = transpose(Adom);
+      var B: [Dom] eltType;
 
-    forall i in Adom.dim(0) {
-      for j in Adom.dimIter(1, i) {
-        B[j, i] = A[i, j];
+      forall i in Adom.dim(0) {
+        for j in Adom.dimIter(1, i) {
+          B[j, i] = A[i, j];
+        }
       }
+      return B;
     }
-    return B;
+  }
+
+  /*
+    Parallel CSR transpose working directly on the CSR arrays.
+
+    Each task takes a contiguous block of rows and counts their non-zeros
+    per column with atomics.  A prefix sum over the columns gives the start
+    of every output row, and the same per-column array then serves as the
+    write cursors for the scatter, so the extra memory is O(columns) no
+    matter how many tasks are used.
+  */
+  private proc _csrTranspose(A: [?Adom] ?eltType) where isCSArr(A) {
+    type idxType = Adom.idxType;
+
+    const colRange = Adom.dim(1);
+
+    const ref indPtr = A.dom.startIdx,
+              ind = A.dom.idx,
+              vals = A.data;
+    const nnz = indPtr[indPtr.domain.high] - indPtr[indPtr.domain.low];
+    const numTasks = _csrNumTasks(nnz);
+    const bounds = _csrRowPartition(indPtr, numTasks);
+
+    // colPos[j]: first the number of non-zeros in column j, then the next
+    // free position in output row j.  With more than one task the entries
+    // of an output row land in no particular order, which the unsorted CSR
+    // layout allows.
+    var colPos: [colRange] atomic idxType;
+
+    coforall tid in 0..#numTasks with (ref colPos) {
+      for i in bounds[tid]..bounds[tid+1]-1 do
+        for p in indPtr[i]..indPtr[i+1]-1 do
+          colPos[ind[p]].add(1, memoryOrder.relaxed);
+    }
+
+    var indPtrT: [colRange.low..colRange.high+1] idxType;
+    indPtrT[colRange.low] = 0;
+    forall j in colRange with (ref indPtrT) do
+      indPtrT[j+1] = colPos[j].read(memoryOrder.relaxed);
+    indPtrT[colRange.low+1..colRange.high+1] =
+      + scan indPtrT[colRange.low+1..colRange.high+1];
+
+    forall j in colRange with (ref colPos) do
+      colPos[j].write(indPtrT[j], memoryOrder.relaxed);
+
+    var indT: [0..#nnz] idxType;
+    var dataT: [0..#nnz] eltType;
+
+    coforall tid in 0..#numTasks with (ref colPos, ref indT, ref dataT) {
+      for i in bounds[tid]..bounds[tid+1]-1 {
+        for p in indPtr[i]..indPtr[i+1]-1 {
+          const q = colPos[ind[p]].fetchAdd(1, memoryOrder.relaxed);
+          indT[q] = i;
+          dataT[q] = vals[p];
+        }
+      }
+    }
+
+    return CSRMatrix(transpose(Adom.parentDom), dataT, indT, indPtrT);
   }
 
   /* Transpose CSR matrix */
@@ -2939,6 +3752,18 @@ module Sparse {
   /* Returns ``true`` if the domain is dmapped to ``CS`` layout. */
   proc isCSDom(D: domain) param { return isCSType(D.dist.type); }
 
+  pragma "no doc"
+  /* Returns ``true`` if the array is a SparseBlock array stored as CS
+     blocks, i.e. declared over a ``sparse subdomain`` of a domain
+     distributed by ``Block(..., sparseLayoutType=CS)``. */
+  proc isDistCSArr(A: []) param {
+    use BlockDist;
+    proc isDistCSDomClass(dc: SparseBlockDom) param
+      return isCSType(dc.sparseLayoutType);
+    proc isDistCSDomClass(dc) param return false;
+    return isDistCSDomClass(A.domain._value);
+  }
+
 
 } // submodule LinearAlgebra.Sparse
 
@@ -422,14 +422,31 @@ proc radixSortOk(Data: [?Dom] ?eltType, comparator) param {
   return false;
 }
 
+// Sorts a Block-distributed array. Fixed-width keys on a few locales use
+// the distributed radix sort; everything else uses the sample sort.
+private
+proc distributedSort(Data: [?Dom] ?eltType, comparator) {
+  param fixedWidthKeys =
+    radixSortOk(Data, comparator) &&
+    RadixSortHelp.msbRadixSortParamLastStartBit(Data, comparator) >= 0;
+
+  if fixedWidthKeys {
+    if Data.targetLocales().size <= DistributedSampleSort.radixSortMaxLocales {
+      TwoArrayRadixSort.twoArrayRadixSort(Data, comparator=comparator);
+      return;
+    }
+  }
+  DistributedSampleSort.distributedSampleSort(Data, comparator);
+}
+
 /*
 
 Sort the elements in a 1D rectangular array.  The choice of sorting
 algorithm used is made by the implementation.
 
 .. note::
-  This function currently either uses a parallel radix sort or a serial
-  quickSort. The algorithms used will change over time.
+  This function currently uses a parallel radix sort, a parallel in-place
+  sample sort or quickSort. The algorithms used will change over time.
 
   It currently uses parallel radix sort if the following conditions are met:
 
@@ -451,6 +468,17 @@ algorithm used is made by the implementation.
     * ``string``
     * ``c_string``
 
+  Otherwise, large arrays over non-strided domains whose elements can be
+  copied without modifying the original use a parallel in-place sample
+  sort. It needs extra memory for only a few small blocks per task.
+
+  Arrays of plain-old-data elements distributed with :mod:`BlockDist`
+  over more than one locale are sorted with a distributed algorithm
+  instead. It is a distributed radix sort when the radix sort conditions
+  above hold and the key has a fixed width (e.g. ``int`` or ``real``)
+  and there are only a few locales. Otherwise it is a sample sort that
+  exchanges data between each pair of locales only once.
+
 :arg Data: The array to be sorted
 :type Data: [] `eltType`
 :arg comparator: :ref:`Comparator <comparators>` record that defines how the
@@ -464,8 +492,20 @@ proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
   if Dom.low >= Dom.high then
     return;
 
+  if DistributedSampleSort.distributedSortOk(Data) {
+    if Data.targetLocales().size > 1 {
+      distributedSort(Data, comparator);
+      return;
+    }
+  }
+
   if radixSortOk(Data, comparator) {
     MSBRadixSort.msbRadixSort(Data, comparator=comparator);
+  } else if InPlacePartitioning.ips4oOk(Data) {
+    if Dom.size > InPlacePartitioning.baseCaseSize then
+      InPlacePartitioning.ips4oSort(Data, comparator);
+    else
+      QuickSort.quickSort(Data, comparator=comparator);
   } else {
     QuickSort.quickSort(Data, comparator=comparator);
   }
@@ -3235,9 +3275,590 @@ module TwoArraySampleSort {
   }
 }
 
+pragma "no doc"
+module DistributedSampleSort {
+  import Sort.{sort, chpl_compare};
+  private use SampleSortHelp only log2int;
+  private use BlockDist;
+  private use Barriers;
+
+  // Beyond this many locales the radix sort's per-bucket redistribution
+  // costs more than the single exchange of the sample sort, so sort()
+  // uses the sample sort even for keys the radix sort could handle.
+  const radixSortMaxLocales = 16;
+
+  // Can Data be sorted with the distributed sorts?
+  // The exchange moves elements with bulk copies, so it is limited to
+  // plain-old-data elements in non-strided Block arrays.
+  proc distributedSortOk(Data:[]) param {
+    return !Data.domain.stridable && isPODType(Data.eltType) &&
+           isSubtype(Data._value.type, BlockArr);
+  }
+
+  // Orders samples (value, locale, position) by value and then by where
+  // the value came from. This gives every element a distinct rank, so
+  // runs of equal keys are still split evenly between buckets.
+  record SplitterComparator {
+    var comparator;
+
+    proc compare(a, b) {
+      const c = chpl_compare(a(0), b(0), comparator);
+      if c < 0 then return -1;
+      if c > 0 then return 1;
+      if a(1) != b(1) then return if a(1) < b(1) then -1 else 1;
+      if a(2) != b(2) then return if a(2) < b(2) then -1 else 1;
+      return 0;
+    }
+  }
+
+  // Returns how many elements of the sorted run A[lo..hi] order before
+  // the sample sp, where A[lo+i] is position base+i on locale lid.
+  proc splitterRank(A:[], lo:int, hi:int, lid:int, base:int,
+                    const ref sp, comparator) {
+    // lb is the first element not less than the sample value
+    var a = lo, b = hi + 1;
+    while a < b {
+      const mid = a + (b - a) / 2;
+      if chpl_compare(A[mid], sp(0), comparator) < 0 then a = mid + 1;
+      else b = mid;
+    }
+    const lb = a;
+    if lid > sp(1) then
+      return lb - lo;
+
+    // ub is the first element greater than the sample value
+    b = hi + 1;
+    while a < b {
+      const mid = a + (b - a) / 2;
+      if chpl_compare(A[mid], sp(0), comparator) <= 0 then a = mid + 1;
+      else b = mid;
+    }
+    const ub = a;
+    if lid < sp(1) then
+      return ub - lo;
+
+    return min(max(lo + sp(2) - base, lb), ub) - lo;
+  }
+
+  // Merges the sorted runs Src[starts[r]..<ends[r]] into Dst starting
+  // at dstStart, keeping a binary heap of runs ordered by their heads.
+  proc multiwayMerge(ref Dst:[], dstStart:int, const ref Src:[],
+                     const ref starts:[] int, const ref ends:[] int,
+                     comparator) {
+    var heads = starts;
+    var heap:[0..#starts.size] int;
+    var n = 0;
+    for r in starts.domain {
+      if heads[r] < ends[r] {
+        heap[n] = r;
+        n += 1;
+      }
+    }
+
+    inline proc less(x:int, y:int) {
+      return chpl_compare(Src[heads[x]], Src[heads[y]], comparator) < 0;
+    }
+    proc siftDown(in i:int) {
+      while true {
+        const l = 2*i + 1, r = l + 1;
+        var m = i;
+        if l < n && less(heap[l], heap[m]) then m = l;
+        if r < n && less(heap[r], heap[m]) then m = r;
+        if m == i then break;
+        heap[i] <=> heap[m];
+        i = m;
+      }
+    }
+
+    for i in 0..#(n/2) by -1 do
+      siftDown(i);
+
+    var out = dstStart;
+    while n > 0 {
+      const r = heap[0];
+      Dst[out] = Src[heads[r]];
+      out += 1;
+      heads[r] += 1;
+      if heads[r] == ends[r] {
+        n -= 1;
+        heap[0] = heap[n];
+      }
+      if n > 0 then
+        siftDown(0);
+    }
+  }
+
+  // Sorts a Block-distributed array by regular sampling:
+  //  1. each locale sorts its own block and takes evenly spaced samples
+  //  2. the sorted samples give numLocales*nTasks-1 splitters
+  //  3. each locale finds where its block splits between destinations
+  //  4. each locale pulls its share with one bulk get per source locale
+  //     and merges the sorted runs, nTasks merges at a time
+  //  5. the merged runs are copied back into Data in order
+  proc distributedSampleSort(Data:[], comparator) {
+    type eltType = Data.eltType;
+    type sampleType = (eltType, int, int);
+
+    const targetLocs = Data.targetLocales();
+    const nLocs = targetLocs.size;
+    const nTasks = if dataParTasksPerLocale > 0
+                   then dataParTasksPerLocale
+                   else here.maxTaskPar;
+    const nBuckets = nLocs * nTasks;
+    const samplesPerLocale = nTasks * max(4, log2int(Data.size));
+
+    // Step 1: sort each block locally and sample it
+    var Bases, Sizes: [0..#nLocs] int;
+    var Samples: [0..#nLocs*samplesPerLocale] sampleType;
+    coforall (loc, lid) in zip(targetLocs, 0..) do on loc {
+      const myDom = Data.localSubdomain();
+      const n = myDom.size;
+      Sizes[lid] = n;
+      if n > 0 {
+        Bases[lid] = myDom.low;
+        sort(Data.localSlice(myDom), comparator);
+        var mySamples: [0..#samplesPerLocale] sampleType;
+        forall i in mySamples.domain {
+          const pos = ((2*i + 1) * n) / (2*samplesPerLocale);
+          mySamples[i] = (Data.localAccess[myDom.low + pos], lid, pos);
+        }
+        Samples[lid*samplesPerLocale..#samplesPerLocale] = mySamples;
+      }
+    }
+
+    // Step 2: pick the splitters from the sorted sample. Bucket k holds
+    // the elements between splitters k-1 and k, and locale d receives
+    // buckets d*nTasks..#nTasks.
+    var sampleCount = 0;
+    for lid in 0..#nLocs do
+      if Sizes[lid] > 0 then
+        sampleCount += samplesPerLocale;
+
+    var SortedSamples: [0..#sampleCount] sampleType;
+    {
+      var next = 0;
+      for lid in 0..#nLocs {
+        if Sizes[lid] > 0 {
+          SortedSamples[next..#samplesPerLocale] =
+            Samples[lid*samplesPerLocale..#samplesPerLocale];
+          next += samplesPerLocale;
+        }
+      }
+    }
+    sort(SortedSamples, new SplitterComparator(comparator));
+
+    var Splitters: [0..#nBuckets-1] sampleType;
+    forall k in Splitters.domain do
+      Splitters[k] = SortedSamples[((k+1)*sampleCount) / nBuckets];
+
+    // Step 3: split each sorted block between the destination locales
+    var SendStart, SendCount: [0..#nLocs, 0..#nLocs] int;
+    coforall (loc, lid) in zip(targetLocs, 0..) do on loc {
+      const n = Sizes[lid];
+      if n > 0 {
+        const myDom = Data.localSubdomain();
+        var bounds: [0..nLocs] int;
+        bounds[nLocs] = n;
+        forall d in 1..nLocs-1 {
+          const sp = Splitters[d*nTasks - 1];
+          bounds[d] = splitterRank(Data.localSlice(myDom),
+                                   myDom.low, myDom.high, lid, 0,
+                                   sp, comparator);
+        }
+        var starts, counts: [0..#nLocs] int;
+        forall d in 0..#nLocs {
+          starts[d] = bounds[d];
+          counts[d] = bounds[d+1] - bounds[d];
+        }
+        SendStart[lid, ..] = starts;
+        SendCount[lid, ..] = counts;
+      }
+    }
+
+    // Step 4: where does each locale's share start in the output?
+    var RecvOffset: [0..#nLocs] int;
+    {
+      var offset = Data.domain.low;
+      for d in 0..#nLocs {
+        RecvOffset[d] = offset;
+        offset += + reduce SendCount[.., d];
+      }
+    }
+
+    // Step 5: exchange, merge, and write back. Nobody may overwrite Data
+    // until every locale has pulled its share out of it.
+    var b = new Barrier(nLocs);
+    coforall (loc, d) in zip(targetLocs, 0..) do on loc {
+      const starts: [0..#nLocs] int = SendStart[.., d];
+      const counts: [0..#nLocs] int = SendCount[.., d];
+      const runStart = (+ scan counts) - counts;
+      const total = + reduce counts;
+      const mySplitters: [1..nTasks-1] sampleType =
+        Splitters[d*nTasks..#nTasks-1];
+
+      // Pull one run from each source, starting with a different source
+      // on each locale
+      var Recv: [0..#total] eltType;
+      forall i in 0..#nLocs {
+        const s = (d + i) % nLocs;
+        const cnt = counts[s];
+        if cnt > 0 then
+          Recv[runStart[s]..#cnt] = Data[Bases[s]+starts[s]..#cnt];
+      }
+
+      // Split every run at this locale's splitters so that the merges
+      // into disjoint parts of the output can run in parallel
+      var subBounds: [0..#nLocs, 0..nTasks] int;
+      forall s in 0..#nLocs {
+        subBounds[s, nTasks] = counts[s];
+        for j in 1..nTasks-1 {
+          subBounds[s, j] = splitterRank(Recv, runStart[s],
+                                         runStart[s] + counts[s] - 1,
+                                         s, starts[s], mySplitters[j],
+                                         comparator);
+        }
+      }
+
+      var Merged: [0..#total] eltType;
+      forall j in 0..#nTasks {
+        var runStarts, runEnds: [0..#nLocs] int;
+        var outStart = 0;
+        for s in 0..#nLocs {
+          runStarts[s] = runStart[s] + subBounds[s, j];
+          runEnds[s] = runStart[s] + subBounds[s, j+1];
+          outStart += subBounds[s, j];
+        }
+        multiwayMerge(Merged, outStart, Recv, runStarts, runEnds, comparator);
+      }
+
+      b.barrier();
+
+      if total > 0 then
+        Data[RecvOffset[d]..#total] = Merged;
+    }
+  }
+}
+
 pragma "no doc"
 module InPlacePartitioning {
-  // TODO -- based on ips4o
+  import Sort.{ShallowCopy, QuickSort};
+  private use SampleSortHelp;
+  private use DynamicIters;
+  private use CPtr;
+
+  private param debug = false;
+
+  // Ranges of at most this many elements are sorted with quickSort
+  param baseCaseSize = 1 << 14;
+  // A range is partitioned by all tasks if each one gets this many elements
+  param parallelSizePerTask = 1 << 16;
+  // Preferred size of a block, in bytes
+  param blockBytes = 2048;
+
+  // Can Data be sorted by ips4oSort?
+  // The splitters are copies of array elements, so the elements have to
+  // be copyable without modifying the original.  The block buffers are
+  // arrays of the element type, so it must also be default-initializable.
+  proc ips4oOk(Data:[]) param {
+    return !Data.domain.stridable && isConstCopyableType(Data.eltType) &&
+           isDefaultInitializable(Data.eltType);
+  }
+
+  // Moves src into dst. Non-POD values are swapped instead of copied, so
+  // every value lives in exactly one place and none is freed twice.
+  private inline proc moveElt(ref dst, ref src) {
+    if isPODType(dst.type) then
+      dst = src;
+    else
+      ShallowCopy.shallowSwap(dst, src);
+  }
+
+  private proc moveBlock(ref Dst:[], dst:int, ref Src:[], src:int, len:int) {
+    if isPODType(Dst.eltType) {
+      ShallowCopy.shallowCopy(Dst, dst, Src, src, len);
+    } else {
+      for i in 0..#len do
+        moveElt(Dst[dst+i], Src[src+i]);
+    }
+  }
+
+  // Moves sampleSize randomly chosen elements to the front of A[lo..hi]
+  private proc selectSample(A:[], lo:int, hi:int, sampleSize:int) {
+    private use Random;
+    var randNums = createRandomStream(seed=1, eltType=int, parSafe=false);
+    for i in lo..#sampleSize {
+      const j = randNums.getNext(i, hi);
+      if j != i then
+        ShallowCopy.shallowSwap(A[i], A[j]);
+    }
+  }
+
+  // Partitions A[lo..hi] in place into the buckets of a fresh sample,
+  // using nTasks tasks. This follows IPS4o (Axtmann et al., "In-place
+  // Parallel Super Scalar Samplesort"):
+  //  1. each task classifies a stripe of the array into per-bucket
+  //     buffers of B elements, writing full buffers back to the front
+  //     of its stripe as blocks
+  //  2. within each bucket's block-aligned region, full blocks are moved
+  //     in front of the empty ones
+  //  3. the tasks permute the blocks into their buckets' regions
+  //  4. the partial buffers and the blocks that cross bucket boundaries
+  //     are moved into the gaps that are left
+  // Extra space is O(nTasks*numBuckets*B) and independent of n once
+  // blocks reach blockBytes.
+  //
+  // Returns bucket b's position relative to lo as
+  // bucketStart[b]..<bucketStart[b+1].
+  proc partition(A:[], lo:int, hi:int, comparator, nTasks:int,
+                 ref bucketizer: SampleBucketizer(A.eltType)) {
+    const n = hi - lo + 1;
+
+    // Sort a sample and build the classification tree from it
+    const logNumBuckets = computeLogBucketSize(n);
+    const numBuckets = 1 << logNumBuckets;
+    const sampleStep = chooseSampleStep(n, logNumBuckets);
+    var sampleSize = sampleStep * numBuckets - 1;
+    if sampleSize >= n then
+      sampleSize = max(1, n/2);
+
+    selectSample(A, lo, hi, sampleSize);
+    sortRange(A, lo, lo + sampleSize - 1, comparator, 1);
+    createSplittersFromSample(A, bucketizer, comparator,
+                              lo, sampleSize, sampleStep, numBuckets);
+
+    const k = bucketizer.getNumBuckets();
+    const eltBytes = max(1, c_sizeof(A.eltType):int);
+    const B = max(1, min(blockBytes / eltBytes, n / (4*nTasks*k)));
+    const nFull = n / B;
+    const stripeBlocks = divceil(divceil(n, B), nTasks);
+
+    if debug then
+      writeln("ips4o partition ", lo..hi, " tasks=", nTasks,
+              " buckets=", k, " B=", B);
+
+    // Step 1: classify each stripe
+    var bufs: [0..#nTasks*k*B] A.eltType;
+    var bufFill: [0..#nTasks*k] int;
+    var fullBlocks: [0..#nTasks] int;
+    var counts: [0..#k] int;
+
+    coforall tid in 0..#nTasks with (+ reduce counts) {
+      const start = tid*stripeBlocks*B;
+      const end = min(start + stripeBlocks*B, n) - 1;
+      var w = start;
+      if start <= end {
+        for (i, bin) in bucketizer.classify(A, lo+start, lo+end,
+                                            comparator, 0) {
+          const slot = tid*k + bin;
+          moveElt(bufs[slot*B + bufFill[slot]], A[i]);
+          bufFill[slot] += 1;
+          counts[bin] += 1;
+          if bufFill[slot] == B {
+            moveBlock(A, lo + w, bufs, slot*B, B);
+            w += B;
+            bufFill[slot] = 0;
+          }
+        }
+      }
+      fullBlocks[tid] = (w - start) / B;
+    }
+
+    var bucketStart: [0..k] int;
+    for b in 0..#k do
+      bucketStart[b+1] = bucketStart[b] + counts[b];
+
+    // Step 2: within each bucket's region, move the full blocks first.
+    // Afterwards the unplaced blocks of bucket b are writePtr[b]..readPtr[b].
+    proc isFull(blk:int) {
+      const t = blk / stripeBlocks;
+      return blk - t*stripeBlocks < fullBlocks[t];
+    }
+
+    var writePtr, readPtr: [0..#k] int;
+    forall b in 0..#k {
+      const first = divceil(bucketStart[b], B);
+      const last = divceil(bucketStart[b+1], B);
+      var nFullHere = 0;
+      for blk in first..<last do
+        if isFull(blk) then
+          nFullHere += 1;
+
+      const split = first + nFullHere;
+      var i = first, j = last - 1;
+      while true {
+        while i < split && isFull(i) do i += 1;
+        while j >= split && !isFull(j) do j -= 1;
+        if i >= split || j < split then break;
+        moveBlock(A, lo + i*B, A, lo + j*B, B);
+        i += 1;
+        j -= 1;
+      }
+      writePtr[b] = first;
+      readPtr[b] = split - 1;
+    }
+
+    // Step 3: permute the blocks. A task takes an unplaced block, writes
+    // it at its bucket's write pointer and continues with the block it
+    // displaced, until it writes into an empty slot. A slot emptied by
+    // a reader may still be being copied, so writers into empty slots
+    // wait for that bucket's pending reads.
+    var locks: [0..#k] atomic bool;
+    var pending: [0..#k] atomic int;
+    var overflow: [0..#B] A.eltType; // for a block past the end of A
+
+    inline proc lockBucket(b:int) {
+      while locks[b].testAndSet() do
+        chpl_task_yield();
+    }
+    inline proc unlockBucket(b:int) {
+      locks[b].clear();
+    }
+
+    coforall tid in 0..#nTasks {
+      var swapBufs: [0..#2*B] A.eltType;
+      var cur = 0;
+      var bkt = (tid * k) / nTasks;
+      var misses = 0;
+      while misses < k {
+        var idx = -1;
+        lockBucket(bkt);
+        if readPtr[bkt] >= writePtr[bkt] {
+          idx = readPtr[bkt];
+          readPtr[bkt] -= 1;
+          pending[bkt].add(1);
+        }
+        unlockBucket(bkt);
+
+        if idx < 0 {
+          bkt = (bkt + 1) % k;
+          misses += 1;
+          continue;
+        }
+        misses = 0;
+
+        moveBlock(swapBufs, cur*B, A, lo + idx*B, B);
+        pending[bkt].sub(1);
+
+        while true {
+          const dest = bucketizer.bucketForRecord(swapBufs[cur*B],
+                                                  comparator, 0);
+          lockBucket(dest);
+          const w = writePtr[dest];
+          writePtr[dest] += 1;
+          const displace = w <= readPtr[dest];
+          unlockBucket(dest);
+
+          if displace {
+            moveBlock(swapBufs, (1-cur)*B, A, lo + w*B, B);
+            moveBlock(A, lo + w*B, swapBufs, cur*B, B);
+            cur = 1 - cur;
+          } else {
+            pending[dest].waitFor(0);
+            if w >= nFull then
+              moveBlock(overflow, 0, swapBufs, cur*B, B);
+            else
+              moveBlock(A, lo + w*B, swapBufs, cur*B, B);
+            break;
+          }
+        }
+      }
+    }
+
+    // Step 4a: move out the elements each bucket's last block wrote past
+    // the bucket's end, and put the overflow block in place
+    var spill: [0..#k*B] A.eltType;
+    var spillCount: [0..#k] int;
+    forall b in 0..#k {
+      const e = bucketStart[b+1];
+      const alignedStart = divceil(bucketStart[b], B)*B;
+      const wEnd = writePtr[b]*B;
+      var cnt = 0;
+      for pos in max(alignedStart, min(e, nFull*B))..<wEnd {
+        const inOverflow = pos >= nFull*B;
+        if pos < e {
+          if inOverflow then
+            moveElt(A[lo + pos], overflow[pos - nFull*B]);
+        } else {
+          if inOverflow then
+            moveElt(spill[b*B + cnt], overflow[pos - nFull*B]);
+          else
+            moveElt(spill[b*B + cnt], A[lo + pos]);
+          cnt += 1;
+        }
+      }
+      spillCount[b] = cnt;
+    }
+
+    // Step 4b: fill the gaps at the start and end of each bucket from
+    // its spilled elements and the partial buffers
+    forall b in 0..#k {
+      const s = bucketStart[b], e = bucketStart[b+1];
+      const alignedStart = divceil(s, B)*B;
+      const wEnd = writePtr[b]*B;
+      const headEnd = min(alignedStart, e);
+      var pos = s;
+      for t in -1..<nTasks {
+        const base = if t < 0 then b*B else (t*k + b)*B;
+        const cnt = if t < 0 then spillCount[b] else bufFill[t*k + b];
+        for i in 0..#cnt {
+          if pos == headEnd then
+            pos = max(wEnd, headEnd);
+          if t < 0 then
+            moveElt(A[lo + pos], spill[base + i]);
+          else
+            moveElt(A[lo + pos], bufs[base + i]);
+          pos += 1;
+        }
+      }
+    }
+
+    return bucketStart;
+  }
+
+  // Sorts A[lo..hi] using up to nTasks tasks
+  proc sortRange(A:[], lo:int, hi:int, comparator, nTasks:int) {
+    const n = hi - lo + 1;
+    if n <= baseCaseSize {
+      if n > 1 then
+        QuickSort.quickSortImpl(A, comparator=comparator, start=lo, end=hi);
+      return;
+    }
+
+    const useTasks = if n >= nTasks*parallelSizePerTask then nTasks else 1;
+    var bucketizer: SampleBucketizer(A.eltType);
+    const bucketStart = partition(A, lo, hi, comparator, useTasks, bucketizer);
+    const k = bucketizer.getNumBuckets();
+    const sortBins = bucketizer.getBinsToRecursivelySort();
+
+    if useTasks == 1 {
+      for b in sortBins do
+        sortRange(A, lo + bucketStart[b], lo + bucketStart[b+1] - 1,
+                  comparator, 1);
+    } else {
+      // Large buckets are sorted one after another by all tasks and the
+      // rest are shared out to single tasks
+      const bigSize = n / useTasks;
+      for b in sortBins do
+        if bucketStart[b+1] - bucketStart[b] > bigSize then
+          sortRange(A, lo + bucketStart[b], lo + bucketStart[b+1] - 1,
+                    comparator, useTasks);
+
+      forall b in dynamic(0..#k, chunkSize=1, numTasks=useTasks) {
+        if sortBins.contains(b) &&
+           bucketStart[b+1] - bucketStart[b] <= bigSize then
+          sortRange(A, lo + bucketStart[b], lo + bucketStart[b+1] - 1,
+                    comparator, 1);
+      }
+    }
+  }
+
+  // Sorts Data with a parallel in-place super scalar samplesort
+  proc ips4oSort(Data:[], comparator) {
+    const nTasks = if dataParTasksPerLocale > 0
+                   then dataParTasksPerLocale
+                   else here.maxTaskPar;
+    sortRange(Data, Data.domain.low, Data.domain.high, comparator, nTasks);
+  }
 }
 
 
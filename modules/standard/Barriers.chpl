@@ -53,10 +53,13 @@
    "task-team" concept.  A task-team will more directly support collective
    operations such as barriers between the tasks within a team.
 
-   The current implementation is designed for correctness, but is not expected
-   to perform well at scale.  We expect performance at scale to improve as
-   this barrier implementation is optimized and as the task-team concept is
-   implemented and optimized.
+   When more than :var:`barrierFanIn` tasks use an atomic barrier,
+   arrivals are combined through a tree whose nodes each take at most
+   :var:`barrierFanIn` arrivals, so that tasks do not all update the same
+   counter.  With network atomics, tasks on other locales update the tree
+   in place.  Without them, they move to the locale where the barrier was
+   created, as they do for the single-counter barrier.  See
+   :mod:`AllLocalesBarriers` for a barrier that scales across locales.
 */
 module Barriers {
   import HaltWrappers;
@@ -69,6 +72,15 @@ module Barriers {
   */
   enum BarrierType {Atomic, Sync}
 
+  /* The maximum number of arrivals combined at each node of the tree used by
+     atomic barriers.  Barriers for at most this many tasks use a single
+     counter. */
+  config const barrierFanIn = 8;
+
+  // Without network atomics, the tree barrier's counters can only be
+  // updated on the barrier's locale.
+  private param treeProcAtomics = CHPL_NETWORK_ATOMICS == "none";
+
   /* A barrier that will cause `numTasks` to wait before proceeding. */
   record Barrier {
     pragma "no doc"
@@ -88,7 +100,9 @@ module Barriers {
               reusable: bool = true) {
       select barrierType {
         when BarrierType.Atomic {
-          if reusable {
+          if numTasks > barrierFanIn {
+            bar = new unmanaged treeBarrier(numTasks, reusable);
+          } else if reusable {
             bar = new unmanaged aBarrier(numTasks, reusable=true);
           } else {
             bar = new unmanaged aBarrier(numTasks, reusable=false);
@@ -216,10 +230,6 @@ module Barriers {
     pragma "no doc"
     var done: if procAtomics then chpl__processorAtomicType(bool) else atomic bool;
 
-    // Hack for AllLocalesBarrier
-    pragma "no doc"
-    param hackIntoCommBarrier = false;
-
     /* Construct a new Barrier object.
 
        :arg n: The number of tasks involved in this barrier
@@ -230,16 +240,6 @@ module Barriers {
       reset(n);
     }
 
-    // Hack for AllLocalesBarrier
-    pragma "no doc"
-    proc init(n: int, param reusable: bool, param procAtomics: bool, param hackIntoCommBarrier: bool) {
-      this.reusable = reusable;
-      this.procAtomics = procAtomics;
-      this.hackIntoCommBarrier = hackIntoCommBarrier;
-      this.complete();
-      reset(n);
-    }
-
     pragma "no doc"
     /* inline */ override proc reset(nTasks: int) {
       inline proc innerReset() {
@@ -257,10 +257,6 @@ module Barriers {
       inline proc innerBarrier() {
         const myc = count.fetchSub(1);
         if myc<=1 {
-          if hackIntoCommBarrier {
-            extern proc chpl_comm_barrier(msg: c_string);
-            chpl_comm_barrier("local barrier call".localize().c_str());
-          }
           const alreadySet = done.testAndSet();
           if boundsChecking && alreadySet {
             HaltWrappers.boundsCheckHalt("Too many callers to barrier()");
@@ -320,6 +316,237 @@ module Barriers {
     }
   }
 
+  /* The counters of a combining tree, one per node, each padded out to its
+     own cache line.  Leaves take up to `fanIn` task arrivals each; every
+     other node takes one arrival per child.  The arrival that fills a node
+     moves on to its parent, so the arrival that fills the root is the last
+     one overall.
+   */
+  pragma "no doc"
+  record treeBarrierNode {
+    var count: if treeProcAtomics then chpl__processorAtomicType(int)
+                                  else atomic int;
+    var capacity: int;
+    var parent: int;
+    var padding: 5*int;
+  }
+
+  pragma "no doc"
+  class CombiningTree {
+    const numLeaves: int;
+    const numNodes: int;
+    var nodes: [0..#numNodes] treeBarrierNode;
+
+    proc init(n: int, fanIn: int) {
+      // leaves come first, then each level above them, ending at the root
+      numLeaves = max(1, divceil(n, fanIn));
+      var total = numLeaves, width = numLeaves;
+      while width > 1 {
+        width = divceil(width, fanIn);
+        total += width;
+      }
+      numNodes = total;
+      this.complete();
+
+      for i in 0..#numLeaves do
+        nodes[i].capacity = n / numLeaves + (if i < n % numLeaves then 1 else 0);
+      var lo = 0;
+      width = numLeaves;
+      while width > 1 {
+        const up = lo + width, upWidth = divceil(width, fanIn);
+        for i in 0..#width {
+          nodes[lo+i].parent = up + i / fanIn;
+          nodes[up + i / fanIn].capacity += 1;
+        }
+        lo = up;
+        width = upWidth;
+      }
+      nodes[lo].parent = -1;
+    }
+
+    /* Record the arrival of the calling task.  Return `true` for the arrival
+       that completes the whole tree.  A task starts at a leaf chosen by its
+       task ID and moves on to the next leaf while the one it tried is full;
+       leaves stay full until :proc:`resetLeaves` is called, so that a late
+       arrival can never be counted twice.  Task IDs are only unique within
+       a locale, so the locale ID is mixed in for tasks arriving from other
+       locales.
+     */
+    proc arrive(msg: string): bool {
+      extern proc chpl_task_getId(): chpl_taskID_t;
+      const h = chpl__defaultHash(chpl_task_getId()) ^
+                chpl__defaultHash(here.id);
+      var leaf = (h % numLeaves:uint): int;
+      var probes = 0;
+      while true {
+        var cur = nodes[leaf].count.read();
+        if cur < nodes[leaf].capacity {
+          if nodes[leaf].count.compareExchangeWeak(cur, cur+1) {
+            if cur+1 < nodes[leaf].capacity then return false;
+            break;
+          }
+        } else {
+          leaf = (leaf + 1) % numLeaves;
+          probes += 1;
+          if probes >= numLeaves {
+            if boundsChecking then HaltWrappers.boundsCheckHalt(msg);
+            probes = 0;
+            chpl_task_yield();
+          }
+        }
+      }
+
+      // Interior nodes can be reset as soon as they fill, because only
+      // completed children arrive at them.
+      var node = nodes[leaf].parent;
+      while node != -1 {
+        const arrived = nodes[node].count.fetchAdd(1) + 1;
+        if arrived < nodes[node].capacity then return false;
+        nodes[node].count.write(0);
+        node = nodes[node].parent;
+      }
+      return true;
+    }
+
+    /* Ready the leaves for the next episode.  Only the task that completed
+       the tree may call this, before it releases the waiting tasks. */
+    proc resetLeaves() {
+      for i in 0..#numLeaves do
+        nodes[i].count.write(0);
+    }
+  }
+
+  /* A task barrier that combines arrivals through a tree of counters so
+     that large numbers of tasks do not all contend on one cache line.
+     Waiting tasks spin on a phase counter that is written only once per
+     episode.  Can be used as a simple barrier or as a split-phase barrier.
+     With network atomics, remote tasks update the counters in place;
+     otherwise they move to the barrier's locale first.
+   */
+  pragma "no doc"
+  class treeBarrier: BarrierBaseType {
+    /* If true the barrier can be used multiple times.  When using this as a
+       split-phase barrier this causes :proc:`wait` to block until all tasks
+       have reached the wait */
+    const reusable: bool;
+    const fanIn: int;
+
+    pragma "no doc"
+    var n: int;
+    pragma "no doc"
+    var arrivals: unmanaged CombiningTree?;
+    pragma "no doc"
+    var departures: unmanaged CombiningTree?;
+    pragma "no doc"
+    var phase: if treeProcAtomics then chpl__processorAtomicType(int)
+                                  else atomic int;
+    pragma "no doc"
+    var departPhase: if treeProcAtomics then chpl__processorAtomicType(int)
+                                        else atomic int;
+    pragma "no doc"
+    var notified: if treeProcAtomics then chpl__processorAtomicType(bool)
+                                     else atomic bool;
+
+    proc init(n: int, reusable: bool, fanIn: int = barrierFanIn) {
+      this.reusable = reusable;
+      this.fanIn = max(fanIn, 2);
+      this.complete();
+      reset(n);
+    }
+
+    proc deinit() {
+      delete arrivals;
+      delete departures;
+    }
+
+    /* Called by the task that completes a :proc:`barrier` episode, before
+       the other tasks are released.  Subclasses use this to extend the
+       barrier beyond this locale. */
+    proc allArrived() { }
+
+    // The trees are allocated on this locale even with network atomics.
+    override proc reset(nTasks: int) {
+      on this {
+        n = nTasks;
+        delete arrivals;
+        delete departures;
+        arrivals = new unmanaged CombiningTree(n, fanIn);
+        departures = new unmanaged CombiningTree(n, fanIn);
+        phase.write(0);
+        departPhase.write(0);
+        notified.write(false);
+      }
+    }
+
+    /* Block until n tasks have called this method. */
+    override proc barrier() {
+      inline proc innerBarrier() {
+        const p = phase.read();
+        if arrivals!.arrive("Too many callers to barrier()") {
+          arrivals!.resetLeaves();
+          allArrived();
+          if !reusable {
+            const alreadySet = notified.testAndSet();
+            if boundsChecking && alreadySet {
+              HaltWrappers.boundsCheckHalt("Too many callers to barrier()");
+            }
+          }
+          phase.add(1);
+        } else {
+          phase.waitFor(p+1);
+        }
+      }
+      if treeProcAtomics then on this do innerBarrier(); else innerBarrier();
+    }
+
+    /* Notify the barrier that this task has reached this point. */
+    override proc notify() {
+      inline proc innerNotify() {
+        if arrivals!.arrive("Too many callers to notify()") {
+          arrivals!.resetLeaves();
+          const alreadySet = notified.testAndSet();
+          if boundsChecking && alreadySet {
+            HaltWrappers.boundsCheckHalt("Too many callers to notify()");
+          }
+          phase.add(1);
+        }
+      }
+      if treeProcAtomics then on this do innerNotify(); else innerNotify();
+    }
+
+    /* Wait until `n` tasks have called :proc:`notify`.  If `reusable` is
+       true, also wait until all `n` tasks have called :proc:`wait`, then
+       reset the barrier to be used again.
+     */
+    override proc wait() {
+      inline proc innerWait() {
+        notified.waitFor(true);
+        if reusable {
+          const p = departPhase.read();
+          if departures!.arrive("Too many callers to wait()") {
+            departures!.resetLeaves();
+            notified.clear();
+            departPhase.add(1);
+          } else {
+            departPhase.waitFor(p+1);
+          }
+        }
+      }
+      if treeProcAtomics then on this do innerWait(); else innerWait();
+    }
+
+    /* Return `true` if `n` tasks have called :proc:`notify`
+     */
+    override proc check(): bool {
+      if treeProcAtomics {
+        var ret: bool;
+        on this do ret = notified.read();
+        return ret;
+      }
+      return notified.read();
+    }
+  }
+
   /* A task barrier implemented using sync and single variables. Can be used
      as a simple barrier or as a split-phase barrier.
    */
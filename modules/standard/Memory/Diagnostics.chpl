@@ -73,6 +73,18 @@
     If during execution the amount of allocated memory exceeds this
     limit on any locale, halt the program with a message saying so.
 
+  ``memTrackSample``: `uint`:
+    If the value is greater than 1, enable memory tracking but record
+    only a random sample of allocations, about one per this many bytes
+    allocated, and scale the recorded sizes and counts up accordingly
+    in all reports.  Allocations much smaller than the value are
+    sampled with probability about size/value, larger ones almost
+    always.  This makes tracking cheap enough to leave on in production
+    runs, at the cost of reports being estimates.
+    :proc:`printMemAllocs` reports sampled allocations per allocation
+    site rather than per address.  The ``memMax`` limit needs the exact
+    total, so this setting is ignored when ``memMax`` is set.
+
   The following two config variables do not enable memory tracking;
   they only modify how it is done.
 
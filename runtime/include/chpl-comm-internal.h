@@ -31,13 +31,18 @@ extern "C" {
 
 //
 // Support for broadcasting globals.  Comm layer implementations must
-// supply this.  It is called collectively.  On node 0 it must arrange
-// that all the global variable wide pointers are in a buffer that can
-// be the source of a GET from the other nodes and return either that
-// buffer's address (if it wants it freed later) or NULL.  On all other
-// nodes it should return the node-0 local address of that buffer.
+// supply these.  The helper is called collectively.  On every node it
+// must return a table, indexed by node ID, of the addresses of per-node
+// buffers that can each hold chpl_numGlobalsOnHeap wide pointers and
+// can be the source of a GET from the other nodes.  Before the helper
+// returns on any node, node 0 must have filled its own buffer with the
+// global variable wide pointers.  The common code then moves the data
+// down a binomial tree of GETs, so no single node is the source for
+// more than log2(chpl_numNodes) of them.  Finally it calls the _fini
+// function with the table, to release the table and buffers.
 //
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void);
+wide_ptr_t** chpl_comm_broadcast_global_vars_helper(void);
+void chpl_comm_broadcast_global_vars_helper_fini(wide_ptr_t** bufs);
 
 //
 // These are runtime-private copies of chpl_private_broadcast_table[]
@@ -357,7 +357,9 @@ chpl_bool chpl_comm_regMemFree(void* p, size_t size) {
 // nothing in the 'broadcast' call, or batch up the wide pointers
 // in the 'register' calls and actually do a broadcast in the
 // 'broadcast' call.  Currently we do the latter in order to
-// reduce startup overhead.
+// reduce startup overhead.  The broadcast itself moves the batch
+// down a binomial tree of nodes, so that no node (in particular,
+// not node 0) has to serve more than log2(numNodes) of the copies.
 //
 void chpl_comm_register_global_var(int i, wide_ptr_t* ptr_to_wide_ptr);
 void chpl_comm_broadcast_global_vars(int numGlobals);
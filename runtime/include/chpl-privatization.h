@@ -23,6 +23,7 @@
 #ifndef LAUNCHER
 #include <stdint.h>
 #include "chpltypes.h"
+#include "chpl-bitops.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,19 +31,64 @@ extern "C" {
 
 void chpl_privatization_init(void);
 
+//
+// Privatized object ids (pids) are handed out, and handed back for
+// reuse, on node 0.  These must only be called there.
+//
+int64_t chpl_newPrivatizedPid(void);
+void chpl_freePrivatizedPid(int64_t);
+
 void chpl_newPrivatizedClass(void*, int64_t);
 
 typedef struct chpl_privateObject_s {
   void* obj;
 } chpl_privateObject_t;
 
-// This is a dynamically-allocated array of chpl_privateObject_t.
-extern chpl_privateObject_t* chpl_privateObjects;
+//
+// The privatized objects live in a two-level table.  The top level is
+// a fixed-size directory of pointers to blocks of entries.  Block b
+// holds BLOCK_SIZE << b entries, so the directory covers every
+// non-negative pid without ever having to grow or move, and there is
+// no limit on the number of pids short of int64_t.  Blocks are
+// allocated when their first entry is set, and freed once all of their
+// entries have been cleared and no setter or clearer can still be
+// looking at them (see chpl-privatization.c).
+//
+#define CHPL_PRIVATIZATION_BLOCK_BITS 12
+#define CHPL_PRIVATIZATION_BLOCK_SIZE \
+  ((int64_t) 1 << CHPL_PRIVATIZATION_BLOCK_BITS)
+#define CHPL_PRIVATIZATION_NUM_BLOCKS (64 - CHPL_PRIVATIZATION_BLOCK_BITS)
+
+// This is the directory.  Entries for unused blocks are NULL.
+extern chpl_privateObject_t* chpl_privateObjects[CHPL_PRIVATIZATION_NUM_BLOCKS];
+
+// The directory index of the block holding a pid's entry.
+static inline
+int64_t chpl_privatizationBlock(int64_t pid) {
+  uint64_t n = (uint64_t) (pid >> CHPL_PRIVATIZATION_BLOCK_BITS) + 1;
+  return 63 - (int64_t) chpl_bitops_clz_64(n);
+}
 
-// Compiler generates accesses like chpl_privateObjects[i];
-// see chpl_getPrivatizedCopy.
-// This allows TBAA information for chpl_privateObjects to be used.
-// At the very least, inlining it would be important for performance.
+// The index of a pid's entry within its block.
+static inline
+int64_t chpl_privatizationBlockOffset(int64_t pid, int64_t b) {
+  return pid + CHPL_PRIVATIZATION_BLOCK_SIZE
+             - (CHPL_PRIVATIZATION_BLOCK_SIZE << b);
+}
+
+//
+// The generated code reaches privatized objects through this, by way
+// of chpl_getPrivatizedCopy().  It is inline and reads the table
+// directly so that TBAA information for chpl_privateObjects can be
+// used.  The pid must be live, that is, set and not yet cleared on
+// this node.  A block with a live entry is never retired, so lookups
+// need no locking, no retries, and no epoch.
+//
+static inline
+void* chpl_getPrivatizedClass(int64_t pid) {
+  int64_t b = chpl_privatizationBlock(pid);
+  return chpl_privateObjects[b][chpl_privatizationBlockOffset(pid, b)].obj;
+}
 
 void chpl_clearPrivatizedClass(int64_t);
 
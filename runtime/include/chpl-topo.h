@@ -50,6 +50,12 @@ void* chpl_topo_getHwlocTopology(void);
 int chpl_topo_getNumCPUsPhysical(chpl_bool /*accessible_only*/);
 int chpl_topo_getNumCPUsLogical(chpl_bool /*accessible_only*/);
 
+//
+// What is the size in bytes of the level 1, 2, or 3 data (or unified)
+// cache serving the first accessible CPU?  Returns 0 if unknown.
+//
+size_t chpl_topo_getCacheSize(int /*level*/);
+
 //
 // how many NUMA domains are there?
 //
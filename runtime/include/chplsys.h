@@ -34,6 +34,7 @@ size_t chpl_getHeapPageSize(void); // note: only works after mem layer inited
 uint64_t chpl_sys_physicalMemoryBytes(void);
 int chpl_sys_getNumCPUsPhysical(chpl_bool accessible_only);
 int chpl_sys_getNumCPUsLogical(chpl_bool accessible_only);
+size_t chpl_sys_getCacheSize(int level); // data/unified; 0 if unknown
 
 //
 // returns the name of a locale via uname -n or the like
@@ -55,42 +55,38 @@ void chpl_comm_register_global_var(int i, wide_ptr_t *ptr_to_wide_ptr) {
 
 void chpl_comm_broadcast_global_vars(int numGlobals) {
   //
-  // On node 0: gather up the global variables' wide pointers into a
-  //            buffer; return that buffer if it needs deallocating
-  //            after the communication, otherwise NULL.
-  // On other nodes: retrieve the node 0 local address of that buffer.
+  // Get the table of per-node buffers.  Node 0's buffer already holds
+  // the global variables' wide pointers.
   //
-  wide_ptr_t* buf_on_0;
-  buf_on_0 = chpl_comm_broadcast_global_vars_helper();
+  wide_ptr_t** bufs;
+  bufs = chpl_comm_broadcast_global_vars_helper();
 
   //
-  // On node 0: barrier to ensure the other nodes have the global vars;
-  //            free the buffer if needed.
-  // On other nodes: GET the buffer of wide pointers; scatter it into
-  //                 our copies of the global vars; barrier to indicate
-  //                 we're done.  Node 0 could actually free the buffer
-  //                 as soon as we GET it, but we also have to prevent
-  //                 node 0 from running any Chapel code until all the
-  //                 other nodes have recorded the wide pointers.  So,
-  //                 we delay our barrier to achieve both goals.
+  // Move the wide pointers down a binomial tree rooted at node 0.  In
+  // the round with stride 'step', the nodes in [step, 2*step) GET the
+  // buffer from the node 'step' below them, which received it in an
+  // earlier round, and scatter it into their copies of the global
+  // vars.  This takes ceil(log2(chpl_numNodes)) rounds and spreads the
+  // GETs across the nodes instead of having them all target node 0.
+  // The barrier at the end of each round separates it from the next
+  // one.  The barrier at the end of the last round also keeps node 0
+  // from running any Chapel code until all the other nodes have
+  // recorded the wide pointers.
   //
-  if (chpl_nodeID == 0) {
-    chpl_comm_barrier("broadcast global vars");
-    if (buf_on_0 != NULL) {
-      chpl_mem_free(buf_on_0, 0, 0);
-    }
-  } else {
-    wide_ptr_t* buf;
-    size_t size = chpl_numGlobalsOnHeap * sizeof(*buf);
-    buf = (wide_ptr_t*)
-          chpl_mem_alloc(size, CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
-    chpl_comm_get(buf, 0, buf_on_0, size, CHPL_COMM_UNKNOWN_ID, 0, -1);
-    for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
-      *chpl_globals_registry[i] = buf[i];
+  size_t size = chpl_numGlobalsOnHeap * sizeof(wide_ptr_t);
+  for (c_nodeid_t step = 1; step < chpl_numNodes; step *= 2) {
+    if (chpl_nodeID >= step && chpl_nodeID < 2 * step) {
+      wide_ptr_t* buf = bufs[chpl_nodeID];
+      chpl_comm_get(buf, chpl_nodeID - step, bufs[chpl_nodeID - step], size,
+                    CHPL_COMM_UNKNOWN_ID, 0, -1);
+      for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
+        *chpl_globals_registry[i] = buf[i];
+      }
     }
     chpl_comm_barrier("broadcast global vars");
-    chpl_mem_free(buf, 0, 0);
   }
+
+  chpl_comm_broadcast_global_vars_helper_fini(bufs);
 }
 
 
@@ -22,72 +22,297 @@
 #include "chpl-privatization.h"
 #include "chpl-mem.h"
 #include "chpl-atomics.h"
+#include "chpl-tasks.h"
+#include "error.h"
 
-static int64_t chpl_capPrivateObjects = 0;
-static atomic_spinlock_t lock;
+#define BLOCK_SIZE CHPL_PRIVATIZATION_BLOCK_SIZE
+#define NUM_BLOCKS CHPL_PRIVATIZATION_NUM_BLOCKS
+
+chpl_privateObject_t* chpl_privateObjects[NUM_BLOCKS];
+
+//
+// Each block of entries is preceded by a header that the setters and
+// clearers use.  'live' counts the block's non-NULL entries.  The
+// thread that clears the last one swings it from 0 to 'retiredLive',
+// which keeps setters from reviving the block, then unlinks the block
+// and retires it.  A retired block is not freed until every setter or
+// clearer that could have loaded a pointer to it has finished (see
+// the epochs below).  Lookups through chpl_getPrivatizedClass() are
+// not a concern: they only ever look up live pids, whose blocks can't
+// be retired.
+//
+typedef struct block_s {
+  atomic_int_least64_t live;
+  struct block_s* nextRetired;
+  uint_least64_t retiredEpoch;
+  chpl_privateObject_t entries[];
+} block_t;
+
+static const int_least64_t retiredLive = INT64_MIN / 2;
+
+//
+// Setters and clearers coordinate through blocks[], which mirrors the
+// directory, rather than through the directory itself, which is read
+// without synchronization.
+//
+static atomic_uintptr_t blocks[NUM_BLOCKS];
+
+//
+// Epoch-based reclamation.  Setters and clearers run inside an epoch:
+// they count themselves in epochUsers[] for the parity of the epoch
+// they entered, and look at blocks only while counted there.  A block
+// is tagged with the epoch current when it was retired.  The epoch can
+// be advanced from e to e+1 once nobody remains in e-1, at which point
+// every thread that entered an epoch before e, and so every thread
+// that could have seen a block retired before e, has finished.  Such
+// blocks are then freed.  Advancing and freeing happen under a lock,
+// outside of any epoch, after each set or clear that has work to do.
+//
+static atomic_uint_least64_t epoch;
+static atomic_int_least64_t epochUsers[2];
+static atomic_spinlock_t retiredLock;
+static block_t* retiredBlocks;
+
+//
+// Pid recycling, on node 0 only.  Freed pids go on a stack whose links
+// live in a table shaped like the object table, under a lock (pids are
+// handed out once per distribution, domain, or array, so this is not
+// a hot path).  The stack holds the top pid + 1, or 0 if it is empty,
+// and when it is empty we hand out the next never-used pid.  The link
+// blocks are never freed.
+//
+static atomic_spinlock_t pidLock;
+static int64_t nextNewPid;
+static int64_t freePidHead;
+static int64_t* pidLinkBlocks[NUM_BLOCKS];
 
-chpl_privateObject_t* chpl_privateObjects = NULL;
 
 void chpl_privatization_init(void) {
-  atomic_init_spinlock_t(&lock);
+  for (int64_t i = 0; i < NUM_BLOCKS; i++) {
+    atomic_init_uintptr_t(&blocks[i], (uintptr_t) NULL);
+    pidLinkBlocks[i] = NULL;
+  }
+  atomic_init_uint_least64_t(&epoch, 0);
+  atomic_init_int_least64_t(&epochUsers[0], 0);
+  atomic_init_int_least64_t(&epochUsers[1], 0);
+  atomic_init_spinlock_t(&retiredLock);
+  retiredBlocks = NULL;
+  atomic_init_spinlock_t(&pidLock);
+  nextNewPid = 0;
+  freePidHead = 0;
+}
+
+
+static
+uint_least64_t enterEpoch(void) {
+  while (true) {
+    uint_least64_t e = atomic_load_uint_least64_t(&epoch);
+    (void) atomic_fetch_add_int_least64_t(&epochUsers[e & 1], 1);
+    if (atomic_load_uint_least64_t(&epoch) == e) {
+      return e;
+    }
+    (void) atomic_fetch_sub_int_least64_t(&epochUsers[e & 1], 1);
+  }
+}
+
+
+static
+void leaveEpoch(uint_least64_t e) {
+  (void) atomic_fetch_sub_int_least64_t(&epochUsers[e & 1], 1);
+}
+
+
+static
+void retireBlock(block_t* blk) {
+  atomic_lock_spinlock_t(&retiredLock);
+  blk->retiredEpoch = atomic_load_uint_least64_t(&epoch);
+  blk->nextRetired = retiredBlocks;
+  retiredBlocks = blk;
+  atomic_unlock_spinlock_t(&retiredLock);
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+
+//
+// Free what we can.  A block retired in epoch r needs the epoch to get
+// to r+1 and then be advanced once more, so try twice.  Must be called
+// outside of any epoch.
+//
+static
+void reclaimBlocks(void) {
+  if (!atomic_try_lock_spinlock_t(&retiredLock)) {
+    return;
+  }
+
+  for (int i = 0; i < 2 && retiredBlocks != NULL; i++) {
+    uint_least64_t e = atomic_load_uint_least64_t(&epoch);
+    if (atomic_load_int_least64_t(&epochUsers[(e - 1) & 1]) != 0) {
+      break;
+    }
+    atomic_store_uint_least64_t(&epoch, e + 1);
+
+    block_t** bp = &retiredBlocks;
+    while (*bp != NULL) {
+      block_t* blk = *bp;
+      if (blk->retiredEpoch < e) {
+        *bp = blk->nextRetired;
+        chpl_mem_free(blk, 0, 0);
+      } else {
+        bp = &blk->nextRetired;
+      }
+    }
+  }
+
+  atomic_unlock_spinlock_t(&retiredLock);
 }
 
+
+static
+int64_t* pidLink(int64_t pid) {
+  int64_t b = chpl_privatizationBlock(pid);
+  if (pidLinkBlocks[b] == NULL) {
+    pidLinkBlocks[b] = chpl_mem_allocMany(BLOCK_SIZE << b,
+                                          sizeof(*pidLinkBlocks[b]),
+                                          CHPL_RT_MD_COMM_PRV_OBJ_ARRAY,
+                                          0, 0);
+  }
+  return &pidLinkBlocks[b][chpl_privatizationBlockOffset(pid, b)];
+}
+
+
+int64_t chpl_newPrivatizedPid(void) {
+  int64_t pid;
+
+  atomic_lock_spinlock_t(&pidLock);
+  if (freePidHead != 0) {
+    pid = freePidHead - 1;
+    freePidHead = *pidLink(pid);
+  } else {
+    if (nextNewPid == INT64_MAX) {
+      chpl_internal_error("too many privatized objects");
+    }
+    pid = nextNewPid++;
+  }
+  atomic_unlock_spinlock_t(&pidLock);
+
+  return pid;
+}
+
+
+void chpl_freePrivatizedPid(int64_t pid) {
+  atomic_lock_spinlock_t(&pidLock);
+  *pidLink(pid) = freePidHead;
+  freePidHead = pid + 1;
+  atomic_unlock_spinlock_t(&pidLock);
+}
+
+
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2.  It has to ensure that the block holding the pid's entry is
+// present, and must not race with the retirement of that block when some
+// other pid in it is cleared.  Be __very__ careful if you have to update it.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  atomic_lock_spinlock_t(&lock);
-
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                               sizeof(chpl_privateObject_t),
-                               CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      chpl_privateObject_t* tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
-
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                                   sizeof(chpl_privateObject_t),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects,
-                  (oldCap)*sizeof(chpl_privateObject_t));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
+  if (pid < 0) {
+    chpl_internal_error("privatized object id out of range");
+  }
+
+  int64_t b = chpl_privatizationBlock(pid);
+  int64_t off = chpl_privatizationBlockOffset(pid, b);
+  uint_least64_t e = enterEpoch();
+  block_t* blk;
+
+  while (true) {
+    //
+    // Install the block if it isn't there.  If we lose a race to do
+    // so, use the winner's.
+    //
+    uintptr_t ublk = atomic_load_uintptr_t(&blocks[b]);
+    if (ublk == (uintptr_t) NULL) {
+      block_t* newBlk;
+      newBlk = chpl_mem_allocManyZero(1, sizeof(block_t)
+                                         + (BLOCK_SIZE << b)
+                                           * sizeof(chpl_privateObject_t),
+                                      CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
+      atomic_init_int_least64_t(&newBlk->live, 0);
+      if (atomic_compare_exchange_strong_uintptr_t(&blocks[b], &ublk,
+                                                   (uintptr_t) newBlk)) {
+        ublk = (uintptr_t) newBlk;
+      } else {
+        chpl_mem_free(newBlk, 0, 0);
+      }
+    }
+    blk = (block_t*) ublk;
+
+    //
+    // Count our entry as live, unless the block is being retired.  In
+    // that case, wait for it to be unlinked and start over.  The epoch
+    // keeps it from being freed under us in the meantime.
+    //
+    int_least64_t live = atomic_load_int_least64_t(&blk->live);
+    while (live >= 0
+           && !atomic_compare_exchange_strong_int_least64_t(&blk->live, &live,
+                                                            live + 1)) {
+    }
+    if (live >= 0) {
+      break;
+    }
+    while (atomic_load_uintptr_t(&blocks[b]) == ublk) {
+      chpl_task_yield();
     }
   }
-  chpl_privateObjects[pid].obj = v;
 
-  atomic_unlock_spinlock_t(&lock);
+  //
+  // Every setter stores into the directory, so that our entry is
+  // visible by the time we return no matter who installed the block.
+  //
+  chpl_privateObjects[b] = blk->entries;
+  blk->entries[off].obj = v;
+
+  leaveEpoch(e);
+  reclaimBlocks();
 }
 
 void chpl_clearPrivatizedClass(int64_t i) {
-  atomic_lock_spinlock_t(&lock);
-  chpl_privateObjects[i].obj = NULL;
-  atomic_unlock_spinlock_t(&lock);
+  int64_t b = chpl_privatizationBlock(i);
+  int64_t off = chpl_privatizationBlockOffset(i, b);
+  uint_least64_t e = enterEpoch();
+  block_t* blk = (block_t*) atomic_load_uintptr_t(&blocks[b]);
+
+  //
+  // Clearing is idempotent.  If that was the last live entry in the
+  // block, retire the block.  If a setter slips in between our
+  // decrement and the CAS, the CAS fails and the block stays.
+  //
+  if (blk != NULL && blk->entries[off].obj != NULL) {
+    blk->entries[off].obj = NULL;
+    if (atomic_fetch_sub_int_least64_t(&blk->live, 1) == 1) {
+      int_least64_t expected = 0;
+      if (atomic_compare_exchange_strong_int_least64_t(&blk->live,
+                                                       &expected,
+                                                       retiredLive)) {
+        chpl_privateObjects[b] = NULL;
+        atomic_store_uintptr_t(&blocks[b], (uintptr_t) NULL);
+        retireBlock(blk);
+      }
+    }
+  }
+
+  leaveEpoch(e);
+  reclaimBlocks();
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
   int64_t ret = 0;
-  atomic_lock_spinlock_t(&lock);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i].obj)
-      ret++;
+  uint_least64_t e = enterEpoch();
+  for (int64_t b = 0; b < NUM_BLOCKS; b++) {
+    block_t* blk = (block_t*) atomic_load_uintptr_t(&blocks[b]);
+    if (blk == NULL)
+      continue;
+    int_least64_t live = atomic_load_int_least64_t(&blk->live);
+    if (live > 0)
+      ret += live;
   }
-  atomic_unlock_spinlock_t(&lock);
+  leaveEpoch(e);
   return ret;
 }
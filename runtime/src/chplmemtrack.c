@@ -30,6 +30,7 @@
 #include "chpl-comm-internal.h"
 #include "chplcgfns.h"
 #include "chpl-linefile-support.h"
+#include "chpl-thread-local-storage.h"
 #include "config.h"
 #include "error.h"
 
@@ -62,12 +63,14 @@ extern void chpl_memTracking_returnConfigVals(chpl_bool* memTrack,
                                               chpl_bool* memLeaks,
                                               size_t* memMax,
                                               size_t* memThreshold,
+                                              size_t* memTrackSample,
                                               c_string* memLog,
                                               c_string* memLeaksLog);
 
 typedef struct memTableEntry_struct { /* table entry */
   size_t number;
   size_t size;
+  double weight;  /* allocations this entry stands for (>1 when sampling) */
   chpl_mem_descInt_t description;
   void* memAlloc;
   int32_t lineno;
@@ -75,16 +78,52 @@ typedef struct memTableEntry_struct { /* table entry */
   struct memTableEntry_struct* nextInBucket;
 } memTableEntry;
 
-#define NUM_HASH_SIZE_INDICES 20
+#define NUM_HASH_SIZE_INDICES 24
 
-static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593, 49157, 98317,
+static int hashSizes[NUM_HASH_SIZE_INDICES] = { 97, 193, 389, 769,
+                                                1543, 3079, 6151, 12289, 24593, 49157, 98317,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table of live allocations is split into shards, selected by a
+// hash of the allocation address.  An allocation and its free always
+// land in the same shard, so each shard can be protected by its own
+// lock and resized on its own, and tasks on different threads rarely
+// contend.  The allocated/freed sums are kept per shard and only added
+// up when reported.  The running total is also kept per shard and only
+// passed on to the shared total once a shard has gathered a batch of
+// it, so most allocations touch nothing outside their own shard.
+//
+// We can't use a sync var for concurrency control here.  The Qthreads
+// internal memory allocator shim references this memory tracking code
+// via the Chapel runtime public memory layer interface.  Referring to a
+// sync var here when exiting (to report memTrack results, say), after
+// the tasking layer is shut down, ends up trying to create a qthread in
+// the terminated Qthreads library.  Chaos results.  We also cannot use
+// an atomic var, because with CHPL_ATOMICS=locks those are implemented
+// by means of sync vars.  So, we use pthread mutexes.  Note that this
+// is only safe if we cannot switch tasks on a pthread while holding a
+// mutex and then try to lock it recursively.  Currently that is the
+// case, since we do not yield while holding one.
+//
+#define MEM_TABLE_SHARD_BITS 6
+#define NUM_MEM_TABLE_SHARDS (1 << MEM_TABLE_SHARD_BITS)
+
+typedef struct {
+  pthread_mutex_t lock;
+  memTableEntry** table;
+  int hashSizeIndex;
+  int hashSize;
+  size_t totalEntries;    /* number of entries in this shard's table */
+  size_t totalAllocated;  /* memory allocated through this shard */
+  size_t totalFreed;      /* memory freed through this shard */
+  size_t liveMem;         /* memory in this shard's table now */
+  int64_t pendingMem;     /* change in liveMem not yet in totalMem */
+} memTableShard;
+
+static memTableShard memShards[NUM_MEM_TABLE_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -92,41 +131,251 @@ static c_string memLeaksByDesc = "";
 static _Bool memLeaks = false;
 static size_t memMax = 0;
 static size_t memThreshold = 0;
+static size_t memTrackSample = 0;
 static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
 
-static size_t totalMem = 0;       /* total memory currently allocated */
-static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
+static size_t totalMem = 0;       /* total memory, as batched by shards */
+static size_t maxMem = 0;         /* maximum of totalMem during run  */
 
+//
+// A shard passes its running total on to totalMem once it has changed
+// by memBatch bytes.  totalMem therefore lags the true total by less
+// than NUM_MEM_TABLE_SHARDS*memBatch, which is what bounds both the
+// error of the high water mark and the slack in the memMax check.
+// With --memMax the batch is sized to keep that under 1/64 of the
+// limit, so small limits are checked exactly.
+//
+#define MEM_BATCH_MAX ((size_t) 1 << 20)
+static size_t memBatch = MEM_BATCH_MAX;
 
-// We can't use a sync var for concurrency control here.  The Qthreads
-// internal memory allocator shim references this memory tracking code
-// via the Chapel runtime public memory layer interface.  Referring to a
-// sync var here when exiting (to report memTrack results, say), after
-// the tasking layer is shut down, ends up trying to create a qthread in
-// the terminated Qthreads library.  Chaos results.  We also cannot use
-// an atomic var, because with CHPL_ATOMICS=locks those are implemented
-// by means of sync vars.  So, we use a pthread mutex.  Note that this
-// is only safe if we cannot switch tasks on a pthread while holding the
-// mutex and then try to lock it recursively.  Currently that is the
-// case, since we do not yield while holding the mutex.
-// 
-static pthread_mutex_t memTrack_lockVar = PTHREAD_MUTEX_INITIALIZER;
 
+//
+// The batched total and high water mark are shared by all shards.
+// Where the compiler provides them we update these with atomic
+// intrinsics, which do not depend on the tasking layer; otherwise we
+// fall back to a mutex.
+//
+#ifndef __GNUC__
+static pthread_mutex_t memTotals_lockVar = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static inline
+size_t addTotalMem(size_t chunk) {
+#ifdef __GNUC__
+  return __atomic_add_fetch(&totalMem, chunk, __ATOMIC_RELAXED);
+#else
+  size_t newTotal;
+  (void) pthread_mutex_lock(&memTotals_lockVar);
+  newTotal = (totalMem += chunk);
+  (void) pthread_mutex_unlock(&memTotals_lockVar);
+  return newTotal;
+#endif
+}
+
+static inline
+void subTotalMem(size_t chunk) {
+#ifdef __GNUC__
+  (void) __atomic_sub_fetch(&totalMem, chunk, __ATOMIC_RELAXED);
+#else
+  (void) pthread_mutex_lock(&memTotals_lockVar);
+  totalMem -= chunk;
+  (void) pthread_mutex_unlock(&memTotals_lockVar);
+#endif
+}
+
+static inline
+void raiseMaxMem(size_t newTotal) {
+#ifdef __GNUC__
+  size_t oldMax = __atomic_load_n(&maxMem, __ATOMIC_RELAXED);
+  while (newTotal > oldMax
+         && !__atomic_compare_exchange_n(&maxMem, &oldMax, newTotal, true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    ;
+#else
+  (void) pthread_mutex_lock(&memTotals_lockVar);
+  if (newTotal > maxMem)
+    maxMem = newTotal;
+  (void) pthread_mutex_unlock(&memTotals_lockVar);
+#endif
+}
+
+static inline
+size_t readMemTotal(size_t* total) {
+#ifdef __GNUC__
+  return __atomic_load_n(total, __ATOMIC_RELAXED);
+#else
+  size_t val;
+  (void) pthread_mutex_lock(&memTotals_lockVar);
+  val = *total;
+  (void) pthread_mutex_unlock(&memTotals_lockVar);
+  return val;
+#endif
+}
+
+
+static inline
+void memShard_lock(memTableShard* shard) {
+  (void) pthread_mutex_lock(&shard->lock);
+}
+
+static inline
+void memShard_unlock(memTableShard* shard) {
+  (void) pthread_mutex_unlock(&shard->lock);
+}
+
+static void memShards_lockAll(void) {
+  for (int i = 0; i < NUM_MEM_TABLE_SHARDS; i++)
+    memShard_lock(&memShards[i]);
+}
+
+static void memShards_unlockAll(void) {
+  for (int i = NUM_MEM_TABLE_SHARDS - 1; i >= 0; i--)
+    memShard_unlock(&memShards[i]);
+}
+
+
+//
+// Scramble an allocation address so that both the shard (low bits) and
+// the sampled-address filter index are spread evenly, even though
+// allocators hand out addresses with regular alignment and spacing.
+//
 static inline
-void memTrack_lock(void) {
-  (void) pthread_mutex_lock(&memTrack_lockVar);
+uint64_t addrMix(void* memAlloc) {
+  uint64_t h = (uint64_t) (uintptr_t) memAlloc;
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
 }
 
 static inline
-void memTrack_unlock(void) {
-  (void) pthread_mutex_unlock(&memTrack_lockVar);
+memTableShard* shardFor(uint64_t mix) {
+  return &memShards[mix & (NUM_MEM_TABLE_SHARDS - 1)];
 }
 
+//
+// With --memTrackSample=N, allocations are sampled as if a sample were
+// taken at a random byte once every N bytes allocated, on average.  Each
+// thread counts down the bytes to its next sample, drawing the distance
+// from an exponential distribution with mean N, so an allocation of
+// size bytes is sampled with probability 1-exp(-size/N) whatever its
+// address or what came before it.  A sampled allocation stands for the
+// inverse of that probability, so small ones count for about N/size
+// allocations and ones much larger than N count for one.
+//
+typedef struct {
+  double bytesLeft;   /* bytes to allocate before the next sample */
+  uint64_t rand;      /* PRNG state */
+} memSampleState;
+
+static CHPL_TLS_DECL(memSampleState*, memSampleTLS);
+static uint64_t memSampleSeed = 0;
+
+static inline
+_Bool isSampling(void) {
+  return memTrackSample > 1;
+}
+
+// splitmix64; its output is well mixed even from sequential seeds.
+static inline
+uint64_t sampleRand(memSampleState* st) {
+  uint64_t z = (st->rand += UINT64_C(0x9e3779b97f4a7c15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return z ^ (z >> 31);
+}
+
+static inline
+double nextSampleInterval(memSampleState* st) {
+  // uniform in (0,1], from the top 53 bits
+  double u = ((sampleRand(st) >> 11) + 1) * (1.0 / 9007199254740992.0);
+  return -log(u) * (double) memTrackSample;
+}
+
+//
+// Each thread's state is made on its first tracked allocation.  Where
+// there is no __thread it is freed at thread exit; otherwise it is left
+// behind, which is fine since our threads live for the whole run.
+//
+static void freeSampleState(void* st) {
+  sys_free(st);
+}
+
+static memSampleState* getSampleState(void) {
+  memSampleState* st = (memSampleState*) CHPL_TLS_GET(memSampleTLS);
+  if (st == NULL) {
+    st = (memSampleState*) sys_calloc(1, sizeof(memSampleState));
+    if (!st)
+      chpl_internal_error("memtrack fault: out of memory for sampling state");
+#ifdef __GNUC__
+    st->rand = __atomic_add_fetch(&memSampleSeed, 1, __ATOMIC_RELAXED);
+#else
+    st->rand = ++memSampleSeed;
+#endif
+    st->rand ^= (uint64_t) (uintptr_t) st;
+    st->bytesLeft = nextSampleInterval(st);
+    CHPL_TLS_SET(memSampleTLS, st);
+  }
+  return st;
+}
+
+//
+// Decide whether to record an allocation of the given size.  Returns
+// the number of allocations the entry stands for, or 0 to skip it.
+//
+static inline
+double sampleWeight(size_t size) {
+  memSampleState* st;
+  if (!isSampling())
+    return 1;
+  st = getSampleState();
+  if ((double) size < st->bytesLeft) {
+    st->bytesLeft -= size;
+    return 0;
+  }
+  st->bytesLeft = nextSampleInterval(st);
+  return -1.0 / expm1(-(double) size / (double) memTrackSample);
+}
+
+//
+// Sampled entries are few and scattered, so a free would nearly always
+// search its shard's table for nothing.  Instead we keep a count of the
+// sampled entries whose address mixes to each slot of this filter, and
+// a free only takes the shard lock if its slot is nonzero.  The low bits
+// of the slot index select the shard, so each slot is only written
+// under its own shard's lock.
+//
+#define SAMPLE_FILTER_BITS 16
+static uint32_t* sampleFilter = NULL;
+
+static inline
+uint32_t* sampleFilterSlot(uint64_t mix) {
+  return &sampleFilter[mix & (((uint64_t) 1 << SAMPLE_FILTER_BITS) - 1)];
+}
+
+static inline
+void sampleFilterAdjust(uint64_t mix, int delta) {
+  uint32_t* slot = sampleFilterSlot(mix);
+#ifdef __GNUC__
+  __atomic_store_n(slot, *slot + delta, __ATOMIC_RELAXED);
+#else
+  *slot += delta;
+#endif
+}
+
+static inline
+_Bool mayBeTracked(uint64_t mix) {
+#ifdef __GNUC__
+  return !isSampling()
+         || __atomic_load_n(sampleFilterSlot(mix), __ATOMIC_RELAXED) != 0;
+#else
+  return true;
+#endif
+}
 
 
 void chpl_setMemFlags(void) {
@@ -154,6 +403,7 @@ void chpl_setMemFlags(void) {
                                     &memLeaks,
                                     &memMax,
                                     &memThreshold,
+                                    &memTrackSample,
                                     &memLog,
                                     &memLeaksLog);
 
@@ -163,8 +413,23 @@ void chpl_setMemFlags(void) {
                    || (memLeaksByDesc && strcmp(memLeaksByDesc, ""))
                    || memLeaks
                    || memMax > 0
+                   || memTrackSample > 0
                    || memLeaksLog != NULL);
-  
+
+  //
+  // The memMax limit has to be checked against the exact total, and a
+  // free only tells us its size if the allocation was recorded.  So
+  // with a limit every allocation is recorded and sampling is off.
+  //
+  if (memMax > 0) {
+    if (isSampling() && chpl_nodeID == 0)
+      chpl_warning("--memTrackSample is ignored when --memMax is set", 0, 0);
+    memTrackSample = 0;
+    memBatch = memMax / (NUM_MEM_TABLE_SHARDS * 64);
+    if (memBatch > MEM_BATCH_MAX)
+      memBatch = MEM_BATCH_MAX;
+  }
+
 
   if (!memLog) {
     memLogFile = stdout;
@@ -180,9 +445,18 @@ void chpl_setMemFlags(void) {
   }
 
   if (chpl_memTrack) {
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+    for (int i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+      memTableShard* shard = &memShards[i];
+      (void) pthread_mutex_init(&shard->lock, NULL);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->table = sys_calloc(shard->hashSize, sizeof(memTableEntry*));
+    }
+    if (isSampling()) {
+      CHPL_TLS_INIT2(memSampleTLS, freeSampleState);
+      sampleFilter = sys_calloc((size_t) 1 << SAMPLE_FILTER_BITS,
+                                sizeof(uint32_t));
+    }
   }
 }
 
@@ -199,37 +473,80 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+// The memory an entry accounts for, scaled up if it was sampled.
+static inline
+size_t entryMem(memTableEntry* me) {
+  size_t chunk = me->number * me->size;
+  return (me->weight == 1) ? chunk : (size_t) (chunk * me->weight + 0.5);
+}
+
+
+static void increaseMemStat(memTableShard* shard, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  size_t total;
+  shard->totalAllocated += chunk;
+  shard->liveMem += chunk;
+  shard->pendingMem += chunk;
+  if (shard->pendingMem >= (int64_t) memBatch) {
+    total = addTotalMem(shard->pendingMem);
+    shard->pendingMem = 0;
+    raiseMaxMem(total);
+  } else {
+    total = readMemTotal(&totalMem) + shard->pendingMem;
+  }
+  if (memMax && (total > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
 }
 
 
-static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+static void decreaseMemStat(memTableShard* shard, size_t chunk) {
+  shard->totalFreed += chunk;
+  shard->liveMem -= chunk;
+  shard->pendingMem -= chunk;
+  if (shard->pendingMem <= -(int64_t) memBatch) {
+    subTotalMem(-shard->pendingMem);
+    shard->pendingMem = 0;
+  }
+}
+
+
+// Sum the per-shard allocated, freed, and current counts.
+static void sumMemStats(size_t* allocated, size_t* freed, size_t* live) {
+  *allocated = 0;
+  *freed = 0;
+  *live = 0;
+  for (int i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+    memShard_lock(&memShards[i]);
+    *allocated += memShards[i].totalAllocated;
+    *freed += memShards[i].totalFreed;
+    *live += memShards[i].liveMem;
+    memShard_unlock(&memShards[i]);
+  }
+}
+
+
+static size_t liveMemTotal(void) {
+  size_t allocated, freed, live;
+  sumMemStats(&allocated, &freed, &live);
+  return live;
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTableShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->table[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -237,20 +554,23 @@ resizeTable(int direction) {
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(shard->table);
+  shard->table = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+static void addMemTableEntry(memTableShard* shard, uint64_t mix,
+                             void *memAlloc, size_t number, size_t size,
+                             double weight,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shard->totalEntries+1)*2 > shard->hashSize
+      && shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
 
   memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
@@ -258,49 +578,45 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                lineno, filename);
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->table[hashValue];
+  shard->table[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  memEntry->weight = weight;
+  increaseMemStat(shard, entryMem(memEntry), lineno, filename);
+  shard->totalEntries += 1;
+  if (isSampling())
+    sampleFilterAdjust(mix, 1);
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+static memTableEntry* removeMemTableEntry(memTableShard* shard, uint64_t mix,
+                                          void* address) {
+  unsigned hashValue = hash(address, shard->hashSize);
+  memTableEntry** link;
   memTableEntry* deletedBucket = NULL;
 
-  if (!thisBucketEntry)
-    return NULL;
-
-  if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
-    deletedBucket = thisBucketEntry;
-  } else {
-    for (thisBucketEntry = memTable[hashValue];
-         thisBucketEntry != NULL;
-         thisBucketEntry = thisBucketEntry->nextInBucket) {
-
-      memTableEntry* nextBucketEntry = thisBucketEntry->nextInBucket;
-
-      if (nextBucketEntry && nextBucketEntry->memAlloc == address) {
-        thisBucketEntry->nextInBucket = nextBucketEntry->nextInBucket;
-        deletedBucket = nextBucketEntry;
-      }
+  for (link = &shard->table[hashValue]; *link != NULL;
+       link = &(*link)->nextInBucket) {
+    if ((*link)->memAlloc == address) {
+      deletedBucket = *link;
+      *link = deletedBucket->nextInBucket;
+      break;
     }
   }
+
   if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    decreaseMemStat(shard, entryMem(deletedBucket));
+    shard->totalEntries -= 1;
+    if (isSampling())
+      sampleFilterAdjust(mix, -1);
+    if (shard->totalEntries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+      resizeTable(shard, -1);
   }
   return deletedBucket;
 }
@@ -313,7 +629,7 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
     return 0;
   }
 
-  return (uint64_t)totalMem;
+  return (uint64_t)liveMemTotal();
 }
 
 
@@ -344,18 +660,31 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
              nodeWidth, chpl_nodeID);
   }
 
+  //
+  // Snapshot the statistics.  They are spread across the shards, so
+  // this is not an atomic snapshot of the whole table, but each shard's
+  // contribution is self-consistent.  The high water mark is only
+  // raised as shards pass on their batches, so it can be low by up to
+  // a batch per shard; at least it is never below the current total.
+  //
+  size_t totalAllocated, totalFreed, totalLive, highWater;
+  sumMemStats(&totalAllocated, &totalFreed, &totalLive);
+  highWater = readMemTotal(&maxMem);
+  if (highWater < totalLive)
+    highWater = totalLive;
+
   //
   // Take a pre-run through the descriptions and values to figure
   // out how long each line will need to be.
   //
-  static const struct {
+  const struct {
     const char* desc;
-    size_t* val;
+    size_t val;
   } descsVals[] = {
-    { "Allocated Now:", &totalMem },
-    { "Allocation High Water Mark:", &maxMem },
-    { "Sum of Allocations:", &totalAllocated },
-    { "Sum of Frees:", &totalFreed },
+    { "Allocated Now:", totalLive },
+    { "Allocation High Water Mark:", highWater },
+    { "Sum of Allocations:", totalAllocated },
+    { "Sum of Frees:", totalFreed },
   };
   const int nDescsVals = sizeof(descsVals) / sizeof(descsVals[0]);
 
@@ -367,9 +696,9 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     if (thisDescWidth > descWidth)
       descWidth = thisDescWidth;
     const int thisMemWidth =
-                (*descsVals[i].val == 0)
+                (descsVals[i].val == 0)
                 ? 1
-                : (int) lrint(ceil(log10((double) *descsVals[i].val)));
+                : (int) lrint(ceil(log10((double) descsVals[i].val)));
     if (thisMemWidth > memWidth)
       memWidth = thisMemWidth;
   }
@@ -381,19 +710,15 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   char buf[4 * (strlen(prefixBuf) + 1 + descWidth + 1 + memWidth + 1) + 1];
   size_t len;
 
-  memTrack_lock();
-
   len = 0;
   for (int i = 0; i < nDescsVals; i++) {
     len += snprintf(buf + len, sizeof(buf) - len,
                     "%s %-*s %*zd\n",
                     prefixBuf,
                     descWidth, descsVals[i].desc,
-                    memWidth, *descsVals[i].val);
+                    memWidth, descsVals[i].val);
   }
 
-  memTrack_unlock();
-
   fputs(buf, memLogFile);
 }
 
@@ -407,6 +732,7 @@ static int memTableEntryCmp(const void* p1, const void* p2) {
 static void printMemAllocsByType(_Bool forLeaks,
                                  int32_t lineno, int32_t filename) {
   size_t* table;
+  double* counts;
   memTableEntry* me;
   int i;
   const int numberWidth   = 9;
@@ -420,14 +746,24 @@ static void printMemAllocsByType(_Bool forLeaks,
   }
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
-
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  counts = (double*)sys_calloc(numEntries, sizeof(double));
+
+  memShards_lockAll();
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->table[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += entryMem(me);
+        counts[me->description] += me->weight;
+        table[3*me->description+2] = me->description;
+      }
     }
   }
+  memShards_unlockAll();
+
+  for (i = 0; i < numEntries; i++)
+    table[3*i+1] = (size_t) (counts[i] + 0.5);
+  sys_free(counts);
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
 
@@ -447,6 +783,9 @@ static void printMemAllocsByType(_Bool forLeaks,
   }
 
   fprintf(memLogFile, "                      Description of allocation\n");
+  if (memTrackSample > 1)
+    fprintf(memLogFile, "(estimated from a sample per %zu bytes allocated)\n",
+            memTrackSample);
   fprintf(memLogFile, "==============================================================\n");
   for (i = 0; i < 3*(CHPL_RT_MD_NUM+chpl_mem_numDescs); i += 3) {
     if (table[i] > 0) {
@@ -537,21 +876,27 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     return;
   }
 
+  memShards_lockAll();
+
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL;
+           memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        n += 1;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
   }
@@ -584,14 +929,18 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     chpl_error("out of memory printing memory table", lineno, filename);
 
   n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL;
+           memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        table[n++] = memEntry;
+      }
     }
   }
   qsort(table, n, sizeof(memTableEntry*), descCmp);
@@ -606,14 +955,38 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     } else {
       sprintf(loc, "--");
     }
-    fprintf(memLogFile, "%-*s%-*zu%-*zu%-*zu%-*s%#-*.*" PRIxPTR "\n",
-           filenameWidth+numberWidth, loc,
-           numberWidth, memEntry->number,
-           numberWidth, memEntry->size,
-           numberWidth, memEntry->size*memEntry->number,
-           descWidth, chpl_mem_descString(memEntry->description),
-           addressWidth, precision, (uintptr_t)memEntry->memAlloc);
+    if (memTrackSample > 1) {
+      //
+      // Individual sampled addresses mean little, so report one
+      // estimated row per allocation site instead.
+      //
+      double weighted = memEntry->number * memEntry->weight;
+      size_t number, total = entryMem(memEntry);
+      while (i + 1 < n && descCmp(&table[i], &table[i + 1]) == 0) {
+        i++;
+        weighted += table[i]->number * table[i]->weight;
+        total += entryMem(table[i]);
+      }
+      number = (size_t) (weighted + 0.5);
+      fprintf(memLogFile, "%-*s%-*zu%-*zu%-*zu%-*s%-*s\n",
+             filenameWidth+numberWidth, loc,
+             numberWidth, number,
+             numberWidth, (number == 0) ? 0 : total / number,
+             numberWidth, total,
+             descWidth, chpl_mem_descString(memEntry->description),
+             addressWidth, "(sampled)");
+    } else {
+      fprintf(memLogFile, "%-*s%-*zu%-*zu%-*zu%-*s%#-*.*" PRIxPTR "\n",
+             filenameWidth+numberWidth, loc,
+             numberWidth, memEntry->number,
+             numberWidth, memEntry->size,
+             numberWidth, memEntry->size*memEntry->number,
+             descWidth, chpl_mem_descString(memEntry->description),
+             addressWidth, precision, (uintptr_t)memEntry->memAlloc);
+    }
   }
+  memShards_unlockAll();
+
   for (i = 0; i < totalWidth; i++)
     fprintf(memLogFile, "=");
   fprintf(memLogFile, "\n");
@@ -630,19 +1003,19 @@ void chpl_reportMemInfo() {
     chpl_printMemAllocStats(0, 0);
   }
   if (memLeaksByType) {
-    if (totalMem) {
+    if (liveMemTotal()) {
       fprintf(memLogFile, "\n");
       printMemAllocsByType(true /* forLeaks */, 0, 0);
     }
   }
   if (memLeaksByDesc && strcmp(memLeaksByDesc, "")) {
-    if (totalMem) {
+    if (liveMemTotal()) {
       fprintf(memLogFile, "\n");
       chpl_printMemAllocsByDesc(memLeaksByDesc, memThreshold, 0, 0);
     }
   }
   if (memLeaks) {
-    if (totalMem) {
+    if (liveMemTotal()) {
       fprintf(memLogFile, "\n");
       printMemAllocs(-1, memThreshold, 0, 0);
     }
@@ -666,9 +1039,15 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        int32_t lineno, int32_t filename) {
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      memTrack_unlock();
+      double weight = sampleWeight(number * size);
+      if (weight > 0) {
+        uint64_t mix = addrMix(memAlloc);
+        memTableShard* shard = shardFor(mix);
+        memShard_lock(shard);
+        addMemTableEntry(shard, mix, memAlloc, number, size, weight,
+                         description, lineno, filename);
+        memShard_unlock(shard);
+      }
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -684,8 +1063,13 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
   if (chpl_memTrack) {
-    memTrack_lock();
-    memEntry = removeMemTableEntry(memAlloc);
+    uint64_t mix = addrMix(memAlloc);
+    memTableShard* shard;
+    if (!mayBeTracked(mix))
+      return;
+    shard = shardFor(mix);
+    memShard_lock(shard);
+    memEntry = removeMemTableEntry(shard, mix, memAlloc);
     if (memEntry) {
       if (chpl_verbose_mem) {
         fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -696,7 +1080,7 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       sys_free(memEntry);
     }
-    memTrack_unlock();
+    memShard_unlock(shard);
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -710,14 +1094,16 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
                          int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
 
-  if (chpl_memTrack && size > memThreshold) {
-    memTrack_lock();
-    if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
+  if (chpl_memTrack && size > memThreshold && memAlloc) {
+    uint64_t mix = addrMix(memAlloc);
+    if (mayBeTracked(mix)) {
+      memTableShard* shard = shardFor(mix);
+      memShard_lock(shard);
+      memEntry = removeMemTableEntry(shard, mix, memAlloc);
+      memShard_unlock(shard);
       if (memEntry)
         sys_free(memEntry);
     }
-    memTrack_unlock();
   }
 }
 
@@ -728,9 +1114,15 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          int32_t lineno, int32_t filename) {
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      memTrack_unlock();
+      double weight = sampleWeight(size);
+      if (weight > 0) {
+        uint64_t mix = addrMix(moreMemAlloc);
+        memTableShard* shard = shardFor(mix);
+        memShard_lock(shard);
+        addMemTableEntry(shard, mix, moreMemAlloc, 1, size, weight,
+                         description, lineno, filename);
+        memShard_unlock(shard);
+      }
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
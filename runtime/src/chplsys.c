@@ -414,6 +414,30 @@ uint64_t chpl_sys_physicalMemoryBytes(void) {
 #endif
 }
 
+size_t chpl_sys_getCacheSize(int level) {
+  long int size = -1;
+
+  //
+  // The sysconf() cache queries are a glibc extension.  Where they
+  // aren't available, or the answer isn't known, return 0 and let the
+  // caller pick a default.
+  //
+  switch (level) {
+#if defined _SC_LEVEL1_DCACHE_SIZE
+  case 1: size = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+#endif
+#if defined _SC_LEVEL2_CACHE_SIZE
+  case 2: size = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+#endif
+#if defined _SC_LEVEL3_CACHE_SIZE
+  case 3: size = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+#endif
+  default: break;
+  }
+
+  return (size > 0) ? (size_t) size : 0;
+}
+
 #if defined(__linux__) || defined(__NetBSD__)
 //
 // Return information about the processors on the system.
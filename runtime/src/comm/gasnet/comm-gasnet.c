@@ -252,6 +252,7 @@ typedef enum {
   PRIV_BCAST_LARGE,     // put data at addr (used for private broadcast)
   FREE,                 // free data at addr
   SHUTDOWN,             // tell nodes to get ready for shutdown
+  GATHER_SEGINFO,       // gather segment info table entries on node 0
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
   DO_COPY_PAYLOAD       // copy AM payload to another address
@@ -542,6 +543,17 @@ static void AM_shutdown(gasnet_token_t token) {
 // was modeled after the _test_segbcast() routine in
 // third-party/gasnet/gasnet-src/tests/test.h
 //
+static atomic_uint_least32_t gather_seginfo_count;
+static void AM_gather_seginfo(gasnet_token_t token, void *buf, size_t nbytes) {
+  gasnet_node_t src;
+  assert(nbytes == sizeof(gasnet_seginfo_t));
+  GASNET_Safe(gasnet_AMGetMsgSource(token, &src));
+  chpl_memcpy(&seginfo_table[src], buf, nbytes);
+  gasnett_local_wmb();
+  (void) atomic_fetch_add_explicit_uint_least32_t(&gather_seginfo_count, 1,
+                                                  memory_order_seq_cst);
+}
+
 static int bcast_seginfo_done = 0;
 static void AM_bcast_seginfo(gasnet_token_t token, void *buf, size_t nbytes) {
   assert(nbytes == sizeof(gasnet_seginfo_t)*gasnet_nodes());
@@ -591,6 +603,7 @@ static gasnet_handlerentry_t ftable[] = {
   {PRIV_BCAST_LARGE, AM_priv_bcast_large},
   {FREE,          AM_free},
   {SHUTDOWN,      AM_shutdown},
+  {GATHER_SEGINFO, AM_gather_seginfo},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
   {DO_COPY_PAYLOAD, AM_copy_payload}
@@ -869,33 +882,33 @@ void chpl_comm_init(int *argc_p, char ***argv_p) {
   // _test_attach() routine from third-party/gasnet/gasnet-src/tests/test.h
   // but is significantly simplified for our purposes.
   //
-  if (chpl_nodeID == 0) {
-    int i;
-    //
-    // Only locale #0 really needs the seginfo_table to store anything since it owns all
-    // of the global variable locations; everyone else will just peek at its copy.  So
-    // locale 0 sets up its segment to an appropriate size:
-    //
+  // Every locale sets up its own segment, big enough to hold the
+  // global variables' wide pointers, since the broadcast of those
+  // moves them down a tree and GETs from the front of each segment.
+  //
+  {
     int global_table_size = chpl_numGlobalsOnHeap * sizeof(wide_ptr_t) + GASNETT_PAGESIZE;
     void* global_table = sys_malloc(global_table_size);
-    seginfo_table[0].addr = ((void *)(((uint8_t*)global_table) +
-                                      (((((uintptr_t)global_table)%GASNETT_PAGESIZE) == 0)? 0 :
-                                       (GASNETT_PAGESIZE-(((uintptr_t)global_table)%GASNETT_PAGESIZE)))));
-    seginfo_table[0].size = global_table_size;
-    //
-    // ...and then zeroes out everyone else's
-    //
-    for (i=1; i<chpl_numNodes; i++) {
-      seginfo_table[i].addr = NULL;
-      seginfo_table[i].size = 0;
-    }
+    seginfo_table[chpl_nodeID].addr = ((void *)(((uint8_t*)global_table) +
+                                                (((((uintptr_t)global_table)%GASNETT_PAGESIZE) == 0)? 0 :
+                                                 (GASNETT_PAGESIZE-(((uintptr_t)global_table)%GASNETT_PAGESIZE)))));
+    seginfo_table[chpl_nodeID].size = global_table_size;
   }
   //
-  // Then we're going to broadcast the seginfo_table to everyone so that each locale
-  // has its own copy of it and knows where everyone else's segment lives (or, really,
-  // where locale #0's lives since we're not using anyone else's at this point).
+  // Then we're going to gather everyone's entry on locale #0 and
+  // broadcast the seginfo_table to everyone so that each locale has
+  // its own copy of it and knows where everyone else's segment lives.
   //
+  atomic_init_uint_least32_t(&gather_seginfo_count, 0);
   chpl_comm_barrier("getting ready to broadcast addresses");
+  if (chpl_nodeID != 0) {
+    GASNET_Safe(gasnet_AMRequestMedium0(0, GATHER_SEGINFO,
+                                        &seginfo_table[chpl_nodeID],
+                                        sizeof(gasnet_seginfo_t)));
+  } else {
+    GASNET_BLOCKUNTIL(atomic_load_uint_least32_t(&gather_seginfo_count)
+                      == (uint_least32_t) (chpl_numNodes - 1));
+  }
   //
   // This is a naive O(numLocales) broadcast; we could do something
   // more scalable with more effort
@@ -959,24 +972,37 @@ void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p) {
 #endif
 }
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) {
+wide_ptr_t** chpl_comm_broadcast_global_vars_helper(void) {
   //
   // Gather the global variables' wide pointers on node 0 into the
-  // buffer at the front of our communicable segment.  We don't have
-  // to communicate that because everyone already knows where it is.
-  // We do need to delay returning on the non-0 nodes until after
-  // node 0 has filled in that buffer, however.
+  // buffer at the front of our communicable segment.  Every node has
+  // such a buffer at the front of its segment, and we already know
+  // where all the segments are, so the table of buffers doesn't need
+  // any communication.  We do need to delay returning on the non-0
+  // nodes until after node 0 has filled in its buffer, however.
   //
+  wide_ptr_t** bufs;
+  bufs = (wide_ptr_t**) chpl_mem_allocMany(chpl_numNodes, sizeof(*bufs),
+                                           CHPL_RT_MD_COMM_PER_LOC_INFO,
+                                           0, 0);
+  for (int i = 0; i < chpl_numNodes; i++) {
+    bufs[i] = (wide_ptr_t*) seginfo_table[i].addr;
+  }
+
   if (chpl_nodeID == 0) {
     for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
-      ((wide_ptr_t*) seginfo_table[0].addr)[i] = *chpl_globals_registry[i];
+      bufs[0][i] = *chpl_globals_registry[i];
     }
-    chpl_comm_barrier("fill node 0 globals buf");
-    return NULL; // so common code won't try to free it!
-  } else {
-    chpl_comm_barrier("fill node 0 globals buf");
-    return (wide_ptr_t*) seginfo_table[0].addr;
   }
+  chpl_comm_barrier("fill node 0 globals buf");
+  return bufs;
+}
+
+void chpl_comm_broadcast_global_vars_helper_fini(wide_ptr_t** bufs) {
+  //
+  // The buffers are part of the segments; only the table is ours.
+  //
+  chpl_mem_free(bufs, 0, 0);
 }
 
 void chpl_comm_broadcast_private(int id, size_t size) {
@@ -148,7 +148,9 @@ void chpl_comm_rollcall(void) {
   chpl_msg(2, "executing on a single node\n");
 }
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) { return NULL; }
+wide_ptr_t** chpl_comm_broadcast_global_vars_helper(void) { return NULL; }
+
+void chpl_comm_broadcast_global_vars_helper_fini(wide_ptr_t** bufs) { }
 
 void chpl_comm_broadcast_private(int id, size_t size) { }
 
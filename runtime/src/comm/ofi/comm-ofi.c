@@ -2628,23 +2628,35 @@ void chpl_comm_rollcall(void) {
 // Chapel global and private variable support
 //
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) {
+wide_ptr_t** chpl_comm_broadcast_global_vars_helper(void) {
   DBG_PRINTF(DBG_IFACE_SETUP, "%s()", __func__);
 
   //
   // Gather the global variables' wide pointers on node 0 into a
-  // buffer, and broadcast the address of that buffer to the other
-  // nodes.
+  // buffer, and share the addresses of all the nodes' buffers around.
+  // The allgather also ensures node 0 has filled its buffer before
+  // anyone can GET from it.
   //
   wide_ptr_t* buf;
+  CHPL_CALLOC(buf, chpl_numGlobalsOnHeap);
   if (chpl_nodeID == 0) {
-    CHPL_CALLOC(buf, chpl_numGlobalsOnHeap);
     for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
       buf[i] = *chpl_globals_registry[i];
     }
   }
-  chpl_comm_ofi_oob_bcast(&buf, sizeof(buf));
-  return buf;
+
+  wide_ptr_t** bufs;
+  CHPL_CALLOC(bufs, chpl_numNodes);
+  chpl_comm_ofi_oob_allgather(&buf, bufs, sizeof(buf));
+  return bufs;
+}
+
+
+void chpl_comm_broadcast_global_vars_helper_fini(wide_ptr_t** bufs) {
+  DBG_PRINTF(DBG_IFACE_SETUP, "%s()", __func__);
+
+  CHPL_FREE(bufs[chpl_nodeID]);
+  CHPL_FREE(bufs);
 }
 
 
@@ -2672,12 +2684,17 @@ void init_broadcast_private(void) {
 void chpl_comm_broadcast_private(int id, size_t size) {
   DBG_PRINTF(DBG_IFACE_SETUP, "%s(%d, %zd)", __func__, id, size);
 
+  //
+  // Use buffered PUTs, so that small entries go out in batches rather
+  // than one round trip per node.  The flush waits for all of them.
+  //
   for (int i = 0; i < chpl_numNodes; i++) {
     if (i != chpl_nodeID) {
-      (void) ofi_put(chpl_rt_priv_bcast_tab[id], i,
-                     chplPrivBcastTabMap[i][id], size);
+      do_remote_put_buff(chpl_rt_priv_bcast_tab[id], i,
+                         chplPrivBcastTabMap[i][id], size);
     }
   }
+  task_local_buff_flush(put_buff);
 }
 
 
@@ -3867,22 +3867,55 @@ void regMemBroadcast(int mr_i, int mr_cnt, chpl_bool send_mreg_cnt)
 }
 
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper() {
+wide_ptr_t** chpl_comm_broadcast_global_vars_helper(void) {
   //
   // Gather the global variables' wide pointers on node 0 into a
-  // buffer, and broadcast the address of that buffer to the other
-  // nodes.
+  // buffer, and share the addresses of all the nodes' buffers around.
+  // The allgather also ensures node 0 has filled its buffer before
+  // anyone can GET from it.
   //
   wide_ptr_t* buf;
+  buf = (wide_ptr_t*) chpl_mem_allocMany(chpl_numGlobalsOnHeap, sizeof(*buf),
+                                         CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
   if (chpl_nodeID == 0) {
-    buf = (wide_ptr_t*) chpl_mem_allocMany(chpl_numGlobalsOnHeap, sizeof(*buf),
-                                           CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
     for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
       buf[i] = *chpl_globals_registry[i];
     }
   }
-  PMI_Bcast(&buf, sizeof(buf));
-  return buf;
+
+  {
+    typedef struct {
+      c_nodeid_t  nodeID;
+      wide_ptr_t* buf;
+    } gdata_t;
+
+    gdata_t  my_gdata = { chpl_nodeID, buf };
+    gdata_t* gdata;
+    wide_ptr_t** bufs;
+
+    gdata = (gdata_t*) chpl_mem_allocMany(chpl_numNodes, sizeof(gdata[0]),
+                                          CHPL_RT_MD_COMM_PER_LOC_INFO,
+                                          0, 0);
+    if (PMI_Allgather(&my_gdata, gdata, sizeof(gdata[0])) != PMI_SUCCESS)
+      CHPL_INTERNAL_ERROR("PMI_Allgather(global vars bufs) failed");
+
+    bufs = (wide_ptr_t**) chpl_mem_allocMany(chpl_numNodes, sizeof(*bufs),
+                                             CHPL_RT_MD_COMM_PER_LOC_INFO,
+                                             0, 0);
+    for (int i = 0; i < chpl_numNodes; i++) {
+      bufs[gdata[i].nodeID] = gdata[i].buf;
+    }
+
+    chpl_mem_free(gdata, 0, 0);
+    return bufs;
+  }
+}
+
+
+void chpl_comm_broadcast_global_vars_helper_fini(wide_ptr_t** bufs)
+{
+  chpl_mem_free(bufs[chpl_nodeID], 0, 0);
+  chpl_mem_free(bufs, 0, 0);
 }
 
 
@@ -3893,18 +3926,36 @@ void chpl_comm_broadcast_private(int id, size_t size)
   DBG_P_LP(DBGF_IFACE, "IFACE chpl_comm_broadcast_private(%d, %zd)", id, size);
 
   //
-  // TODO: Currently this does a PUT and wait for remote completion to
-  //       each remote locale.  A performance improvement would be to
-  //       do all, or a batch of, the PUTs and only then wait for the
-  //       associated CQ events.
+  // Do the PUTs in chained batches, and only wait for the associated
+  // CQ events at the end of each batch rather than after every PUT.
   //
+  void* src_v[MAX_CHAINED_PUT_LEN];
+  int32_t node_v[MAX_CHAINED_PUT_LEN];
+  void* tgt_v[MAX_CHAINED_PUT_LEN];
+  size_t size_v[MAX_CHAINED_PUT_LEN];
+  int vi;
+
+  vi = 0;
   for (i = 0; i < chpl_numNodes; i++) {
     if (i != chpl_nodeID) {
-      do_remote_put(chpl_rt_priv_bcast_tab[id], i,
-                    chpl_rt_priv_bcast_tab[id], size,
-                    NULL, may_proxy_true);
+      if (vi >= MAX_CHAINED_PUT_LEN) {
+        do_remote_put_V(vi, src_v, node_v, tgt_v, size_v, NULL,
+                        may_proxy_true);
+        vi = 0;
+      }
+
+      src_v[vi] = chpl_rt_priv_bcast_tab[id];
+      node_v[vi] = i;
+      tgt_v[vi] = chpl_rt_priv_bcast_tab[id];
+      size_v[vi] = size;
+      vi++;
     }
   }
+
+  if (vi > 0) {
+    do_remote_put_V(vi, src_v, node_v, tgt_v, size_v, NULL,
+                    may_proxy_true);
+  }
 }
 
 
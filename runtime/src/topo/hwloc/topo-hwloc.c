@@ -308,6 +308,38 @@ void getNumCPUs(void) {
 }
 
 
+//
+// What is the size of the cache at a given level?
+//
+size_t chpl_topo_getCacheSize(int level) {
+  if (!haveTopology) {
+    return chpl_sys_getCacheSize(level);
+  }
+
+  //
+  // Walk up from the first PU to the first cache at the requested
+  // level, skipping instruction caches.
+  //
+  hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_PU, 0);
+  for ( ; obj != NULL; obj = obj->parent) {
+#if HWLOC_API_VERSION >= 0x00020000
+    if (hwloc_obj_type_is_dcache(obj->type)
+        && obj->attr->cache.depth == (unsigned) level) {
+      return obj->attr->cache.size;
+    }
+#else
+    if (obj->type == HWLOC_OBJ_CACHE
+        && obj->attr->cache.type != HWLOC_OBJ_CACHE_INSTRUCTION
+        && obj->attr->cache.depth == (unsigned) level) {
+      return obj->attr->cache.size;
+    }
+#endif
+  }
+
+  return chpl_sys_getCacheSize(level);
+}
+
+
 int chpl_topo_getNumNumaDomains(void) {
   return numNumaDomains;
 }
@@ -52,6 +52,11 @@ int chpl_topo_getNumCPUsLogical(chpl_bool accessible_only) {
 }
 
 
+size_t chpl_topo_getCacheSize(int level) {
+  return chpl_sys_getCacheSize(level);
+}
+
+
 int chpl_topo_getNumNumaDomains(void) {
   return 1;
 }
@@ -0,0 +1,63 @@
+use StencilDist;
+
+config const n = 20;
+
+const halo = (2,2);
+const Dom = {1..n, 1..n};
+const Space = Dom dmapped Stencil(Dom, fluff=halo);
+var A : [Space] int;
+
+proc reset() {
+  [(i,j) in Space] A[i,j] = i*n+j;
+  A.updateFluff();
+  [(i,j) in Space] A[i,j] = -(i*n+j);
+}
+
+//
+// Check that exactly the cached elements selected by 'depth' and 'sides'
+// hold the latest values.
+//
+proc check(name, depth, sides) {
+  var ok = true;
+  for loc in Locales do on loc {
+    const block = A.domain.localSubdomain();
+    if block.size > 0 {
+      for idx in block.expand(halo) {
+        if !Dom.contains(idx) || block.contains(idx) then continue;
+
+        var selected = true;
+        for param d in 0..1 {
+          const lo = block.dim(d).low, hi = block.dim(d).high;
+          const off = if idx(d) < lo then lo - idx(d)
+                      else if idx(d) > hi then idx(d) - hi
+                      else 0;
+          const side = if idx(d) < lo then -1 else 1;
+          if off > depth(d) || (off > 0 && sides(d) != 0 && sides(d) != side) then
+            selected = false;
+        }
+
+        const val = local do A[idx];
+        if (val < 0) != selected then ok = false;
+      }
+    }
+  }
+  writeln(name, ": ", if ok then "OK" else "FAILED");
+}
+
+reset();
+A.updateFluff();
+check("full", halo, (0,0));
+
+reset();
+A.updateFluff(depth=(1,0));
+check("depth (1,0)", (1,0), (0,0));
+
+reset();
+A.updateFluff(depth=(2,1), sides=(1,-1));
+check("sides (1,-1)", (2,1), (1,-1));
+
+reset();
+const update = A.updateFluffAsync(depth=(1,1));
+update.wait();
+check("async", (1,1), (0,0));
+writeln("isDone: ", update.isDone());
@@ -0,0 +1,46 @@
+// Element-wise accesses to remote parts of BlockCyclic and
+// DimensionalDist2D arrays go through the remote access data cache.
+// Check that reads and writes through it see the right elements.
+
+use BlockCycDist, DimensionalDist2D, BlockDim, BlockCycDim;
+
+config const n = 100;
+
+{
+  const D = {1..n} dmapped BlockCyclic(startIdx=1, blocksize=7);
+  var A: [D] int;
+
+  // serial writes from each locale reach every other locale's elements
+  for loc in Locales do on loc {
+    for i in D do A[i] += i;
+  }
+
+  var ok = true;
+  for loc in Locales do on loc {
+    for i in D do
+      if A[i] != i*numLocales then ok = false;
+  }
+  writeln("BlockCyclic: ", if ok then "OK" else "FAILED");
+}
+
+{
+  const (s1, s2) = if numLocales % 2 == 0 then (2, numLocales/2)
+                                          else (1, numLocales);
+  const targetLocs = reshape(Locales[0..#s1*s2], {0..#s1, 0..#s2});
+  const dm = new dmap(new DimensionalDist2D(targetLocs,
+                                            new BlockDim(s1, 1, n),
+                                            new BlockCyclicDim(s2, 1, 3)));
+  const D = {1..n, 1..n} dmapped dm;
+  var A: [D] int;
+
+  for loc in Locales do on loc {
+    for (i, j) in D do A[i, j] += i*n + j;
+  }
+
+  var ok = true;
+  for loc in Locales do on loc {
+    for (i, j) in D do
+      if A[i, j] != (i*n + j)*numLocales then ok = false;
+  }
+  writeln("DimensionalDist2D: ", if ok then "OK" else "FAILED");
+}
@@ -357,6 +357,35 @@ use IO;
   assertEqual(result, 3, 'dot(M[0..<3, 0], M[0..<3, 0])');
 }
 
+/* dot - matrix-matrix larger than the cache blocking's micro-tiles,
+   with sizes that aren't multiples of them and non-0-based indices */
+{
+  proc test_bigdot(type t) {
+    const m = 67, k = 45, n = 53;
+    var A: [1..m, 3..#k] t,
+        B: [-2..#k, 0..#n] t;
+
+    forall (i, j) in A.domain do A[i, j] = ((i + j) % 7 - 3): t;
+    forall (i, j) in B.domain do B[i, j] = ((i * j) % 5): t;
+
+    var C = dot(A, B);
+
+    var R: [1..m, 0..#n] t;
+    forall (i, j) in R.domain do
+      for p in 0..#k do
+        R[i, j] += A[i, 3 + p] * B[-2 + p, j];
+
+    assertEqual(C.shape, (m, n), 'dot(A, B).shape');
+    assertEqual(C, R, 'dot(A, B) for ' + t:string);
+  }
+
+  test_bigdot(real);
+  test_bigdot(real(32));
+  test_bigdot(complex);
+  test_bigdot(complex(64));
+  test_bigdot(int);
+}
+
 /* outer */
 {
   var v = Vector(3);
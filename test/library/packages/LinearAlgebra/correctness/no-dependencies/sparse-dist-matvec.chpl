@@ -0,0 +1,51 @@
+// Distributed CSR (SparseBlock + CS layout) matrix-vector products, checked
+// against the same matrix stored as a local CSR array
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use BlockDist;
+use List;
+
+config const n = 37;
+
+const Space = {1..n, 1..n};
+
+// Unsorted edge list with a few dense rows and columns
+var edgeList: list(2*int);
+for i in 1..n by -1 {
+  for k in 0..#(if i % 7 == 0 then n/2 else 3) do
+    edgeList.append((i, (i * 5 + k * 3) % n + 1));
+  edgeList.append((i % 4 + 1, i));
+}
+const edges = edgeList.toArray();
+
+var LD: sparse subdomain(Space) dmapped CS();
+LD.bulkAdd(edges, isUnique=false);
+var L: [LD] real;
+forall (i,j) in LD with (ref L) do L[i,j] = (i + 2*j): real;
+
+const x: [1..n] real = [i in 1..n] (i % 3): real - 1.0;
+const yRef = L.dot(x),
+      yTRef = x.dot(L);
+
+proc check(name, grid) {
+  const D = Space dmapped Block(boundingBox=Space, targetLocales=grid,
+                                sparseLayoutType=CS);
+  var SD: sparse subdomain(D);
+  SD.bulkAdd(edges, isUnique=false);
+  var A: [SD] real;
+  forall (i,j) in SD with (ref A) do A[i,j] = (i + 2*j): real;
+
+  // Local and Block-distributed right-hand sides
+  const VSpace = {1..n};
+  const xd: [VSpace dmapped Block(boundingBox=VSpace)] real = x;
+
+  const ok = SD.size == LD.size &&
+             && reduce (A.dot(x) == yRef) &&
+             && reduce (A.dot(xd) == yRef) &&
+             && reduce (x.dot(A) == yTRef) &&
+             && reduce (xd.dot(A) == yTRef);
+  writeln(name, ": ", if ok then "PASSED" else "FAILED");
+}
+
+check("row blocks", reshape(Locales, {0..#numLocales, 0..0}));
+check("2D grid", Locales);
@@ -0,0 +1,121 @@
+/*
+CSR kernel performance testing
+
+Times sparse matrix-vector products (both orientations), sparse
+matrix-matrix products and transposes on an n x n CSR matrix built
+directly from its internal representation.  Every ``skewEvery``-th row is
+``skew`` times denser than the others, so the timings also reflect how
+well the kernels balance uneven rows across tasks.
+
+Strong scaling can be measured by varying the number of tasks, e.g.
+
+  ./csr-kernels-perf --n=1000000 --dataParTasksPerLocale=1
+  ./csr-kernels-perf --n=1000000 --dataParTasksPerLocale=8
+*/
+
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use Time;
+
+config const n = 1000,
+             rowNnz = 8,
+             skew = 32,
+             skewEvery = 97,
+             iters = 10,
+             thresh = 1.0e-10,
+             /* Omit timing output */
+             correctness = false;
+
+proc main() {
+  const A = makeMatrix();
+  const x: [1..n] real = [i in 1..n] (i % 5): real + 1.0;
+
+  if !correctness {
+    writeln('==============================');
+    writeln('CSR Kernels Performance Test');
+    writeln('==============================');
+    writeln('n                      : ', n);
+    writeln('nnz                    : ', A.domain.size);
+    writeln('tasks                  : ', if dataParTasksPerLocale == 0
+                                         then here.maxTaskPar
+                                         else dataParTasksPerLocale);
+    writeln();
+  }
+
+  var y = A.dot(x),
+      yT = x.dot(A),
+      C = A.dot(A),
+      AT = A.T;
+
+  var tMV, tMVT, tMM, tT: Timer;
+
+  for 1..iters {
+    tMV.start();
+    y = A.dot(x);
+    tMV.stop();
+
+    tMVT.start();
+    yT = x.dot(A);
+    tMVT.stop();
+
+    tT.start();
+    const AT2 = A.T;
+    tT.stop();
+  }
+
+  // SpGEMM allocates its result, so time it separately with fewer repeats
+  for 1..max(1, iters/5) {
+    tMM.start();
+    const C2 = A.dot(A);
+    tMM.stop();
+  }
+
+  // (A*A)*x == A*(A*x), and A^T*x computed both ways must agree
+  const errMM = maxRelErr(C.dot(x), A.dot(y)),
+        errT = maxRelErr(AT.dot(x), yT);
+
+  if errMM > thresh || errT > thresh {
+    writeln('FAILED: ', (errMM, errT));
+  } else {
+    writeln('PASSED');
+  }
+
+  if !correctness {
+    writeln('SpMV Time: ', tMV.elapsed() / iters);
+    writeln('SpMV^T Time: ', tMVT.elapsed() / iters);
+    writeln('Transpose Time: ', tT.elapsed() / iters);
+    writeln('SpGEMM Time: ', tMM.elapsed() / max(1, iters/5));
+  }
+}
+
+/* Build the test matrix from (data, indices, indptr) arrays */
+proc makeMatrix() {
+  const rows = 1..n;
+  var counts: [rows] int = [i in rows] min(n, if i % skewEvery == 0
+                                               then rowNnz * skew
+                                               else rowNnz);
+  var indptr: [1..n+1] int;
+  indptr[1] = 0;
+  indptr[2..n+1] = + scan counts;
+
+  const nnz = indptr[n+1];
+  var indices: [0..#nnz] int,
+      data: [0..#nnz] real;
+
+  forall i in rows {
+    // Evenly spaced, distinct columns starting at a row-dependent offset
+    const cnt = counts[i],
+          stride = n / cnt;
+    for k in 0..#cnt {
+      const p = indptr[i] + k;
+      indices[p] = (i * 31 + k * stride) % n + 1;
+      data[p] = 1.0 / (k + 1);
+    }
+  }
+
+  return CSRMatrix({rows, rows}, data, indices, indptr);
+}
+
+proc maxRelErr(X, Y) {
+  return max reduce [(a, b) in zip(X, Y)] abs(a - b) / max(abs(b), 1.0);
+}
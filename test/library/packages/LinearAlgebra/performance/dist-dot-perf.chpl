@@ -0,0 +1,113 @@
+/*
+Distributed dense dot product performance testing
+
+Multiplies Block-distributed matrices (SUMMA) and a Block-distributed
+matrix by a vector.  The correctness mode also checks BlockCyclic
+operands and a Block matrix times a local one.  To run it on a workstation, build Chapel with
+CHPL_COMM=gasnet and either CHPL_COMM_SUBSTRATE=smp or udp, then:
+
+  chpl --fast -s blasImpl=off dist-dot-perf.chpl
+  ./dist-dot-perf -nl 4 --n=2048
+
+--n=512  --iters=10
+--n=2048 --iters=5
+*/
+
+use LinearAlgebra;
+use BlockDist;
+use BlockCycDist;
+use Time;
+
+config const n=1024,
+             iters=10,
+             thresh=1.0e-10,
+             /* Omit timing output */
+             correctness=false;
+
+config type eltType = real;
+
+const nbytes = numBytes(eltType);
+
+proc main() {
+  const Space = {1..n, 1..n},
+        VSpace = {1..n};
+  const D = Space dmapped Block(boundingBox=Space),
+        VD = VSpace dmapped Block(boundingBox=VSpace);
+
+  var A: [D] eltType = [(i,j) in D] ((i + j) % 7): eltType;
+  var B: [D] eltType = [(i,j) in D] ((i * j) % 5): eltType;
+  var x: [VD] eltType = [i in VD] (i % 3): eltType;
+
+  var tMM, tMV: Timer;
+
+  if !correctness {
+    writeln('======================================');
+    writeln('Distributed Dense Dot Performance Test');
+    writeln('======================================');
+    writeln('locales                : ', numLocales);
+    writeln('iters                  : ', iters);
+    writeln('square matrix size     : ', n);
+    writeln('MB                     : ', (nbytes*n*n) / 10**6);
+    writeln();
+  }
+
+  var C = dot(A, B);
+  var y = dot(A, x);
+
+  for 1..iters {
+    tMM.start();
+    C = dot(A, B);
+    tMM.stop();
+
+    tMV.start();
+    y = dot(A, x);
+    tMV.stop();
+  }
+
+  if correctness {
+    // Check a few rows against a straightforward computation.
+    var diff = 0.0;
+    for i in 1..n by max(1, n/7) {
+      for j in 1..n {
+        var ref_ij: eltType;
+        for k in 1..n do
+          ref_ij += A[i,k] * B[k,j];
+        diff += abs(C[i,j] - ref_ij);
+      }
+      var ref_i: eltType;
+      for k in 1..n do
+        ref_i += A[i,k] * x[k];
+      diff += abs(y[i] - ref_i);
+    }
+
+    // The same products with BlockCyclic operands, and with a local B
+    const DC = Space dmapped BlockCyclic(startIdx=Space.low, blocksize=(7,5)),
+          VDC = VSpace dmapped BlockCyclic(startIdx=VSpace.low, blocksize=3);
+    var AC: [DC] eltType = A,
+        BC: [DC] eltType = B;
+    var xC: [VDC] eltType = x;
+    var BL: [Space] eltType = B;
+
+    const CC = dot(AC, BC),
+          CL = dot(A, BL);
+    const yC = dot(AC, xC),
+          yT = dot(xC, AC),
+          yTB = dot(x, A);
+    diff += + reduce abs(CC - C);
+    diff += + reduce abs(CL - C);
+    diff += + reduce abs(yC - y);
+    diff += + reduce abs(yT - yTB);
+
+    if diff > thresh {
+      writeln("FAILED ", diff);
+    }
+    else {
+      writeln("PASSED");
+    }
+  }
+
+  if !correctness {
+    writeln('matrix-matrix Time: ', tMM.elapsed() / iters);
+    writeln('matrix-vector Time: ', tMV.elapsed() / iters);
+  }
+}
@@ -0,0 +1,74 @@
+use BlockDist;
+use Random;
+use Sort;
+
+config const n = 10000;
+
+// Orders by absolute value; has no keyPart, so sort() picks the sample sort
+record AbsComparator { }
+proc AbsComparator.compare(a, b) {
+  return abs(a) - abs(b);
+}
+
+proc check(name: string, ref A: [], comparator, param direct: bool) {
+  var Local: [0..#A.size] A.eltType = A;
+  sort(Local, comparator);
+
+  if direct then
+    DistributedSampleSort.distributedSampleSort(A, comparator);
+  else
+    sort(A, comparator);
+
+  // Compare against a local sort. Keys that compare equal may come out
+  // in any order, so only compare keys.
+  var ok = isSorted(A, comparator);
+  forall (a, b) in zip(A, Local) with (&& reduce ok) do
+    ok &&= chpl_compare(a, b, comparator) == 0;
+  writeln(name, ": ", if ok then "OK" else "FAILED");
+}
+
+proc blockArr(size: int, low: int = 0) {
+  const D = {low..#size} dmapped Block({low..#size});
+  var A: [D] int;
+  return A;
+}
+
+{
+  var A = blockArr(n);
+  fillRandom(A, seed=17);
+  A = A % 1000000;
+  check("random", A, defaultComparator, direct=true);
+}
+{
+  var A = blockArr(n, low=-5);
+  fillRandom(A, seed=23);
+  A = A % 3;
+  check("few distinct keys", A, defaultComparator, direct=true);
+}
+{
+  var A = blockArr(n);
+  A = 7;
+  check("all equal", A, defaultComparator, direct=true);
+}
+{
+  var A = blockArr(n);
+  forall (a, i) in zip(A, A.domain) do a = n - i;
+  check("reversed", A, reverseComparator, direct=true);
+}
+{
+  var A = blockArr(3, low=1);
+  A = [3, -1, 2];
+  check("fewer elements than locales", A, defaultComparator, direct=true);
+}
+{
+  var A = blockArr(n);
+  fillRandom(A, seed=31);
+  A = A % 1000 - 500;
+  check("sort() with compare", A, new AbsComparator(), direct=false);
+}
+{
+  const D = {1..n} dmapped Block({1..n});
+  var A: [D] real;
+  fillRandom(A, seed=41);
+  check("sort() with reals", A, defaultComparator, direct=false);
+}
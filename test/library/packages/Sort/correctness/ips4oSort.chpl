@@ -0,0 +1,65 @@
+use Random;
+use Sort;
+
+config const n = 1 << 20;
+
+// Comparators without keyPart, so sort() uses the in-place sample sort
+record IntCompare { }
+proc IntCompare.compare(a: int, b: int) {
+  return if a < b then -1 else if a > b then 1 else 0;
+}
+
+record Pair {
+  var name: string;
+  var id: int;
+}
+record PairCompare { }
+proc PairCompare.compare(a: Pair, b: Pair) {
+  if a.name < b.name then return -1;
+  if a.name > b.name then return 1;
+  return a.id - b.id;
+}
+
+proc check(name: string, ref A: [], comparator) {
+  var Expected = A;
+  QuickSort.quickSort(Expected, comparator=comparator);
+  sort(A, comparator);
+
+  var ok = true;
+  forall (a, b) in zip(A, Expected) with (&& reduce ok) do
+    ok &&= chpl_compare(a, b, comparator) == 0;
+  writeln(name, ": ", if ok then "OK" else "FAILED");
+}
+
+{
+  var A: [0..#n] int;
+  fillRandom(A, seed=17);
+  check("random", A, new IntCompare());
+}
+{
+  var A: [1..n] int;
+  fillRandom(A, seed=19);
+  A = A % 5;
+  check("few distinct keys", A, new IntCompare());
+}
+{
+  var A: [0..#n] int;
+  A = 3;
+  check("all equal", A, new IntCompare());
+}
+{
+  var A: [0..#n] int = [i in 0..#n] i;
+  check("sorted", A, new IntCompare());
+}
+{
+  var A: [-3..#n] int = [i in 0..#n] n - i;
+  check("reversed", A, new IntCompare());
+}
+{
+  const m = n / 8 + 3;
+  var R: [0..#m] int;
+  fillRandom(R, seed=23);
+  var A: [0..#m] Pair = [r in R] new Pair("k" + (abs(r) % 1000):string,
+                                          abs(r) % 7);
+  check("records with strings", A, new PairCompare());
+}
@@ -0,0 +1,18 @@
+//Check that we ask the LoopVectorizer to vectorize order-independent loops
+proc loop (A, B, n) {
+  for i in vectorizeOnly(1..n) {
+    A[i] = 3*B[i];
+    // CHECK: br i1
+    // CHECK-SAME: !llvm.loop ![[LOOP1:[0-9]+]]
+  }
+}
+// CHECK: ![[LOOP1]] = distinct !{![[LOOP1]], ![[PA1:[0-9]+]], ![[VE1:[0-9]+]]}
+// CHECK: ![[VE1]] = !{!"llvm.loop.vectorize.enable", i1 true}
+
+config const n = 1000;
+
+var A : [1..n] int(32);
+var B : [1..n] int(32);
+
+loop(A, B, n);
+writeln("Sum of A is ", + reduce A);
@@ -0,0 +1,18 @@
+#
+# Sourced by the .precomp scripts here: set LLVM_PROFDATA to the
+# llvm-profdata that matches the LLVM that chpl uses.
+#
+USE_LLVM=`$CHPL_HOME/util/chplenv/chpl_llvm.py`
+LLVM_PROFDATA='llvm-profdata'
+
+if [ "$USE_LLVM" = bundled -o "$USE_LLVM" = llvm ]
+then
+  tmp=`$CHPL_HOME/util/printchplenv --all --internal --simple | grep CHPL_LLVM_UNIQ_CFG_PATH`
+  LLVM_UNIQUE_SUBDIR=${tmp/CHPL_LLVM_UNIQ_CFG_PATH=/}
+  LLVM_PROFDATA=${CHPL_HOME}/third-party/llvm/install/${LLVM_UNIQUE_SUBDIR}/bin/llvm-profdata
+elif [ "$USE_LLVM" = system ]
+then
+  PREFERRED_LLVM_VERS=`cat ${CHPL_HOME}/third-party/llvm/LLVM_VERSION`
+  LLVM_CONFIG=`${CHPL_HOME}/third-party/llvm/find-llvm-config.sh $PREFERRED_LLVM_VERS`
+  LLVM_PROFDATA=${LLVM_CONFIG//llvm-config/llvm-profdata}
+fi
@@ -0,0 +1,17 @@
+// Compiled with --profile-use on the profile recorded by an instrumented
+// multi-locale run of this same program (see profileMerge.precomp).  The
+// .prediff appends the call count that the merged profile records for
+// perLocaleWork, which runs once on each locale.
+
+config const n = 1000;
+
+pragma "no inline"
+proc perLocaleWork(id: int) {
+  return + reduce [i in 1..n] (i * (id + 1));
+}
+
+var sums: [LocaleSpace] int;
+coforall loc in Locales do on loc do
+  sums[loc.id] = perLocaleWork(loc.id);
+
+writeln(sums);
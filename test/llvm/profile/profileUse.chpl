@@ -0,0 +1,24 @@
+// Compiled with --profile-use on the profile recorded by an instrumented
+// build of this same program (see profileUse.precomp).
+
+config const n = 100000;
+
+proc collatzSteps(start: int) {
+  var x = start, steps = 0;
+  while x != 1 {
+    if x % 2 == 0 then x /= 2; else x = 3*x + 1;
+    steps += 1;
+  }
+  return steps;
+}
+
+var total = 0;
+for i in 1..n do
+  total += collatzSteps(i);
+
+var counts: [0..3] int;
+forall i in 1..n with (+ reduce counts) do
+  counts[i % 4] += 1;
+
+writeln(total);
+writeln(counts);
@@ -0,0 +1,37 @@
+// Check that --report-vectorization reports both a loop that was
+// vectorized and one that wasn't, each at the Chapel location recorded in
+// its chpl.loop.location metadata.
+
+var calls: int;
+
+pragma "no inline"
+proc counted(x) {
+  calls += 1;
+  return x;
+}
+
+proc vectorized(A, B, n) {
+  for i in vectorizeOnly(0..n) {
+    A[i] = 3*B[i];
+  }
+}
+
+proc rejected(A, B, n) {
+  for i in vectorizeOnly(0..n) {
+    A[i] = counted(B[i]);
+  }
+}
+
+// The loops come from inlining the vectorizeOnly() iterator, so their
+// locations may be in the module that defines it.
+// CHECK-DAG: {{.+\.chpl:[0-9]+}}: note: vectorized loop
+// CHECK-DAG: {{.+\.chpl:[0-9]+}}: note: loop not vectorized
+
+config const n = 1000;
+
+var A : [0..n] int(32);
+var B : [0..n] int(32);
+
+vectorized(A, B, n);
+rejected(A, B, n);
+writeln("Sum of A is ", + reduce A);
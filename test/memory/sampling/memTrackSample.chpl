@@ -0,0 +1,9 @@
+// Leak many instances from one allocation site.  With --memTrackSample,
+// the leak report should show one estimated row for that site.
+class C { var x: int; }
+
+config const n = 4096;
+
+var leaked: [1..n] unmanaged C?;
+for i in 1..n do
+  leaked[i] = new unmanaged C(i);
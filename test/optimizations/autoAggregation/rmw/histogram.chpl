@@ -0,0 +1,28 @@
+use BlockDist;
+
+var X = newBlockArr(0..9, int);
+var H = newBlockArr(0..9, int);
+var AH = newBlockArr(0..9, atomic int);
+
+forall i in X.domain do X[i] = i;
+
+writeln("Loop 1");
+forall x in X {
+  H[9-x] += 1;
+}
+writeln("End Loop 1");
+writeln(H);
+
+writeln("Loop 2");
+forall i in X.domain {
+  AH[(i*3)%10].add(i);
+}
+writeln("End Loop 2");
+writeln(AH);
+
+writeln("Loop 3");
+forall (x, i) in zip(X, X.domain) {
+  H[9-x] += i;  // zippered iterands aren't aggregated
+}
+writeln("End Loop 3");
+writeln(H);
@@ -0,0 +1,44 @@
+use BlockDist;
+
+config const n = 100;
+
+var D = newBlockDom(0..#n);
+var A: [D] int;
+var idx: [D] int;
+var B: [D] int;
+
+for i in D {
+  A[i] = i*10;
+  idx[i] = (i*7) % n;
+}
+
+// remote gather: prefetched through the remote cache
+forall i in D {
+  B[i] = A[idx[i]];
+}
+writeln(+ reduce B);
+
+// local gather: prefetched into the processor cache
+var LA: [0..#n] real;
+var LIdx: [0..#n] int;
+var LB: [0..#n] real;
+for i in 0..#n {
+  LA[i] = i;
+  LIdx[i] = n-1-i;
+}
+
+forall i in LA.domain {
+  LB[i] = LA[LIdx[i]] + LA[LIdx[i]];
+}
+writeln(LB[0], " ", LB[n-1]);
+
+// the index expression is not the loop index: nothing to prefetch
+forall i in D {
+  B[i] = A[idx[n-1-i]];
+}
+writeln(+ reduce B);
+
+// multiple index variables: not optimized
+forall (i, j) in {0..1, 0..1} {
+  B[i+j] = A[idx[i]];
+}
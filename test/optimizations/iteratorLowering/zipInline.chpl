@@ -0,0 +1,20 @@
+iter twoYields(n: int) {
+  for i in 1..n by 2 do yield i;
+  for i in 2..n by 2 do yield i;
+}
+
+iter evens(n: int) {
+  for i in 1..n do yield 2*i;
+}
+
+// twoYields is inlined around the body; evens uses its iterator class
+var sum = 0;
+for (i, j) in zip(twoYields(6), evens(6)) {
+  sum += i * j;
+  writeln((i, j));
+}
+writeln(sum);
+
+// evens is inlined; twoYields uses its iterator class
+for (a, b) in zip(evens(3), twoYields(3)) do
+  writeln(a + b);
@@ -0,0 +1,13 @@
+iter twoYields(n: int) {
+  for i in 1..n by 2 do yield i;
+  for i in 2..n by 2 do yield i;
+}
+
+iter evens(n: int) {
+  for i in 1..n do yield 2*i;
+}
+
+// twoYields is inlined and sets the trip count, so evens having values
+// left over has to be caught after the loop
+for (i, j) in zip(twoYields(4), evens(5)) do
+  writeln((i, j));
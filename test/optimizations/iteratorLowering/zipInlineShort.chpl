@@ -0,0 +1,13 @@
+iter twoYields(n: int) {
+  for i in 1..n by 2 do yield i;
+  for i in 2..n by 2 do yield i;
+}
+
+iter evens(n: int) {
+  for i in 1..n do yield 2*i;
+}
+
+// twoYields is inlined and sets the trip count, so evens running out
+// first has to be caught at the start of an iteration
+for (i, j) in zip(twoYields(6), evens(2)) do
+  writeln((i, j));
@@ -0,0 +1,44 @@
+var x: atomic int;
+const target = Locales[numLocales-1];
+
+// adjacent on statements with the same target are fused
+on target do x.add(1);
+on target do x.add(2);
+writeln(x.read());
+
+// an on statement that is the whole loop body is hoisted
+for i in 1..10 {
+  on target {
+    x.add(i);
+  }
+}
+writeln(x.read());
+
+// fusion makes this loop body a single on statement, and the loop nest is
+// hoisted one level at a time
+for i in 1..3 do
+  for j in 1..4 {
+    on target do x.add(1);
+    on target do x.add(j);
+  }
+writeln(x.read());
+
+// an on statement at the end of a begin is made non-blocking
+sync {
+  begin {
+    x.add(1);
+    on target do x.add(100);
+  }
+}
+writeln(x.read());
+
+// different targets: not fused
+on Locales[0] do x.add(1);
+on target do x.add(1);
+writeln(x.read());
+
+// the target is not loop-invariant: not hoisted
+for i in 0..#numLocales {
+  on Locales[i] do x.add(1);
+}
+writeln(x.read());
@@ -0,0 +1,38 @@
+use CommDiagnostics;
+
+class C {
+  const a: int;
+  var b: int;     // only set by the initializer
+  var c: int;     // modified after initialization
+}
+
+proc main() {
+  const obj = new unmanaged C(1, 2, 3);
+  obj.c = 4;
+
+  var sum = 0;
+
+  startCommDiagnostics();
+  on Locales[numLocales-1] {
+    // 'a' and 'b' are sent with the on statement; only 'c' is fetched
+    sum = obj.a + obj.b + obj.c;
+  }
+  stopCommDiagnostics();
+
+  writeln(sum);
+  writeln("GETs from locale ", numLocales-1, ": ",
+          getCommDiagnostics()[numLocales-1].get);
+
+  resetCommDiagnostics();
+
+  startCommDiagnostics();
+  on obj {
+    // the fields are local here, so nothing is forwarded
+    sum = obj.a + obj.b + obj.c;
+  }
+  stopCommDiagnostics();
+
+  writeln(sum);
+
+  delete obj;
+}
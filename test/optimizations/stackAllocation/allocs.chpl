@@ -0,0 +1,83 @@
+class Point {
+  var x, y: int;
+
+  proc norm1() {
+    return abs(x) + abs(y);
+  }
+}
+
+class Counter {
+  var count: int;
+}
+
+var keep: unmanaged Counter?;
+
+// 'p' never leaves the loop body: allocated on the stack
+proc sumNorms(n: int) {
+  var total = 0;
+  for i in 1..n {
+    var p = new unmanaged Point(i, -i);
+    total += p.norm1();
+    delete p;
+  }
+  return total;
+}
+
+// stored into a global: stays on the heap
+proc stored() {
+  var c = new unmanaged Counter(1);
+  keep = c;
+  return c.count;
+}
+
+// returned: stays on the heap
+proc returned() {
+  return new unmanaged Counter(2);
+}
+
+writeln(sumNorms(10));
+writeln(stored());
+var r = returned();
+writeln(r.count);
+delete r;
+delete keep;
+
+var lastRegistered: unmanaged Registered?;
+var lastInitialized: unmanaged Initialized?;
+
+class Registered {
+  var id: int;
+
+  proc postinit() {
+    lastRegistered = _to_unmanaged(this);
+  }
+}
+
+class Initialized {
+  var id: int;
+
+  proc init(id: int) {
+    this.id = id;
+    this.complete();
+    lastInitialized = _to_unmanaged(this);
+  }
+}
+
+// registers itself in its postinit: stays on the heap
+proc registeredInPostinit() {
+  var s = new unmanaged Registered(3);
+  return s.id;
+}
+
+// registers itself in its init: stays on the heap
+proc registeredInInit() {
+  var s = new unmanaged Initialized(4);
+  return s.id;
+}
+
+writeln(registeredInPostinit());
+writeln(lastRegistered!.id);
+writeln(registeredInInit());
+writeln(lastInitialized!.id);
+delete lastRegistered;
+delete lastInitialized;
@@ -0,0 +1,35 @@
+use Barriers;
+
+config const numTasks = 73;
+config const numRounds = 20;
+
+// With more tasks than barrierFanIn, arrivals go through a combining tree.
+// Check that no task gets past a barrier before every task reached it.
+proc treeTest(b: Barrier, numTasks) {
+  var A: [0..#numTasks] int = -1;
+  var errors: atomic int;
+  coforall t in 0..#numTasks {
+    for r in 1..numRounds {
+      A[t] = r;
+      if r%2 {
+        b.barrier();
+      } else {
+        b.notify();
+        b.wait();
+      }
+      for a in A do
+        if a != r then errors.add(1);
+      b.barrier();
+    }
+  }
+  writeln("errors: ", errors.read());
+}
+
+var b = new Barrier(numTasks);
+treeTest(b, numTasks);
+
+// a non-reusable barrier reports completion through check()
+var nb = new Barrier(numTasks, reusable=false);
+coforall t in 0..#numTasks do
+  nb.notify();
+writeln(nb.check());
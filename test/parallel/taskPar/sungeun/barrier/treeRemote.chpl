@@ -0,0 +1,25 @@
+use Barriers;
+
+config const tasksPerLocale = 4;
+config const numRounds = 10;
+
+// A tree barrier shared by tasks on every locale.  With network atomics
+// the remote tasks update the tree in place, otherwise they move to it.
+const numTasks = numLocales * tasksPerLocale;
+var b = new Barrier(numTasks);
+var A: [0..#numTasks] int = -1;
+var errors: atomic int;
+
+coforall loc in Locales do on loc {
+  coforall i in 0..#tasksPerLocale {
+    const t = here.id * tasksPerLocale + i;
+    for r in 1..numRounds {
+      A[t] = r;
+      b.barrier();
+      for a in A do
+        if a != r then errors.add(1);
+      b.barrier();
+    }
+  }
+}
+writeln("errors: ", errors.read());
@@ -0,0 +1,58 @@
+// Parallel scans of Cyclic, Stencil and multidimensional arrays must match
+// a serial scan in index order
+use BlockDist;
+use CyclicDist;
+use StencilDist;
+
+config const n = 1001;
+
+proc check(name, A: []) {
+  const B = + scan A;
+
+  var sum = 0, ok = B.domain == A.domain;
+  for (a, b) in zip(A, B) {
+    sum += a;
+    if b != sum then ok = false;
+  }
+
+  const C = max reduce A,
+        M = max scan A;
+  ok &&= M[M.domain.last] == C;
+
+  writeln(name, ": ", if ok then "OK" else "FAILED");
+}
+
+proc fill(ref A) {
+  var i = 0;
+  for a in A {
+    a = (i * 7919) % 113 - 50;
+    i += 1;
+  }
+}
+
+const D1 = {1..n},
+      D2 = {1..n/10, 0..9},
+      D3 = {0..4, 1..7, -2..3 by 2};
+
+var L1: [D1] int; fill(L1); check("local 1D", L1);
+var L2: [D2] int; fill(L2); check("local 2D", L2);
+var L3: [D3] int; fill(L3); check("local 3D strided", L3);
+
+var C1: [D1 dmapped Cyclic(startIdx=D1.low)] int;
+fill(C1); check("Cyclic", C1);
+
+var C1s: [{1..n by 3} dmapped Cyclic(startIdx=1)] int;
+fill(C1s); check("Cyclic strided", C1s);
+
+var S1: [D1 dmapped Stencil(D1, fluff=(1,))] int;
+fill(S1); check("Stencil", S1);
+
+var B2: [D2 dmapped Block(D2)] int;
+fill(B2); check("Block 2D", B2);
+
+var C3: [D3 dmapped Cyclic(startIdx=D3.low)] int;
+fill(C3); check("Cyclic 3D strided", C3);
+
+const S2D = {0..9, 1..n/10};
+var S2: [S2D dmapped Stencil(S2D, fluff=(1,1))] int;
+fill(S2); check("Stencil 2D", S2);
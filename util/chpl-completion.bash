@@ -26,6 +26,7 @@ _chpl ()
 --atomics \
 --auto-aggregation \
 --auto-local-access \
+--auto-prefetch \
 --aux-filesys \
 --baseline \
 --bounds-checks \
@@ -67,6 +68,7 @@ _chpl ()
 --fast-followers \
 --force-vectorize \
 --formal-domain-checks \
+--fuse-on-stmts \
 --gasnet-segment \
 --gdb \
 --gen-ids \
@@ -95,6 +97,7 @@ _chpl ()
 --inline \
 --inline-iterators \
 --inline-iterators-yield-limit \
+--inline-zippered-iterators \
 --instantiate-max \
 --interprocedural-alias-analysis \
 --launcher \
@@ -145,6 +148,7 @@ _chpl ()
 --no-allow-noinit-array-not-pod \
 --no-auto-aggregation \
 --no-auto-local-access \
+--no-auto-prefetch \
 --no-bounds-checks \
 --no-cache-remote \
 --no-cast-checks \
@@ -169,6 +173,7 @@ _chpl ()
 --no-fast-followers \
 --no-force-vectorize \
 --no-formal-domain-checks \
+--no-fuse-on-stmts \
 --no-gen-ids \
 --no-html-print-block-ids \
 --no-html-wrap-lines \
@@ -184,6 +189,7 @@ _chpl ()
 --no-infer-local-fields \
 --no-inline \
 --no-inline-iterators \
+--no-inline-zippered-iterators \
 --no-interprocedural-alias-analysis \
 --no-library-ml-debug \
 --no-lifetime-checking \
@@ -222,6 +228,7 @@ _chpl ()
 --no-print-unused-internal-functions \
 --no-privatization \
 --no-region-vectorizer \
+--no-remote-field-forwarding \
 --no-remote-serialization \
 --no-remote-value-forwarding \
 --no-remove-copy-calls \
@@ -231,10 +238,13 @@ _chpl ()
 --no-report-aliases \
 --no-report-auto-aggregation \
 --no-report-auto-local-access \
+--no-report-auto-prefetch \
 --no-report-blocking \
+--no-report-vectorization \
 --no-scalar-replacement \
 --no-specialize \
 --no-split-initialization \
+--no-stack-allocate-classes \
 --no-stack-checks \
 --no-task-tracking \
 --no-tuple-copy-opt \
@@ -282,8 +292,11 @@ _chpl ()
 --print-unused-functions \
 --print-unused-internal-functions \
 --privatization \
+--profile-generate \
+--profile-use \
 --re2 \
 --region-vectorizer \
+--remote-field-forwarding \
 --remote-serialization \
 --remote-value-forwarding \
 --remove-copy-calls \
@@ -293,16 +306,20 @@ _chpl ()
 --report-aliases \
 --report-auto-aggregation \
 --report-auto-local-access \
+--report-auto-prefetch \
 --report-blocking \
 --report-dead-blocks \
 --report-dead-modules \
 --report-inlined-iterators \
 --report-inlining \
+--report-iterator-lowering \
 --report-optimized-forall-unordered-ops \
 --report-optimized-loop-iterators \
 --report-optimized-on \
 --report-promotion \
 --report-scalar-replace \
+--report-stack-allocation \
+--report-vectorization \
 --report-vectorized-loops \
 --savec \
 --scalar-replace-limit \
@@ -310,6 +327,7 @@ _chpl ()
 --set \
 --specialize \
 --split-initialization \
+--stack-allocate-classes \
 --stack-checks \
 --static \
 --stop-after-pass \
@@ -347,6 +365,7 @@ _chpl ()
 --atomics \
 --auto-aggregation \
 --auto-local-access \
+--auto-prefetch \
 --aux-filesys \
 --baseline \
 --bounds-checks \
@@ -373,6 +392,7 @@ _chpl ()
 --fast \
 --fast-followers \
 --formal-domain-checks \
+--fuse-on-stmts \
 --gasnet-segment \
 --gmp \
 --hdr-search-path \
@@ -387,6 +407,7 @@ _chpl ()
 --inline \
 --inline-iterators \
 --inline-iterators-yield-limit \
+--inline-zippered-iterators \
 --instantiate-max \
 --launcher \
 --ldflags \
@@ -411,6 +432,7 @@ _chpl ()
 --nil-checks \
 --no-auto-aggregation \
 --no-auto-local-access \
+--no-auto-prefetch \
 --no-bounds-checks \
 --no-cache-remote \
 --no-cast-checks \
@@ -427,11 +449,13 @@ _chpl ()
 --no-explain-verbose \
 --no-fast-followers \
 --no-formal-domain-checks \
+--no-fuse-on-stmts \
 --no-ieee-float \
 --no-ignore-local-classes \
 --no-infer-local-fields \
 --no-inline \
 --no-inline-iterators \
+--no-inline-zippered-iterators \
 --no-live-analysis \
 --no-llvm \
 --no-llvm-wide-opt \
@@ -455,11 +479,14 @@ _chpl ()
 --no-print-search-dirs \
 --no-print-unused-functions \
 --no-privatization \
+--no-remote-field-forwarding \
 --no-remote-serialization \
 --no-remote-value-forwarding \
 --no-remove-copy-calls \
+--no-report-vectorization \
 --no-scalar-replacement \
 --no-specialize \
+--no-stack-allocate-classes \
 --no-stack-checks \
 --no-task-tracking \
 --no-tuple-copy-opt \
@@ -485,15 +512,20 @@ _chpl ()
 --print-search-dirs \
 --print-unused-functions \
 --privatization \
+--profile-generate \
+--profile-use \
 --re2 \
+--remote-field-forwarding \
 --remote-serialization \
 --remote-value-forwarding \
 --remove-copy-calls \
+--report-vectorization \
 --savec \
 --scalar-replace-limit \
 --scalar-replacement \
 --set \
 --specialize \
+--stack-allocate-classes \
 --stack-checks \
 --static \
 --target-arch \